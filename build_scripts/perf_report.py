@@ -143,7 +143,7 @@ def main():
                 return -1
 
             try:
-                subprocess.call([imgui_test_suite_exe, '-nogui', '-nopause', '-v2', '-ve4', '-stressamount',
+                subprocess.call([imgui_test_suite_exe, '-nogui', '-nopause', '-log-async', '-v2', '-ve4', '-stressamount',
                                  str(args.stress), args.run])
             except subprocess.CalledProcessError:
                 logging.error('imgui_test_suite returned an error when executing tests.')
@@ -14,6 +14,11 @@ Index of this file:
 
 // [SECTION] Includes
 // [SECTION] ImGuiCaptureImageBuf
+// [SECTION] Content-addressed image store
+// [SECTION] ImGuiCaptureEncodeQueue
+// [SECTION] ImGuiCaptureGifEncoder
+// [SECTION] ImGuiCaptureVideoWriter
+// [SECTION] Video damage tracking
 // [SECTION] ImGuiCaptureContext
 // [SECTION] ImGuiCaptureToolUI
 
@@ -32,8 +37,12 @@ Index of this file:
 #include "imgui_internal.h"
 #include "imgui_te_engine.h"
 #include "imgui_capture_tool.h"
-#include "imgui_te_utils.h"         // ImPathFindFilename, ImPathFindExtension, ImPathFixSeparatorsForCurrentOS, ImFileCreateDirectoryChain, ImOsOpenInShell
+#include "imgui_te_utils.h"         // ImPathFindFilename, ImPathFindExtension, ImPathFixSeparatorsForCurrentOS, ImFileCreateDirectoryChain, ImOsOpenInShell, ImThreadSetCurrentThreadDescription
 #include "thirdparty/Str/Str.h"
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 // [SECTION] Link stb_image_write.h
@@ -98,26 +107,68 @@ void ImGuiCaptureImageBuf::Clear()
     if (Data)
         IM_FREE(Data);
     Data = NULL;
+    Capacity = 0;
 }
 
 void ImGuiCaptureImageBuf::CreateEmpty(int w, int h)
 {
-    Clear();
+    if (Capacity < w * h)
+    {
+        Clear();
+        Data = (unsigned int*)IM_ALLOC((size_t)(w * h * 4));
+        Capacity = w * h;
+    }
     Width = w;
     Height = h;
-    Data = (unsigned int*)IM_ALLOC((size_t)(Width * Height * 4));
     memset(Data, 0, (size_t)(Width * Height * 4));
 }
 
-bool ImGuiCaptureImageBuf::SaveFile(const char* filename)
+#if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
+// stb_image_write reads PNG settings from global variables while encoding. As images may be saved from multiple
+// threads, images using other settings wait until all PNG encoding using current settings is done.
+static std::mutex               GPngSettingsMutex;
+static std::condition_variable  GPngSettingsCond;
+static int                      GPngSettingsUsers = 0;
+
+static int ImGuiCapture_WritePng(const char* filename, int w, int h, const void* data, int compression_level, ImGuiCapturePngFilter filter)
+{
+    IM_ASSERT(filter >= ImGuiCapturePngFilter_Adaptive && filter <= ImGuiCapturePngFilter_Paeth);
+    {
+        std::unique_lock<std::mutex> lock(GPngSettingsMutex);
+        GPngSettingsCond.wait(lock, [=]() { return GPngSettingsUsers == 0 || (stbi_write_png_compression_level == compression_level && stbi_write_force_png_filter == filter); });
+        stbi_write_png_compression_level = compression_level;
+        stbi_write_force_png_filter = filter;
+        GPngSettingsUsers++;
+    }
+    int ret = stbi_write_png(filename, w, h, 4, data, w * 4);
+    {
+        std::unique_lock<std::mutex> lock(GPngSettingsMutex);
+        GPngSettingsUsers--;
+    }
+    GPngSettingsCond.notify_all();
+    return ret;
+}
+#endif
+
+bool ImGuiCaptureImageBuf::SaveFile(const char* filename, int png_compression_level, ImGuiCapturePngFilter png_filter)
 {
 #if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
     IM_ASSERT(Data != NULL);
     ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename));
-    int ret = stbi_write_png(filename, Width, Height, 4, Data, Width * 4);
+    ImFileDelete(filename); // Existing file may be a hard link to a content store entry, which must not be overwritten.
+    const char* extension = ImPathFindExtension(filename);
+    int ret;
+    if (ImStricmp(extension, ".bmp") == 0)
+        ret = stbi_write_bmp(filename, Width, Height, 4, Data);
+    else if (ImStricmp(extension, ".tga") == 0)
+        ret = stbi_write_tga(filename, Width, Height, 4, Data); // stbi_write_tga_with_rle is never modified
+    else
+        ret = ImGuiCapture_WritePng(filename, Width, Height, Data, png_compression_level, png_filter);
     return ret != 0;
 #else
     IM_UNUSED(filename);
+    IM_UNUSED(png_compression_level);
+    IM_UNUSED(png_filter);
     return false;
 #endif
 }
@@ -126,6 +177,18 @@ void ImGuiCaptureImageBuf::RemoveAlpha()
 {
     unsigned int* p = Data;
     int n = Width * Height;
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    // 16 pixels per iteration. Data is not guaranteed to be 16-bytes aligned.
+    const __m128i alpha_mask = _mm_set1_epi32((int)IM_COL32_A_MASK);
+    for (; n >= 16; n -= 16, p += 16)
+    {
+        __m128i* p4 = (__m128i*)p;
+        _mm_storeu_si128(p4 + 0, _mm_or_si128(_mm_loadu_si128(p4 + 0), alpha_mask));
+        _mm_storeu_si128(p4 + 1, _mm_or_si128(_mm_loadu_si128(p4 + 1), alpha_mask));
+        _mm_storeu_si128(p4 + 2, _mm_or_si128(_mm_loadu_si128(p4 + 2), alpha_mask));
+        _mm_storeu_si128(p4 + 3, _mm_or_si128(_mm_loadu_si128(p4 + 3), alpha_mask));
+    }
+#endif
     while (n-- > 0)
     {
         *p |= IM_COL32_A_MASK;
@@ -133,10 +196,1199 @@ void ImGuiCaptureImageBuf::RemoveAlpha()
     }
 }
 
+// Load a .tga file as written by SaveFile() (24 or 32 bits, uncompressed or RLE compressed).
+// Other formats are not supported as we don't link an image decoder: store reference images as .tga.
+bool ImGuiCaptureImageBuf::LoadFile(const char* filename)
+{
+    if (ImStricmp(ImPathFindExtension(filename), ".tga") != 0)
+    {
+        fprintf(stderr, "ImGuiCaptureImageBuf::LoadFile(): unsupported format for '%s', only .tga files can be loaded.\n", filename);
+        return false;
+    }
+    size_t file_size = 0;
+    unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size);
+    if (file_data == NULL)
+        return false;
+
+    // Header
+    const unsigned char* src = file_data;
+    const unsigned char* src_end = file_data + file_size;
+    const int image_type = (file_size >= 18) ? src[2] : 0;
+    if ((image_type != 2 && image_type != 10) || src[1] != 0 || (src[16] != 24 && src[16] != 32))
+    {
+        fprintf(stderr, "ImGuiCaptureImageBuf::LoadFile(): unsupported .tga file '%s', expecting uncompressed or RLE true-color image.\n", filename);
+        IM_FREE(file_data);
+        return false;
+    }
+    const bool is_rle = (image_type == 10);
+    const int w = src[12] | (src[13] << 8);
+    const int h = src[14] | (src[15] << 8);
+    const int bytes_per_pixel = src[16] / 8;
+    const bool is_top_down = (src[17] & 0x20) != 0;
+    src += 18 + src[0];
+    CreateEmpty(w, h);
+
+    // Pixels are stored as BGR(A). Rows are stored bottom-up unless specified otherwise.
+    int packet_remaining = 0;
+    bool packet_is_repeat = false;
+    unsigned int color = 0;
+    int n = 0;
+    for (; n < w * h; n++)
+    {
+        bool read_pixel = !packet_is_repeat;
+        if (is_rle && packet_remaining == 0)
+        {
+            if (src >= src_end)
+                break;
+            packet_is_repeat = (*src & 0x80) != 0;
+            packet_remaining = (*src & 0x7F) + 1;
+            read_pixel = true;
+            src++;
+        }
+        if (read_pixel)
+        {
+            if (src + bytes_per_pixel > src_end)
+                break;
+            color = IM_COL32(src[2], src[1], src[0], (bytes_per_pixel == 4) ? src[3] : 255);
+            src += bytes_per_pixel;
+        }
+        packet_remaining--;
+        const int y = n / w;
+        Data[(is_top_down ? y : h - 1 - y) * w + (n - y * w)] = color;
+    }
+    IM_FREE(file_data);
+    if (n < w * h)
+    {
+        fprintf(stderr, "ImGuiCaptureImageBuf::LoadFile(): truncated .tga file '%s'.\n", filename);
+        return false;
+    }
+    return true;
+}
+
+static inline int ImGuiCaptureImageBuf_PixelDiff(unsigned int a, unsigned int b)
+{
+    int max_diff = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        max_diff = ImMax(max_diff, ImAbs((int)((a >> shift) & 0xFF) - (int)((b >> shift) & 0xFF)));
+    return max_diff;
+}
+
+// Identical images are detected with memcmp(). Otherwise only rows which are not identical are compared channel by channel.
+// Generating diff image is a separate pass which only happens on failure.
+int ImGuiCaptureImageBuf::Compare(const ImGuiCaptureImageBuf* other, int tolerance, int* out_max_diff, ImGuiCaptureImageBuf* out_diff) const
+{
+    IM_ASSERT(tolerance >= 0 && tolerance <= 255);
+    if (out_max_diff)
+        *out_max_diff = 0;
+    if (Width != other->Width || Height != other->Height)
+        return -1;
+    const size_t row_size = (size_t)Width * sizeof(unsigned int);
+    if (memcmp(Data, other->Data, row_size * Height) == 0)
+        return 0;
+
+    int mismatch_count = 0;
+    int max_diff = 0;
+    for (int y = 0; y < Height; y++)
+    {
+        const unsigned int* a = Data + y * Width;
+        const unsigned int* b = other->Data + y * Width;
+        if (memcmp(a, b, row_size) == 0)
+            continue;
+        int n = Width;
+#if defined(IMGUI_ENABLE_SSE) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+        // 4 pixels per iteration: absolute difference of each channel, then pixels with any channel above tolerance.
+        const __m128i zero = _mm_setzero_si128();
+        const __m128i tolerance4 = _mm_set1_epi8((char)tolerance);
+        __m128i max_diff4 = zero;
+        for (; n >= 4; n -= 4, a += 4, b += 4)
+        {
+            const __m128i a4 = _mm_loadu_si128((const __m128i*)a);
+            const __m128i b4 = _mm_loadu_si128((const __m128i*)b);
+            const __m128i diff4 = _mm_or_si128(_mm_subs_epu8(a4, b4), _mm_subs_epu8(b4, a4));
+            max_diff4 = _mm_max_epu8(max_diff4, diff4);
+            const int ok_mask = _mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(_mm_subs_epu8(diff4, tolerance4), zero)));
+            mismatch_count += 4 - ((ok_mask & 1) + ((ok_mask >> 1) & 1) + ((ok_mask >> 2) & 1) + ((ok_mask >> 3) & 1));
+        }
+        unsigned char max_diff_bytes[16];
+        _mm_storeu_si128((__m128i*)max_diff_bytes, max_diff4);
+        for (unsigned char diff : max_diff_bytes)
+            max_diff = ImMax(max_diff, (int)diff);
+#endif
+        for (; n > 0; n--, a++, b++)
+        {
+            if (*a == *b)
+                continue;
+            const int diff = ImGuiCaptureImageBuf_PixelDiff(*a, *b);
+            max_diff = ImMax(max_diff, diff);
+            if (diff > tolerance)
+                mismatch_count++;
+        }
+    }
+    if (out_max_diff)
+        *out_max_diff = max_diff;
+
+    // Diff image: darkened copy of this image, pixels within tolerance in yellow, pixels above tolerance in red.
+    if (out_diff != NULL && mismatch_count > 0)
+    {
+        out_diff->CreateEmpty(Width, Height);
+        for (int n = 0; n < Width * Height; n++)
+        {
+            const unsigned int a = Data[n];
+            const unsigned int b = other->Data[n];
+            if (a == b)
+                out_diff->Data[n] = ((a >> 2) & 0x003F3F3F) | IM_COL32_A_MASK;
+            else
+                out_diff->Data[n] = (ImGuiCaptureImageBuf_PixelDiff(a, b) > tolerance) ? IM_COL32(255, 0, 0, 255) : IM_COL32(255, 255, 0, 255);
+        }
+    }
+    return mismatch_count;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Content-addressed image store
+//-----------------------------------------------------------------------------
+// Nightly runs mostly produce images identical to previous runs. With ImGuiCaptureContext::ContentStorePath set,
+// images are stored as "<store>/<hash of pixels><ext>" and encoded only once. Output file is a hard link to it.
+//-----------------------------------------------------------------------------
+
+static std::mutex GContentStoreStatsMutex;
+
+static inline ImU64 ImGuiCapture_RotateLeft64(ImU64 v, int n)
+{
+    return (v << n) | (v >> (64 - n));
+}
+
+// 64-bit hash of pixels and size. ImHashData() is 32-bit: collisions would be likely in a store of thousands of images.
+// Hashing 4 independent lanes lets the CPU overlap multiplications, so this is much faster than encoding.
+static ImU64 ImGuiCapture_HashImage(const ImGuiCaptureImageBuf* image)
+{
+    const ImU64 k1 = 0x87C37B91114253D5ULL;
+    const ImU64 k2 = 0x4CF5AD432745937FULL;
+    ImU64 lanes[4] = { 0x9E3779B97F4A7C15ULL, 0xC2B2AE3D27D4EB4FULL, 0x165667B19E3779F9ULL, 0x27D4EB2F165667C5ULL };
+    const unsigned char* p = (const unsigned char*)image->Data;
+    size_t size = (size_t)image->Width * (size_t)image->Height * 4;
+    for (; size >= 32; size -= 32, p += 32)
+        for (int n = 0; n < 4; n++)
+        {
+            ImU64 v;
+            memcpy(&v, p + n * 8, 8);
+            lanes[n] = ImGuiCapture_RotateLeft64(lanes[n] ^ (v * k1), 31) * k2;
+        }
+    ImU64 h = ((ImU64)image->Width << 32) | (ImU64)image->Height;
+    for (int n = 0; n < 4; n++)
+        h = ImGuiCapture_RotateLeft64(h ^ lanes[n], 27) * k1;
+    for (; size > 0; size--, p++)
+        h = (h ^ *p) * k2;
+
+    // Final mix (from MurmurHash3)
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return h;
+}
+
+static bool ImGuiCapture_LinkOrCopyFile(const char* src_filename, const char* dst_filename)
+{
+    return ImFileCreateHardLink(src_filename, dst_filename) || ImFileCopy(src_filename, dst_filename);
+}
+
+static ImU64 ImGuiCapture_GetFileSize(const char* filename)
+{
+    ImFileHandle f = ImFileOpen(filename, "rb");
+    if (f == NULL)
+        return 0;
+    ImU64 size = ImFileGetSize(f);
+    ImFileClose(f);
+    return size;
+}
+
+// Save an image, going through content store if 'store_path' is set. Called from encoding threads.
+static bool ImGuiCapture_SaveImageToStore(ImGuiCaptureImageBuf* image, const char* filename, const char* store_path, int png_compression_level, ImGuiCapturePngFilter png_filter, ImGuiCaptureContentStoreStats* stats)
+{
+    if (store_path == NULL || store_path[0] == 0)
+        return image->SaveFile(filename, png_compression_level, png_filter);
+
+    // Same pixels saved in another format are another entry
+    const char* extension = ImPathFindExtension(filename);
+    const unsigned long long hash = ImGuiCapture_HashImage(image);
+    Str256f store_filename("%s/%016llx%s", store_path, hash, extension);
+    const ImU64 pixels_count = (ImU64)image->Width * (ImU64)image->Height;
+    ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename));
+
+    if (ImFileExist(store_filename.c_str()))
+    {
+        if (!ImGuiCapture_LinkOrCopyFile(store_filename.c_str(), filename))
+            return false;
+        const ImU64 file_size = ImGuiCapture_GetFileSize(store_filename.c_str());
+        std::unique_lock<std::mutex> lock(GContentStoreStatsMutex);
+        stats->ImagesReused++;
+        stats->BytesReused += file_size;
+        stats->PixelsReused += pixels_count;
+        return true;
+    }
+
+    // Encode to a temporary file renamed once complete, so a partially written file is never linked.
+    // If another thread stored same image in the meantime, rename fails on some platforms: keep existing file.
+    Str256f tmp_filename("%s/%016llx_%p_tmp%s", store_path, hash, (void*)image, extension);
+    const ImU64 time_start = ImTimeGetInMicroseconds();
+    if (!image->SaveFile(tmp_filename.c_str(), png_compression_level, png_filter))
+        return false;
+    const double encode_time = (double)(ImTimeGetInMicroseconds() - time_start) / 1000000.0;
+    if (rename(tmp_filename.c_str(), store_filename.c_str()) != 0)
+        ImFileDelete(tmp_filename.c_str());
+    if (!ImGuiCapture_LinkOrCopyFile(store_filename.c_str(), filename))
+        return false;
+    const ImU64 file_size = ImGuiCapture_GetFileSize(store_filename.c_str());
+    std::unique_lock<std::mutex> lock(GContentStoreStatsMutex);
+    stats->ImagesStored++;
+    stats->BytesStored += file_size;
+    stats->PixelsStored += pixels_count;
+    stats->EncodeTimeStored += encode_time;
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiCaptureEncodeQueue
+//-----------------------------------------------------------------------------
+// PNG encoding of a large capture takes much longer than grabbing the framebuffer, so images are handed over to a
+// pool of background threads instead of being saved on the capturing (main) thread.
+// - Pixels are moved to the queue without copying. Buffers are recycled once saved, so capturing doesn't allocate.
+// - Queue is bounded: when EncodeQueueSize images are pending, capturing thread waits for a slot to free up.
+// - ImGuiCaptureContext::FlushPendingImages() and context destruction wait for all images to be saved.
+//-----------------------------------------------------------------------------
+
+struct ImGuiCaptureEncodeJob
+{
+    ImGuiCaptureImageBuf*       Image = NULL;
+    char                        Filename[256] = "";
+    char                        StorePath[256] = "";            // Content store directory, empty if disabled
+    int                         PngCompressionLevel = 8;
+    ImGuiCapturePngFilter       PngFilter = ImGuiCapturePngFilter_Adaptive;
+    ImGuiCaptureContentStoreStats* StoreStats = NULL;
+};
+
+struct ImGuiCaptureEncodeQueue
+{
+    std::mutex                  Mutex;
+    std::condition_variable     CondPending;                    // Signaled when jobs are queued or exit is requested
+    std::condition_variable     CondDone;                       // Signaled when a job is done
+    std::vector<std::thread>    Threads;
+    ImVector<ImGuiCaptureEncodeJob> Pending;                    // Protected by Mutex
+    ImVector<ImGuiCaptureImageBuf*> FreeImages;                 // Saved images, buffers ready for reuse. Protected by Mutex
+    int                         EncodingCount = 0;              // Jobs taken by threads and not done yet. Protected by Mutex
+    bool                        ExitRequested = false;          // Protected by Mutex
+
+    ~ImGuiCaptureEncodeQueue()  { for (ImGuiCaptureImageBuf* image : FreeImages) IM_DELETE(image); }
+};
+
+static void ImGuiCaptureEncodeThreadMain(ImGuiCaptureEncodeQueue* queue)
+{
+    ImThreadSetCurrentThreadDescription("Dear ImGui Capture Encoder");
+
+    std::unique_lock<std::mutex> lock(queue->Mutex);
+    while (true)
+    {
+        queue->CondPending.wait(lock, [queue]() { return queue->ExitRequested || !queue->Pending.empty(); });
+        if (queue->Pending.empty())
+            break; // ExitRequested and nothing left to save
+
+        ImGuiCaptureEncodeJob job = queue->Pending[0];
+        queue->Pending.erase(queue->Pending.Data);
+        queue->EncodingCount++;
+        lock.unlock();
+
+        if (!ImGuiCapture_SaveImageToStore(job.Image, job.Filename, job.StorePath, job.PngCompressionLevel, job.PngFilter, job.StoreStats))
+            fprintf(stderr, "Unable to save image '%s'.\n", job.Filename);
+
+        lock.lock();
+        queue->FreeImages.push_back(job.Image);
+        queue->EncodingCount--;
+        queue->CondDone.notify_all();
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiCaptureGifEncoder
+//-----------------------------------------------------------------------------
+// In-process encoder for .gif videos (see ImGuiCaptureContext::GifUseBuiltinEncoder). Compared to piping frames to
+// an encoder process, there is no process to start, no RGBA frames to pipe and no palette generation pass.
+// - Only the rectangle which changed since previous frame is encoded. Unchanged pixels inside it are transparent
+//   (frames are drawn over previous ones), which also makes long runs for LZW compression.
+// - Each frame has its own palette: exact when the frame uses 255 colors or less (common for UI), otherwise median
+//   cut over a 15-bit color histogram. No dithering: it would defeat delta encoding.
+// - Frames are quantized and compressed by GifEncodeThreadsCount background threads, and written in order by video
+//   writer thread. A repeated frame extends display time of previous frame instead of being encoded again.
+//-----------------------------------------------------------------------------
+
+#define IMGUI_CAPTURE_GIF_LZW_HASH_SIZE     8192    // Power of two, > 4096 codes
+
+// A frame being encoded.
+struct ImGuiCaptureGifFrame
+{
+    int                     X = 0, Y = 0, W = 0, H = 0;     // Rectangle which changed since previous frame.
+    ImVector<unsigned int>  Pixels;                         // W*H pixels of rectangle. Opaque (alpha set), or 0 for unchanged (transparent) pixels.
+    bool                    HasTransparency = false;
+    int                     FrameStart = 0;                 // Index of first video frame displaying this image.
+    int                     FrameEnd = -1;                  // Index of next video frame displaying another image. -1 until known.
+    bool                    Encoded = false;                // Protected by encoder Mutex.
+    ImVector<unsigned char> Data;                           // Graphic Control Extension + Image Descriptor + Local Color Table + Image Data. Delay is set when writing.
+};
+
+// Per compressing thread working memory.
+struct ImGuiCaptureGifScratch
+{
+    unsigned int            ColorKeys[1024];                // Exact palette: hash set of colors (0 = empty slot)
+    unsigned char           ColorIndices[1024];
+    ImVector<unsigned int>  Histogram;                      // Median cut: 32768 bins * (Count, SumR, SumG, SumB). Sums fit frames up to 16M pixels.
+    ImVector<unsigned char> HistogramLut;                   // Median cut: bin -> palette index
+    ImVector<int>           HistogramBins;                  // Median cut: used bins, partitioned by boxes
+    ImVector<unsigned char> Indices;                        // Palette index of each pixel
+    int                     LzwKeys[IMGUI_CAPTURE_GIF_LZW_HASH_SIZE];  // (prefix << 8 | index) + 1, 0 = empty slot
+    unsigned short          LzwCodes[IMGUI_CAPTURE_GIF_LZW_HASH_SIZE];
+};
+
+struct ImGuiCaptureGifEncoder
+{
+    std::mutex                  Mutex;
+    std::condition_variable     CondQueued;                 // Signaled when frames are queued or exit is requested
+    std::condition_variable     CondEncoded;                // Signaled when a frame has been encoded
+    std::vector<std::thread>    Threads;
+    ImVector<ImGuiCaptureGifFrame*> Queued;                 // Frames waiting to be encoded. Protected by Mutex
+    bool                        ExitRequested = false;      // Protected by Mutex
+
+    // Video writer thread only
+    FILE*                       File = NULL;
+    int                         Width = 0;
+    int                         Height = 0;
+    int                         Fps = 30;
+    int                         FramesCount = 0;            // Video frames added, including repeated ones
+    ImVector<ImGuiCaptureGifFrame*> InFlight;               // Frames not written yet, in display order
+    ImVector<ImGuiCaptureGifFrame*> FreeFrames;             // Written frames, ready for reuse
+    ImGuiCaptureGifScratch*     Scratch = NULL;             // Used when encoding without threads
+    bool                        WriteFailed = false;
+};
+
+// Build palette of frame pixels and convert them to palette indices. Transparent pixels use index 0.
+// Return number of palette entries (including transparent one).
+static int ImGuiCaptureGif_Quantize(ImGuiCaptureGifScratch* scratch, const ImGuiCaptureGifFrame* frame, unsigned int* palette)
+{
+    const unsigned int* pixels = frame->Pixels.Data;
+    const int pixels_count = frame->W * frame->H;
+    unsigned char* indices = scratch->Indices.Data;
+    const int first_color = frame->HasTransparency ? 1 : 0;
+    palette[0] = 0;
+
+    // Exact palette, if frame uses few enough colors
+    {
+        memset(scratch->ColorKeys, 0, sizeof(scratch->ColorKeys));
+        int palette_size = first_color;
+        unsigned int last_color = 0;
+        unsigned char last_index = 0;
+        int n = 0;
+        for (; n < pixels_count; n++)
+        {
+            const unsigned int color = pixels[n];
+            if (color != last_color && color == 0)
+            {
+                last_color = 0;
+                last_index = 0;
+            }
+            else if (color != last_color)
+            {
+                unsigned int slot = (color * 2654435761u) >> 22;
+                while (scratch->ColorKeys[slot] != 0 && scratch->ColorKeys[slot] != color)
+                    slot = (slot + 1) & (IM_ARRAYSIZE(scratch->ColorKeys) - 1);
+                if (scratch->ColorKeys[slot] == 0)
+                {
+                    if (palette_size == 256)
+                        break;
+                    scratch->ColorKeys[slot] = color;
+                    scratch->ColorIndices[slot] = (unsigned char)palette_size;
+                    palette[palette_size++] = color;
+                }
+                last_color = color;
+                last_index = scratch->ColorIndices[slot];
+            }
+            indices[n] = last_index;
+        }
+        if (n == pixels_count)
+            return palette_size;
+    }
+
+    // Median cut over a RGB555 histogram
+    unsigned int* histogram = scratch->Histogram.Data;
+    ImVector<int>& bins = scratch->HistogramBins;
+    bins.resize(0);
+    for (int n = 0; n < pixels_count; n++)
+    {
+        const unsigned int color = pixels[n];
+        if (color == 0)
+            continue;
+        const unsigned int r = color & 0xFF, g = (color >> 8) & 0xFF, b = (color >> 16) & 0xFF;
+        const int bin = (int)((r >> 3) | ((g >> 3) << 5) | ((b >> 3) << 10));
+        unsigned int* h = &histogram[bin * 4];
+        if (h[0]++ == 0)
+            bins.push_back(bin);
+        h[1] += r;
+        h[2] += g;
+        h[3] += b;
+    }
+
+    struct Box { int Begin, End; ImU64 Score; int Axis; };
+    Box boxes[256];
+    int boxes_count = 0;
+    auto add_box = [&](int begin, int end)
+    {
+        int min_c[3] = { 31, 31, 31 }, max_c[3] = { 0, 0, 0 };
+        ImU64 count = 0;
+        for (int n = begin; n < end; n++)
+        {
+            const int bin = bins[n];
+            for (int c = 0; c < 3; c++)
+            {
+                const int v = (bin >> (c * 5)) & 31;
+                min_c[c] = ImMin(min_c[c], v);
+                max_c[c] = ImMax(max_c[c], v);
+            }
+            count += histogram[bin * 4];
+        }
+        Box& box = boxes[boxes_count++];
+        box.Begin = begin;
+        box.End = end;
+        box.Axis = 0;
+        for (int c = 1; c < 3; c++)
+            if (max_c[c] - min_c[c] > max_c[box.Axis] - min_c[box.Axis])
+                box.Axis = c;
+        box.Score = (end - begin > 1) ? count * (ImU64)(max_c[box.Axis] - min_c[box.Axis] + 1) : 0;
+    };
+    add_box(0, bins.Size);
+    while (boxes_count < 256 - first_color)
+    {
+        // Split box with most pixels times largest extent, at median of its largest axis
+        Box* box = &boxes[0];
+        for (int n = 1; n < boxes_count; n++)
+            if (boxes[n].Score > box->Score)
+                box = &boxes[n];
+        if (box->Score == 0)
+            break;
+        const int shift = box->Axis * 5;
+        ImU64 axis_counts[32] = {};
+        ImU64 total = 0;
+        for (int n = box->Begin; n < box->End; n++)
+            axis_counts[(bins[n] >> shift) & 31] += histogram[bins[n] * 4];
+        int min_v = 0, max_v = 31;
+        while (axis_counts[min_v] == 0)
+            min_v++;
+        while (axis_counts[max_v] == 0)
+            max_v--;
+        for (int v = min_v; v <= max_v; v++)
+            total += axis_counts[v];
+        int split_v = min_v;
+        ImU64 half = axis_counts[min_v];
+        while (split_v < max_v - 1 && half * 2 < total)
+            half += axis_counts[++split_v];
+
+        // Partition bins: values <= split_v first
+        int split = box->Begin;
+        for (int n = box->Begin; n < box->End; n++)
+            if (((bins[n] >> shift) & 31) <= split_v)
+                ImSwap(bins[n], bins[split++]);
+        const int begin = box->Begin, end = box->End;
+        *box = boxes[--boxes_count];
+        add_box(begin, split);
+        add_box(split, end);
+    }
+
+    // Palette entries are average colors of their box
+    unsigned char* lut = scratch->HistogramLut.Data;
+    for (int box_n = 0; box_n < boxes_count; box_n++)
+    {
+        ImU64 count = 0, sum_r = 0, sum_g = 0, sum_b = 0;
+        for (int n = boxes[box_n].Begin; n < boxes[box_n].End; n++)
+        {
+            unsigned int* h = &histogram[bins[n] * 4];
+            count += h[0];
+            sum_r += h[1];
+            sum_g += h[2];
+            sum_b += h[3];
+            h[0] = h[1] = h[2] = h[3] = 0;
+            lut[bins[n]] = (unsigned char)(first_color + box_n);
+        }
+        palette[first_color + box_n] = (unsigned int)((sum_r + count / 2) / count) | ((unsigned int)((sum_g + count / 2) / count) << 8) | ((unsigned int)((sum_b + count / 2) / count) << 16);
+    }
+    for (int n = 0; n < pixels_count; n++)
+    {
+        const unsigned int color = pixels[n];
+        indices[n] = (color == 0) ? 0 : lut[((color >> 3) & 0x1F) | ((color >> 6) & 0x3E0) | ((color >> 9) & 0x7C00)];
+    }
+    return first_color + boxes_count;
+}
+
+// Compress palette indices with variable-length code LZW, output data sub-blocks.
+static void ImGuiCaptureGif_CompressLzw(ImGuiCaptureGifScratch* scratch, const unsigned char* indices, int count, int min_code_size, ImVector<unsigned char>* out)
+{
+    const int clear_code = 1 << min_code_size;
+    int code_size = min_code_size + 1;
+    int next_code = clear_code + 2;
+    ImU64 bits = 0;
+    int bits_count = 0;
+    int block_start = out->Size;
+    out->push_back(0);
+    auto write_code = [&](int code)
+    {
+        bits |= (ImU64)code << bits_count;
+        bits_count += code_size;
+        while (bits_count >= 8)
+        {
+            out->push_back((unsigned char)bits);
+            bits >>= 8;
+            bits_count -= 8;
+            if (out->Size - block_start == 256)
+            {
+                (*out)[block_start] = 255;
+                block_start = out->Size;
+                out->push_back(0);
+            }
+        }
+    };
+
+    memset(scratch->LzwKeys, 0, sizeof(scratch->LzwKeys));
+    write_code(clear_code);
+    int prefix = indices[0];
+    for (int n = 1; n < count; n++)
+    {
+        const int key = ((prefix << 8) | indices[n]) + 1;
+        unsigned int slot = ((unsigned int)key * 2654435761u) >> (32 - 13);
+        while (scratch->LzwKeys[slot] != 0 && scratch->LzwKeys[slot] != key)
+            slot = (slot + 1) & (IMGUI_CAPTURE_GIF_LZW_HASH_SIZE - 1);
+        if (scratch->LzwKeys[slot] == key)
+        {
+            prefix = scratch->LzwCodes[slot];
+            continue;
+        }
+
+        write_code(prefix);
+        scratch->LzwKeys[slot] = key;
+        scratch->LzwCodes[slot] = (unsigned short)next_code;
+        if (next_code >= (1 << code_size))
+            code_size++;
+        if (next_code == 4095)
+        {
+            // Table full: start over
+            write_code(clear_code);
+            memset(scratch->LzwKeys, 0, sizeof(scratch->LzwKeys));
+            code_size = min_code_size + 1;
+            next_code = clear_code + 2;
+        }
+        else
+        {
+            next_code++;
+        }
+        prefix = indices[n];
+    }
+    write_code(prefix);
+
+    // Decoder adds a table entry when reading last code, which may increase code size.
+    if (next_code == (1 << code_size) && code_size < 12)
+        code_size++;
+    write_code(clear_code + 1);
+    if (bits_count > 0)
+        out->push_back((unsigned char)bits);
+    if (out->Size - block_start > 1)
+    {
+        (*out)[block_start] = (unsigned char)(out->Size - block_start - 1);
+        out->push_back(0);
+    }
+    else
+    {
+        (*out)[block_start] = 0; // Block terminator
+    }
+}
+
+static void ImGuiCaptureGif_EncodeFrame(ImGuiCaptureGifScratch* scratch, ImGuiCaptureGifFrame* frame)
+{
+    if (scratch->Histogram.Size == 0)
+    {
+        scratch->Histogram.resize(32768 * 4, 0);
+        scratch->HistogramLut.resize(32768);
+    }
+    scratch->Indices.resize(frame->W * frame->H);
+
+    unsigned int palette[256];
+    const int palette_size = ImGuiCaptureGif_Quantize(scratch, frame, palette);
+    int table_bits = 1;
+    while ((1 << table_bits) < palette_size)
+        table_bits++;
+
+    ImVector<unsigned char>& out = frame->Data;
+    out.resize(0);
+    auto write_u16 = [&out](int v) { out.push_back((unsigned char)(v & 0xFF)); out.push_back((unsigned char)(v >> 8)); };
+
+    // Graphic Control Extension: keep frame when drawing next one (disposal method 1)
+    const unsigned char gce[] = { 0x21, 0xF9, 0x04, (unsigned char)((1 << 2) | (frame->HasTransparency ? 1 : 0)), 0, 0, 0, 0 };
+    for (unsigned char c : gce)
+        out.push_back(c);
+
+    // Image Descriptor + Local Color Table
+    out.push_back(0x2C);
+    write_u16(frame->X);
+    write_u16(frame->Y);
+    write_u16(frame->W);
+    write_u16(frame->H);
+    out.push_back((unsigned char)(0x80 | (table_bits - 1)));
+    for (int n = 0; n < (1 << table_bits); n++)
+    {
+        const unsigned int color = (n < palette_size) ? palette[n] : 0;
+        out.push_back((unsigned char)(color & 0xFF));
+        out.push_back((unsigned char)((color >> 8) & 0xFF));
+        out.push_back((unsigned char)((color >> 16) & 0xFF));
+    }
+
+    // Image Data
+    const int min_code_size = ImMax(table_bits, 2);
+    out.push_back((unsigned char)min_code_size);
+    ImGuiCaptureGif_CompressLzw(scratch, scratch->Indices.Data, frame->W * frame->H, min_code_size, &out);
+}
+
+static void ImGuiCaptureGifEncoderThreadMain(ImGuiCaptureGifEncoder* encoder)
+{
+    ImThreadSetCurrentThreadDescription("Dear ImGui Capture Gif Encoder");
+
+    ImGuiCaptureGifScratch* scratch = IM_NEW(ImGuiCaptureGifScratch)();
+    std::unique_lock<std::mutex> lock(encoder->Mutex);
+    while (true)
+    {
+        encoder->CondQueued.wait(lock, [encoder]() { return encoder->ExitRequested || !encoder->Queued.empty(); });
+        if (encoder->Queued.empty())
+            break;
+
+        ImGuiCaptureGifFrame* frame = encoder->Queued[0];
+        encoder->Queued.erase(encoder->Queued.Data);
+        lock.unlock();
+        ImGuiCaptureGif_EncodeFrame(scratch, frame);
+        lock.lock();
+        frame->Encoded = true;
+        encoder->CondEncoded.notify_all();
+    }
+    lock.unlock();
+    IM_DELETE(scratch);
+}
+
+// Write encoded frames whose display time is known, in order. Optionally wait for frames being encoded.
+static void ImGuiCaptureGifEncoder_WriteFrames(ImGuiCaptureGifEncoder* encoder, int max_frames_in_flight)
+{
+    while (!encoder->InFlight.empty())
+    {
+        ImGuiCaptureGifFrame* frame = encoder->InFlight[0];
+        if (frame->FrameEnd < 0)
+            break;
+        {
+            std::unique_lock<std::mutex> lock(encoder->Mutex);
+            if (!frame->Encoded && encoder->InFlight.Size <= max_frames_in_flight)
+                break;
+            encoder->CondEncoded.wait(lock, [frame]() { return frame->Encoded; });
+        }
+
+        // Frame times are rounded to 1/100th of a second from start of video, so errors don't accumulate.
+        const int delay = (frame->FrameEnd * 100 / encoder->Fps) - (frame->FrameStart * 100 / encoder->Fps);
+        frame->Data[4] = (unsigned char)(delay & 0xFF);
+        frame->Data[5] = (unsigned char)(delay >> 8);
+        if (!encoder->WriteFailed && fwrite(frame->Data.Data, 1, (size_t)frame->Data.Size, encoder->File) != (size_t)frame->Data.Size)
+        {
+            fprintf(stderr, "Writing to video file failed.\n");
+            encoder->WriteFailed = true;
+        }
+        encoder->InFlight.erase(encoder->InFlight.Data);
+        encoder->FreeFrames.push_back(frame);
+    }
+}
+
+// Add a video frame. 'pixels' == NULL repeats previous frame. 'prev_pixels' is previous frame, or NULL if this is first frame.
+void ImGuiCaptureGifEncoder_AddFrame(ImGuiCaptureGifEncoder* encoder, const unsigned int* pixels, const unsigned int* prev_pixels)
+{
+    const int w = encoder->Width;
+    const int h = encoder->Height;
+    int x1 = 0, y1 = 0, x2 = w, y2 = h;
+    if (pixels != NULL && prev_pixels != NULL)
+    {
+        // Find rectangle of pixels which changed since previous frame
+        while (y1 < h && memcmp(&pixels[y1 * w], &prev_pixels[y1 * w], (size_t)w * sizeof(unsigned int)) == 0)
+            y1++;
+        if (y1 == h)
+            pixels = NULL;
+        while (pixels != NULL && memcmp(&pixels[(y2 - 1) * w], &prev_pixels[(y2 - 1) * w], (size_t)w * sizeof(unsigned int)) == 0)
+            y2--;
+        x1 = w;
+        x2 = 0;
+        for (int y = y1; y < y2; y++)
+        {
+            const unsigned int* row = &pixels[y * w];
+            const unsigned int* prev_row = &prev_pixels[y * w];
+            int x = 0;
+            while (x < x1 && row[x] == prev_row[x])
+                x++;
+            x1 = x;
+            x = w;
+            while (x > x2 && row[x - 1] == prev_row[x - 1])
+                x--;
+            x2 = x;
+        }
+    }
+    if (pixels == NULL)
+    {
+        // Same as previous frame: display it longer
+        IM_ASSERT(encoder->FramesCount > 0);
+        encoder->FramesCount++;
+        return;
+    }
+
+    ImGuiCaptureGifFrame* frame;
+    if (!encoder->FreeFrames.empty())
+    {
+        frame = encoder->FreeFrames.back();
+        encoder->FreeFrames.pop_back();
+    }
+    else
+    {
+        frame = IM_NEW(ImGuiCaptureGifFrame)();
+    }
+    frame->X = x1;
+    frame->Y = y1;
+    frame->W = x2 - x1;
+    frame->H = y2 - y1;
+    frame->Pixels.resize(frame->W * frame->H);
+    frame->HasTransparency = false;
+    frame->FrameStart = encoder->FramesCount;
+    frame->FrameEnd = -1;
+    frame->Encoded = false;
+    unsigned int* dst = frame->Pixels.Data;
+    for (int y = y1; y < y2; y++)
+    {
+        const unsigned int* row = &pixels[y * w];
+        if (prev_pixels == NULL)
+        {
+            for (int x = x1; x < x2; x++)
+                *dst++ = row[x] | IM_COL32_A_MASK;
+            continue;
+        }
+        const unsigned int* prev_row = &prev_pixels[y * w];
+        for (int x = x1; x < x2; x++)
+        {
+            const bool unchanged = row[x] == prev_row[x];
+            *dst++ = unchanged ? 0 : (row[x] | IM_COL32_A_MASK);
+            frame->HasTransparency |= unchanged;
+        }
+    }
+    if (!encoder->InFlight.empty())
+        encoder->InFlight.back()->FrameEnd = encoder->FramesCount;
+    encoder->InFlight.push_back(frame);
+    encoder->FramesCount++;
+
+    if (encoder->Threads.empty())
+    {
+        ImGuiCaptureGif_EncodeFrame(encoder->Scratch, frame);
+        frame->Encoded = true;
+    }
+    else
+    {
+        {
+            std::unique_lock<std::mutex> lock(encoder->Mutex);
+            encoder->Queued.push_back(frame);
+        }
+        encoder->CondQueued.notify_one();
+    }
+
+    // Keep a bounded number of frames in memory: wait for oldest frames when all threads are busy.
+    ImGuiCaptureGifEncoder_WriteFrames(encoder, (int)encoder->Threads.size() * 2);
+}
+
+// Create output file and start compressing threads. Return NULL if file can't be created.
+ImGuiCaptureGifEncoder* ImGuiCaptureGifEncoder_Create(const char* filename, int width, int height, int fps, int threads_count)
+{
+    IM_ASSERT(width > 0 && width <= 0xFFFF && height > 0 && height <= 0xFFFF);
+    FILE* f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+        return NULL;
+
+    // Header, Logical Screen Descriptor without global color table, loop forever (NETSCAPE2.0 application extension)
+    const unsigned char header[] =
+    {
+        'G', 'I', 'F', '8', '9', 'a',
+        (unsigned char)(width & 0xFF), (unsigned char)(width >> 8), (unsigned char)(height & 0xFF), (unsigned char)(height >> 8), 0x00, 0x00, 0x00,
+        0x21, 0xFF, 0x0B, 'N', 'E', 'T', 'S', 'C', 'A', 'P', 'E', '2', '.', '0', 0x03, 0x01, 0x00, 0x00, 0x00,
+    };
+    fwrite(header, 1, sizeof(header), f);
+
+    ImGuiCaptureGifEncoder* encoder = IM_NEW(ImGuiCaptureGifEncoder)();
+    encoder->File = f;
+    encoder->Width = width;
+    encoder->Height = height;
+    encoder->Fps = fps;
+    if (threads_count <= 0)
+        encoder->Scratch = IM_NEW(ImGuiCaptureGifScratch)();
+    for (int n = 0; n < threads_count; n++)
+        encoder->Threads.push_back(std::thread(ImGuiCaptureGifEncoderThreadMain, encoder));
+    return encoder;
+}
+
+// Write remaining frames, close file and stop compressing threads.
+void ImGuiCaptureGifEncoder_Destroy(ImGuiCaptureGifEncoder* encoder)
+{
+    if (!encoder->InFlight.empty())
+        encoder->InFlight.back()->FrameEnd = encoder->FramesCount;
+    ImGuiCaptureGifEncoder_WriteFrames(encoder, 0);
+    fputc(0x3B, encoder->File); // Trailer
+    ImFileClose(encoder->File);
+
+    {
+        std::unique_lock<std::mutex> lock(encoder->Mutex);
+        encoder->ExitRequested = true;
+    }
+    encoder->CondQueued.notify_all();
+    for (std::thread& thread : encoder->Threads)
+        thread.join();
+    for (ImGuiCaptureGifFrame* frame : encoder->FreeFrames)
+        IM_DELETE(frame);
+    if (encoder->Scratch != NULL)
+        IM_DELETE(encoder->Scratch);
+    IM_DELETE(encoder);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiCaptureVideoWriter
+//-----------------------------------------------------------------------------
+// Video frames are written to the encoder process (or to ImGuiCaptureGifEncoder) from a background thread, so a slow
+// encoder doesn't stall the application being recorded.
+// - Frame pixels are moved to the writer without copying. Written buffers are recycled for next frames.
+// - A frame identical to previous one is queued without pixels: writer repeats the last written frame.
+//   Pixels are not compared when caller already knows whether frame changed (see Video damage tracking).
+// - When VideoFrameQueueSize frames are pending, new frames are dropped and previous frame is repeated instead,
+//   preserving video timing. Dropped frames are reported in ImGuiCaptureArgs::OutVideoFramesDropped.
+//-----------------------------------------------------------------------------
+
+struct ImGuiCaptureVideoWriter
+{
+    std::mutex                  Mutex;
+    std::condition_variable     CondPending;                    // Signaled when frames are queued or exit is requested
+    std::thread                 Thread;
+    FILE*                       Pipe = NULL;                    // Stdin of encoder process. Used by writer thread only once started.
+    ImGuiCaptureGifEncoder*     GifEncoder = NULL;              // _OR_ In-process .gif encoder. Used by writer thread only once started.
+    int                         Width = 0;
+    int                         Height = 0;
+    ImVector<unsigned int*>     Pending;                        // Frames waiting to be written. NULL repeats previous frame. Protected by Mutex
+    ImVector<unsigned int*>     FreeFrames;                     // Written frames, ready for reuse. Protected by Mutex
+    int                         PendingPixelFrames = 0;         // Frames in Pending which are not NULL. Protected by Mutex
+    bool                        ExitRequested = false;          // Write remaining frames and close encoder. Protected by Mutex
+
+    // Capturing thread only
+    unsigned int*               LastQueuedFrame = NULL;         // Stays valid and unmodified until a newer frame is queued
+    int                         FramesCount = 0;
+    int                         FramesRepeated = 0;
+    int                         FramesDropped = 0;
+
+    ~ImGuiCaptureVideoWriter()  { for (unsigned int* frame : FreeFrames) IM_FREE(frame); }
+};
+
+static void ImGuiCaptureVideoWriterThreadMain(ImGuiCaptureVideoWriter* writer)
+{
+    ImThreadSetCurrentThreadDescription("Dear ImGui Capture Video Writer");
+
+    const size_t frame_size = (size_t)writer->Width * writer->Height * 4;
+    unsigned int* last_written_frame = NULL;
+    bool write_failed = false;
+    std::unique_lock<std::mutex> lock(writer->Mutex);
+    while (true)
+    {
+        writer->CondPending.wait(lock, [writer]() { return writer->ExitRequested || !writer->Pending.empty(); });
+        if (writer->Pending.empty())
+            break; // ExitRequested and all frames written
+
+        unsigned int* frame = writer->Pending[0];
+        unsigned int* prev_frame = NULL;
+        writer->Pending.erase(writer->Pending.Data);
+        if (frame != NULL)
+        {
+            writer->PendingPixelFrames--;
+            prev_frame = last_written_frame;
+            last_written_frame = frame;
+        }
+        lock.unlock();
+
+        IM_ASSERT(last_written_frame != NULL);
+        if (writer->GifEncoder != NULL)
+        {
+            ImGuiCaptureGifEncoder_AddFrame(writer->GifEncoder, frame, prev_frame);
+        }
+        else if (!write_failed && fwrite(last_written_frame, 1, frame_size, writer->Pipe) != frame_size)
+        {
+            fprintf(stderr, "Writing to video encoder failed.\n");
+            write_failed = true;
+        }
+
+        lock.lock();
+        if (prev_frame != NULL)
+            writer->FreeFrames.push_back(prev_frame);
+    }
+    lock.unlock();
+
+    if (writer->GifEncoder != NULL)
+        ImGuiCaptureGifEncoder_Destroy(writer->GifEncoder);
+    else
+        ImOsPClose(writer->Pipe);
+    writer->GifEncoder = NULL;
+    writer->Pipe = NULL;
+    if (last_written_frame != NULL)
+        IM_FREE(last_written_frame);
+}
+
+// Queue captured frame. Pixels are moved out of 'frame', which receives a recycled buffer of same size.
+// 'frame_changed': -1 to compare pixels with last queued frame, 0 if known identical (pixels are not read), 1 if known different.
+// Returns false when frame was dropped, in which case LastQueuedFrame is unchanged.
+static bool ImGuiCaptureVideoWriter_PushFrame(ImGuiCaptureVideoWriter* writer, ImGuiCaptureImageBuf* frame, int queue_size, int frame_changed)
+{
+    IM_ASSERT(frame->Width == writer->Width && frame->Height == writer->Height);
+    const size_t frame_size = (size_t)writer->Width * writer->Height * 4;
+    bool is_repeated = false;
+    if (writer->LastQueuedFrame != NULL)
+        is_repeated = (frame_changed >= 0) ? (frame_changed == 0) : (memcmp(writer->LastQueuedFrame, frame->Data, frame_size) == 0);
+    bool is_dropped = false;
+    {
+        std::unique_lock<std::mutex> lock(writer->Mutex);
+        if (is_repeated)
+        {
+            writer->Pending.push_back(NULL);
+            writer->FramesRepeated++;
+        }
+        else if (writer->LastQueuedFrame != NULL && writer->PendingPixelFrames >= ImMax(queue_size, 1))
+        {
+            writer->Pending.push_back(NULL);
+            writer->FramesDropped++;
+            is_dropped = true;
+        }
+        else
+        {
+            unsigned int* recycled_frame = NULL;
+            if (!writer->FreeFrames.empty())
+            {
+                recycled_frame = writer->FreeFrames.back();
+                writer->FreeFrames.pop_back();
+            }
+            else
+            {
+                recycled_frame = (unsigned int*)IM_ALLOC(frame_size);
+            }
+            writer->Pending.push_back(frame->Data);
+            writer->PendingPixelFrames++;
+            writer->LastQueuedFrame = frame->Data;
+            frame->Data = recycled_frame;           // Fully overwritten by next captured frame
+            frame->Capacity = frame->Width * frame->Height;
+        }
+        writer->FramesCount++;
+    }
+    writer->CondPending.notify_one();
+    return !is_dropped;
+}
+
+// Wait for remaining frames to be written and encoder process to exit.
+static void ImGuiCaptureVideoWriter_Destroy(ImGuiCaptureVideoWriter* writer)
+{
+    {
+        std::unique_lock<std::mutex> lock(writer->Mutex);
+        writer->ExitRequested = true;
+    }
+    writer->CondPending.notify_one();
+    writer->Thread.join();
+    IM_DELETE(writer);
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Video damage tracking
+//-----------------------------------------------------------------------------
+// When recording video, main viewport is split in tiles and each tile gets a hash of draw data primitives overlapping
+// it, in rendering order. Only tiles whose hash changed since last queued frame are read back from framebuffer, other
+// pixels are copied from last queued frame, so encoder still receives complete frames. A mostly idle recording reads
+// back a blinking cursor instead of the whole capture rect, and unchanged frames are not read back nor compared at all.
+// - Draw callbacks are considered to change their whole clip rect on every frame.
+// - Contents which are not described by draw data are not tracked (see ImGuiCaptureContext::VideoDamageTracking).
+// - ImGuiCaptureContext::VideoDamageTrackingCheck reads back whole frames as well and compares them, for debugging.
+//-----------------------------------------------------------------------------
+
+#define IMGUI_CAPTURE_DAMAGE_TILE_SIZE  32
+
+static inline ImU32 ImGuiCapture_HashMix(ImU32 h, ImU32 v)
+{
+    v *= 0xCC9E2D51;
+    v = (v << 15) | (v >> 17);
+    h ^= v * 0x1B873593;
+    h = (h << 13) | (h >> 19);
+    return h * 5 + 0xE6546B64;
+}
+
+// Fold each triangle of draw data into hashes of tiles overlapped by its bounding box.
+static void ImGuiCapture_HashDrawDataTiles(const ImDrawData* draw_data, int tiles_columns, int tiles_rows, ImU32* tiles)
+{
+    const float tile_scale = 1.0f / IMGUI_CAPTURE_DAMAGE_TILE_SIZE;
+    const ImVec2 display_pos = draw_data->DisplayPos;
+    const ImVec2 display_max((float)(tiles_columns * IMGUI_CAPTURE_DAMAGE_TILE_SIZE), (float)(tiles_rows * IMGUI_CAPTURE_DAMAGE_TILE_SIZE));
+    memset(tiles, 0, (size_t)(tiles_columns * tiles_rows) * sizeof(ImU32));
+    auto fold_rect = [&](ImVec2 min, ImVec2 max, ImU32 hash)
+    {
+        // +1 pixel around rect, where antialiased edges may be drawn
+        const int tx0 = (int)(ImMax(min.x - 1.0f, 0.0f) * tile_scale);
+        const int ty0 = (int)(ImMax(min.y - 1.0f, 0.0f) * tile_scale);
+        const int tx1 = ImMin((int)((max.x + 1.0f) * tile_scale), tiles_columns - 1);
+        const int ty1 = ImMin((int)((max.y + 1.0f) * tile_scale), tiles_rows - 1);
+        for (int ty = ty0; ty <= ty1; ty++)
+            for (int tx = tx0; tx <= tx1; tx++)
+                tiles[ty * tiles_columns + tx] = ImGuiCapture_HashMix(tiles[ty * tiles_columns + tx], hash);
+    };
+
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            if (cmd.UserCallback == ImDrawCallback_ResetRenderState)
+                continue;
+            const ImVec2 clip_min(ImMax(cmd.ClipRect.x - display_pos.x, 0.0f), ImMax(cmd.ClipRect.y - display_pos.y, 0.0f));
+            const ImVec2 clip_max(ImMin(cmd.ClipRect.z - display_pos.x, display_max.x), ImMin(cmd.ClipRect.w - display_pos.y, display_max.y));
+            if (clip_min.x >= clip_max.x || clip_min.y >= clip_max.y)
+                continue;
+            if (cmd.UserCallback != NULL)
+            {
+                fold_rect(clip_min, clip_max, (ImU32)ImGui::GetFrameCount());
+                continue;
+            }
+
+            const ImTextureID tex_id = cmd.GetTexID();
+            const ImU32 cmd_hash = ImHashData(&tex_id, sizeof(tex_id));
+            const ImDrawVert* vtx = draw_list->VtxBuffer.Data + cmd.VtxOffset;
+            const ImDrawIdx* idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+            for (unsigned int n = 0; n + 2 < cmd.ElemCount; n += 3)
+            {
+                const ImDrawVert* v[3] = { &vtx[idx[n]], &vtx[idx[n + 1]], &vtx[idx[n + 2]] };
+                ImU32 hash = cmd_hash;
+                for (const ImDrawVert* vert : v)
+                    for (int word_n = 0; word_n < (int)(sizeof(ImDrawVert) / sizeof(ImU32)); word_n++)
+                    {
+                        ImU32 word;
+                        memcpy(&word, (const char*)vert + word_n * sizeof(ImU32), sizeof(ImU32));
+                        hash = ImGuiCapture_HashMix(hash, word);
+                    }
+                const ImVec2 min = ImMax(ImMin(ImMin(v[0]->pos, v[1]->pos), v[2]->pos) - display_pos, clip_min);
+                const ImVec2 max = ImMin(ImMax(ImMax(v[0]->pos, v[1]->pos), v[2]->pos) - display_pos, clip_max);
+                if (min.x < max.x && min.y < max.y)
+                    fold_rect(min, max, hash);
+            }
+        }
+    }
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiCaptureContext
 //-----------------------------------------------------------------------------
 
+ImGuiCaptureContext::~ImGuiCaptureContext()
+{
+    if (_VideoWriter != NULL)
+        ImGuiCaptureVideoWriter_Destroy(_VideoWriter);
+    _VideoWriter = NULL;
+
+    ImGuiCaptureEncodeQueue* queue = _EncodeQueue;
+    if (queue == NULL)
+        return;
+    {
+        std::unique_lock<std::mutex> lock(queue->Mutex);
+        queue->ExitRequested = true;
+    }
+    queue->CondPending.notify_all();
+    for (std::thread& thread : queue->Threads)
+        thread.join();
+    IM_DELETE(queue);
+    _EncodeQueue = NULL;
+}
+
+bool ImGuiCaptureContext::_SaveImage(ImGuiCaptureImageBuf* image, const char* filename, int png_compression_level, ImGuiCapturePngFilter png_filter)
+{
+    IM_ASSERT(image->Data != NULL);
+    if (EncodeThreadsCount <= 0 && _EncodeQueue == NULL)
+    {
+        bool ret = ImGuiCapture_SaveImageToStore(image, filename, ContentStorePath, png_compression_level, png_filter, &_ContentStoreStats);
+        image->Clear();
+        return ret;
+    }
+
+    // Create threads on first use
+    ImGuiCaptureEncodeQueue* queue = _EncodeQueue;
+    if (queue == NULL)
+    {
+        queue = _EncodeQueue = IM_NEW(ImGuiCaptureEncodeQueue)();
+        for (int n = 0; n < EncodeThreadsCount; n++)
+            queue->Threads.push_back(std::thread(ImGuiCaptureEncodeThreadMain, queue));
+    }
+
+    // Swap pixels with a recycled buffer, which will be reused by next capture
+    ImGuiCaptureEncodeJob job;
+    ImStrncpy(job.Filename, filename, IM_ARRAYSIZE(job.Filename));
+    ImStrncpy(job.StorePath, ContentStorePath ? ContentStorePath : "", IM_ARRAYSIZE(job.StorePath));
+    job.StoreStats = &_ContentStoreStats;
+    job.PngCompressionLevel = png_compression_level;
+    job.PngFilter = png_filter;
+    {
+        std::unique_lock<std::mutex> lock(queue->Mutex);
+        const int queue_size = ImMax(EncodeQueueSize, 1);
+        queue->CondDone.wait(lock, [queue, queue_size]() { return queue->Pending.Size + queue->EncodingCount < queue_size; });
+        if (!queue->FreeImages.empty())
+        {
+            job.Image = queue->FreeImages.back();
+            queue->FreeImages.pop_back();
+        }
+        else
+        {
+            job.Image = IM_NEW(ImGuiCaptureImageBuf)();
+        }
+        ImSwap(job.Image->Width, image->Width);
+        ImSwap(job.Image->Height, image->Height);
+        ImSwap(job.Image->Data, image->Data);
+        ImSwap(job.Image->Capacity, image->Capacity);
+        queue->Pending.push_back(job);
+    }
+    queue->CondPending.notify_one();
+    return true;
+}
+
+void ImGuiCaptureContext::FlushPendingImages()
+{
+    if (_VideoWriter != NULL && !_VideoRecording && !_VideoFinalizing)
+    {
+        ImGuiCaptureVideoWriter_Destroy(_VideoWriter);
+        _VideoWriter = NULL;
+    }
+
+    ImGuiCaptureEncodeQueue* queue = _EncodeQueue;
+    if (queue == NULL)
+        return;
+    std::unique_lock<std::mutex> lock(queue->Mutex);
+    queue->CondDone.wait(lock, [queue]() { return queue->Pending.empty() && queue->EncodingCount == 0; });
+}
+
+int ImGuiCaptureContext::GetPendingImagesCount()
+{
+    ImGuiCaptureEncodeQueue* queue = _EncodeQueue;
+    if (queue == NULL)
+        return 0;
+    std::unique_lock<std::mutex> lock(queue->Mutex);
+    return queue->Pending.Size + queue->EncodingCount;
+}
+
+ImGuiCaptureContentStoreStats ImGuiCaptureContext::GetContentStoreStats()
+{
+    std::unique_lock<std::mutex> lock(GContentStoreStatsMutex);
+    return _ContentStoreStats;
+}
+
 #if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
 static void HideOtherWindows(const ImGuiCaptureArgs* args)
 {
@@ -209,6 +1461,107 @@ void ImGuiCaptureContext::PostRender()
 {
     ImGuiContext& g = *GImGui;
     g.IO.MouseDrawCursor = _BackupMouseDrawCursor;
+
+    // Hash draw data of frames which are going to be recorded, while draw data is valid
+    if (!_VideoRecording || !VideoDamageTracking || _CaptureArgs == NULL || (_CaptureArgs->InFlags & ImGuiCaptureFlags_NoSave))
+        return;
+    if (_VideoLastFrameTime > 0 && ImGui::GetTime() - _VideoLastFrameTime < 1.0 / _CaptureArgs->InRecordFPSTarget)
+        return;
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    if (draw_data == NULL || !draw_data->Valid || draw_data->FramebufferScale.x != 1.0f || draw_data->FramebufferScale.y != 1.0f)
+    {
+        _DamageFrameCount = -1; // Fallback to full readback
+        return;
+    }
+    const int tiles_columns = ((int)draw_data->DisplaySize.x + IMGUI_CAPTURE_DAMAGE_TILE_SIZE - 1) / IMGUI_CAPTURE_DAMAGE_TILE_SIZE;
+    const int tiles_rows = ((int)draw_data->DisplaySize.y + IMGUI_CAPTURE_DAMAGE_TILE_SIZE - 1) / IMGUI_CAPTURE_DAMAGE_TILE_SIZE;
+    if (tiles_columns != _DamageTilesColumns || tiles_rows != _DamageTilesRows)
+    {
+        _DamageTilesColumns = tiles_columns;
+        _DamageTilesRows = tiles_rows;
+        _DamageTilesQueued.clear();
+    }
+    _DamageTiles.resize(tiles_columns * tiles_rows);
+    if (!_DamageTiles.empty())
+        ImGuiCapture_HashDrawDataTiles(draw_data, tiles_columns, tiles_rows, _DamageTiles.Data);
+    _DamageFrameCount = g.FrameCount;
+}
+
+// Fill video frame 'output' (capture rect starting at x1, y1) with last queued frame, then read back tiles whose hash
+// changed since last queued frame. Rows of changed tiles sharing same columns span are read back in a single call.
+bool ImGuiCaptureContext::_CaptureDamagedRegions(ImGuiCaptureArgs* args, ImGuiID viewport_id, int x1, int y1, ImGuiCaptureImageBuf* output, bool* out_changed)
+{
+    IM_ASSERT(_VideoWriter != NULL && _VideoWriter->LastQueuedFrame != NULL);
+    IM_ASSERT(_DamageTiles.Size == _DamageTilesQueued.Size && _DamageTiles.Size == _DamageTilesColumns * _DamageTilesRows);
+    const int w = output->Width;
+    const int h = output->Height;
+    const int tile_x0 = x1 / IMGUI_CAPTURE_DAMAGE_TILE_SIZE;
+    const int tile_y0 = y1 / IMGUI_CAPTURE_DAMAGE_TILE_SIZE;
+    const int tile_x1 = ImMin((x1 + w - 1) / IMGUI_CAPTURE_DAMAGE_TILE_SIZE, _DamageTilesColumns - 1);
+    const int tile_y1 = ImMin((y1 + h - 1) / IMGUI_CAPTURE_DAMAGE_TILE_SIZE, _DamageTilesRows - 1);
+
+    // Find span of changed tiles in a row of tiles
+    auto find_row_span = [&](int ty, int* out_tx0, int* out_tx1)
+    {
+        *out_tx0 = tile_x1 + 1;
+        *out_tx1 = -1;
+        for (int tx = tile_x0; tx <= tile_x1; tx++)
+            if (_DamageTiles[ty * _DamageTilesColumns + tx] != _DamageTilesQueued[ty * _DamageTilesColumns + tx])
+            {
+                *out_tx0 = ImMin(*out_tx0, tx);
+                *out_tx1 = tx;
+            }
+        return *out_tx1 >= 0;
+    };
+
+    bool frame_initialized = false;
+    bool changed = false;
+    for (int ty = tile_y0; ty <= tile_y1; )
+    {
+        int tx0, tx1;
+        if (!find_row_span(ty, &tx0, &tx1))
+        {
+            ty++;
+            continue;
+        }
+        int ty_end = ty + 1;
+        for (int next_tx0, next_tx1; ty_end <= tile_y1 && find_row_span(ty_end, &next_tx0, &next_tx1) && next_tx0 == tx0 && next_tx1 == tx1; )
+            ty_end++;
+
+        // Region in capture rect coordinates
+        const int rx0 = ImMax(tx0 * IMGUI_CAPTURE_DAMAGE_TILE_SIZE - x1, 0);
+        const int ry0 = ImMax(ty * IMGUI_CAPTURE_DAMAGE_TILE_SIZE - y1, 0);
+        const int rx1 = ImMin((tx1 + 1) * IMGUI_CAPTURE_DAMAGE_TILE_SIZE - x1, w);
+        const int ry1 = ImMin(ty_end * IMGUI_CAPTURE_DAMAGE_TILE_SIZE - y1, h);
+        const int rw = rx1 - rx0;
+        const int rh = ry1 - ry0;
+        ty = ty_end;
+        if (rw <= 0 || rh <= 0)
+            continue;
+
+        if (!frame_initialized)
+        {
+            memcpy(output->Data, _VideoWriter->LastQueuedFrame, (size_t)w * h * sizeof(unsigned int));
+            frame_initialized = true;
+        }
+        ImGuiCaptureImageBuf* region_buf = &_StitchTileBuf;
+        region_buf->CreateEmpty(rw, rh);
+        if (!ScreenCaptureFunc(viewport_id, x1 + rx0, y1 + ry0, rw, rh, region_buf->Data, ScreenCaptureUserData))
+            return false;
+        args->OutVideoPixelsCaptured += (ImU64)rw * rh;
+        for (int y = 0; y < rh; y++)
+        {
+            unsigned int* dst = &output->Data[(ry0 + y) * w + rx0];
+            const unsigned int* src = &region_buf->Data[y * rw];
+            if (memcmp(dst, src, (size_t)rw * sizeof(unsigned int)) != 0)
+            {
+                memcpy(dst, src, (size_t)rw * sizeof(unsigned int));
+                changed = true;
+            }
+        }
+    }
+    *out_changed = changed;
+    return true;
 }
 
 void ImGuiCaptureContext::RestoreBackedUpData()
@@ -234,6 +1587,7 @@ void ImGuiCaptureContext::ClearState()
     _MouseRelativeToWindowPos = ImVec2(-FLT_MAX, -FLT_MAX);
     _HoveredWindow = NULL;
     _CaptureArgs = NULL;
+    _VideoFinalizing = false;
 }
 
 // Returns true when capture is in progress.
@@ -253,7 +1607,7 @@ ImGuiCaptureStatus ImGuiCaptureContext::CaptureUpdate(ImGuiCaptureArgs* args)
         IM_ASSERT(args->InOutputFile[0] && "Output filename must be specified when recording videos.");
         IM_ASSERT(args->InOutputImageBuf == NULL && "Output buffer cannot be specified when recording videos.");
         IM_ASSERT((args->InFlags & ImGuiCaptureFlags_StitchAll) == 0 && "Image stitching is not supported when recording videos.");
-        if (!ImFileExist(VideoCaptureEncoderPath))
+        if (!CanEncodeVideo(args->InOutputFile))
         {
             fprintf(stderr, "Video encoder not found at \"%s\", video capturing failed.\n", VideoCaptureEncoderPath);
             return ImGuiCaptureStatus_Error;
@@ -459,79 +1813,135 @@ ImGuiCaptureStatus ImGuiCaptureContext::CaptureUpdate(ImGuiCaptureArgs* args)
     }
 
     //-----------------------------------------------------------------
-    // Frame 4+N*4: Capture a frame
+    // Frame 4+N: Capture a frame
     //-----------------------------------------------------------------
+    // When stitching, capture rect is split in tiles of viewport size, captured left to right then top to bottom.
+    // Windows are moved to expose next tile right after capturing a tile, so each tile takes a single frame.
 
     const ImRect clip_rect = viewport_rect;
-    ImRect capture_rect = _CaptureRect;
-    capture_rect.ClipWith(clip_rect);
-    const int capture_height = ImMin((int)io.DisplaySize.y, (int)_CaptureRect.GetHeight());
-    const int x1 = (int)(capture_rect.Min.x - clip_rect.Min.x);
-    const int y1 = (int)(capture_rect.Min.y - clip_rect.Min.y);
-    const int w = (int)capture_rect.GetWidth();
-    const int h = (int)ImMin(output->Height - _ChunkNo * capture_height, capture_height);
-
-    // Position windows
-    if ((_FrameNo > 2) && (args->InFlags & ImGuiCaptureFlags_StitchAll))
-    {
-        // Unlike SetNextWindowPos(), SetWindowPos() will still perform viewport clamping, affecting support for io.ConfigWindowsMoveFromTitleBarOnly.
-        IM_ASSERT(args->InCaptureWindows.Size == _WindowsData.Size);
-        for (int n = 0; n < _WindowsData.Size; n++)
-            ImGui::SetWindowPos(_WindowsData[n].Window, _WindowsData[n].PosDuringCapture - ImVec2(0, (float)capture_height * _ChunkNo));
-    }
+    const bool is_stitching = (args->InFlags & ImGuiCaptureFlags_StitchAll) != 0;
+    const int tile_w = ImMax(ImMin((int)clip_rect.GetWidth(), output->Width), 1);
+    const int tile_h = ImMax(ImMin((int)clip_rect.GetHeight(), output->Height), 1);
+    const int tiles_columns = is_stitching ? ImMax((output->Width + tile_w - 1) / tile_w, 1) : 1;
+    const int tiles_count = is_stitching ? tiles_columns * ((output->Height + tile_h - 1) / tile_h) : 1;
 
-    if (((_FrameNo > 2) && (_FrameNo % 4) == 0) || (is_recording_video && _FrameNo > 2) || instant_capture)
+    if ((_FrameNo >= 4) || (is_recording_video && _FrameNo > 2) || instant_capture)
     {
-        // FIXME: Implement capture of regions wider than viewport.
-        // Capture a portion of image. Capturing of windows wider than viewport is not implemented yet.
-        if (h > 0)
+        const int tile_x = is_stitching ? (_ChunkNo % tiles_columns) * tile_w : 0;
+        const int tile_y = is_stitching ? (_ChunkNo / tiles_columns) * tile_h : 0;
+        ImRect capture_rect = _CaptureRect;
+        capture_rect.Translate(ImVec2(-(float)tile_x, -(float)tile_y));
+        capture_rect.ClipWith(clip_rect);
+        const int x1 = (int)(capture_rect.Min.x - clip_rect.Min.x);
+        const int y1 = (int)(capture_rect.Min.y - clip_rect.Min.y);
+        const int w = (int)capture_rect.GetWidth();
+        const int h = (int)capture_rect.GetHeight();
+        if (w <= 0 || h <= 0)
         {
-            IM_ASSERT(w == output->Width);
-            if (args->InFlags & ImGuiCaptureFlags_StitchAll)
-                IM_ASSERT(h <= output->Height);     // When stitching, image can be taller than captured viewport.
-            else
-                IM_ASSERT(h == output->Height);
+            fprintf(stderr, "Capture rect is outside of viewport, nothing to capture.\n");
+            RestoreBackedUpData();
+            ClearState();
+            return ImGuiCaptureStatus_Error;
+        }
 
-            ImGuiID viewport_id = 0;
+        if (is_stitching)
+            IM_ASSERT(w == ImMin(tile_w, output->Width - tile_x) && h == ImMin(tile_h, output->Height - tile_y));
+        else
+            IM_ASSERT(w == output->Width && h == output->Height);
+
+        ImGuiID viewport_id = 0;
 #ifdef IMGUI_HAS_VIEWPORT
-            if (args->InFlags & ImGuiCaptureFlags_StitchAll)
-                viewport_id = _WindowsData[0].Window->ViewportId;
-            else
-                viewport_id = ImGui::GetMainViewport()->ID;
+        if (is_stitching)
+            viewport_id = _WindowsData[0].Window->ViewportId;
+        else
+            viewport_id = ImGui::GetMainViewport()->ID;
 #endif
 
-            //printf("ScreenCaptureFunc x1: %d, y1: %d, w: %d, h: %d\n", x1, y1, w, h);
-            if (!ScreenCaptureFunc(viewport_id, x1, y1, w, h, &output->Data[_ChunkNo * w * capture_height], ScreenCaptureUserData))
+        // Capture directly into output when tile spans whole output width, otherwise copy rows of tile.
+        ImGuiCaptureImageBuf* tile_buf = output;
+        if (w != output->Width)
+        {
+            tile_buf = &_StitchTileBuf;
+            tile_buf->CreateEmpty(w, h);
+        }
+        unsigned int* tile_pixels = (tile_buf == output) ? &output->Data[tile_y * output->Width] : tile_buf->Data;
+
+        // When recording video, read back only regions which changed since last queued frame if draw data of this frame was hashed.
+        const bool is_saving_video = is_recording_video && (args->InFlags & ImGuiCaptureFlags_NoSave) == 0;
+        const bool use_damage_tracking = is_saving_video && VideoDamageTracking && _VideoWriter != NULL && _VideoWriter->LastQueuedFrame != NULL
+            && _DamageFrameCount == g.FrameCount && !_DamageTilesQueued.empty() && _DamageTilesQueued.Size == _DamageTiles.Size && tile_buf == output;
+        bool frame_changed = true;
+        bool capture_ok;
+        //printf("ScreenCaptureFunc x1: %d, y1: %d, w: %d, h: %d\n", x1, y1, w, h);
+        if (use_damage_tracking)
+        {
+            capture_ok = _CaptureDamagedRegions(args, viewport_id, x1, y1, output, &frame_changed);
+            if (capture_ok && VideoDamageTrackingCheck)
             {
-                fprintf(stderr, "Screen capture function failed.\n");
-                RestoreBackedUpData();
-                ClearState();
-                return ImGuiCaptureStatus_Error;
+                // Unchanged frame was not written to output: it is last queued frame.
+                const size_t frame_size = (size_t)output->Width * output->Height * sizeof(unsigned int);
+                ImGuiCaptureImageBuf* full_buf = &_StitchTileBuf;
+                full_buf->CreateEmpty(output->Width, output->Height);
+                capture_ok = ScreenCaptureFunc(viewport_id, x1, y1, output->Width, output->Height, full_buf->Data, ScreenCaptureUserData);
+                args->OutVideoDamageFramesChecked++;
+                if (capture_ok && memcmp(frame_changed ? output->Data : _VideoWriter->LastQueuedFrame, full_buf->Data, frame_size) != 0)
+                {
+                    args->OutVideoDamageFramesMismatched++;
+                    memcpy(output->Data, full_buf->Data, frame_size);
+                    frame_changed = true;
+                }
             }
+        }
+        else
+        {
+            capture_ok = ScreenCaptureFunc(viewport_id, x1, y1, w, h, tile_pixels, ScreenCaptureUserData);
+            if (is_saving_video)
+                args->OutVideoPixelsCaptured += (ImU64)w * h;
+        }
+        if (!capture_ok)
+        {
+            fprintf(stderr, "Screen capture function failed.\n");
+            RestoreBackedUpData();
+            ClearState();
+            return ImGuiCaptureStatus_Error;
+        }
+        if (tile_buf != output)
+            for (int y = 0; y < h; y++)
+                memcpy(&output->Data[(tile_y + y) * output->Width + tile_x], &tile_buf->Data[y * w], (size_t)w * sizeof(unsigned int));
 
-            if (args->InFlags & ImGuiCaptureFlags_StitchAll)
-            {
-                // Window moves up in order to expose it's lower part.
-                _ChunkNo++;
-                _CaptureRect.TranslateY(-(float)h);
-            }
+        _ChunkNo++;
 
-            if (is_recording_video && (args->InFlags & ImGuiCaptureFlags_NoSave) == 0)
+        if (is_saving_video)
+        {
+            // _VideoWriter is NULL when recording just started. Initialize recording state.
+            if (_VideoWriter == NULL)
             {
-                // _VideoEncoderPipe is NULL when recording just started. Initialize recording state.
-                if (_VideoEncoderPipe == NULL)
+                // First video frame, initialize now that dimensions are known.
+                const unsigned int width = (unsigned int)capture_rect.GetWidth();
+                const unsigned int height = (unsigned int)capture_rect.GetHeight();
+                const char* extension = (char*)ImPathFindExtension(args->InOutputFile);
+                ImFileCreateDirectoryChain(args->InOutputFile, ImPathFindFilename(args->InOutputFile));
+                FILE* pipe = NULL;
+                ImGuiCaptureGifEncoder* gif_encoder = NULL;
+                if (GifUseBuiltinEncoder && strcmp(extension, ".gif") == 0)
+                {
+                    gif_encoder = ImGuiCaptureGifEncoder_Create(args->InOutputFile, output->Width, output->Height, args->InRecordFPSTarget, GifEncodeThreadsCount);
+                    if (gif_encoder == NULL)
+                    {
+                        fprintf(stderr, "Unable to create \"%s\", video capturing failed.\n", args->InOutputFile);
+                        RestoreBackedUpData();
+                        ClearState();
+                        return ImGuiCaptureStatus_Error;
+                    }
+                }
+                else
                 {
-                    // First video frame, initialize now that dimensions are known.
-                    const unsigned int width = (unsigned int)capture_rect.GetWidth();
-                    const unsigned int height = (unsigned int)capture_rect.GetHeight();
                     IM_ASSERT(VideoCaptureEncoderPath != NULL && VideoCaptureEncoderPath[0]);
                     Str256f encoder_exe(VideoCaptureEncoderPath), cmd("");
                     ImPathFixSeparatorsForCurrentOS(encoder_exe.c_str());
-                    ImFileCreateDirectoryChain(args->InOutputFile, ImPathFindFilename(args->InOutputFile));
 #if _WIN32
                     cmd.append("\"");   // On windows, entire command wrapped in quotes allows use of quotes for parameters.
 #endif
-                    const char* extension = (char*)ImPathFindExtension(args->InOutputFile);
                     if (strcmp(extension, ".gif") == 0)
                     {
                         IM_ASSERT(GifCaptureEncoderParams != NULL && GifCaptureEncoderParams[0]);
@@ -550,34 +1960,69 @@ ImGuiCaptureStatus ImGuiCaptureContext::CaptureUpdate(ImGuiCaptureArgs* args)
                     ImStrReplace(&cmd, "$HEIGHT", Str16f("%d", height).c_str());
                     ImStrReplace(&cmd, "$OUTPUT", args->InOutputFile);
                     fprintf(stdout, "# %s\n", cmd.c_str());
-                    _VideoEncoderPipe = ImOsPOpen(cmd.c_str(), "w");
-                    IM_ASSERT(_VideoEncoderPipe != NULL);
+                    pipe = ImOsPOpen(cmd.c_str(), "w");
+                    IM_ASSERT(pipe != NULL);
                 }
-
-                // Save new video frame
-                fwrite(output->Data, 1, output->Width * output->Height * 4, _VideoEncoderPipe);
+                _VideoWriter = IM_NEW(ImGuiCaptureVideoWriter)();
+                _VideoWriter->Pipe = pipe;
+                _VideoWriter->GifEncoder = gif_encoder;
+                _VideoWriter->Width = output->Width;
+                _VideoWriter->Height = output->Height;
+                _VideoWriter->Thread = std::thread(ImGuiCaptureVideoWriterThreadMain, _VideoWriter);
             }
-            if (is_recording_video)
-                _VideoLastFrameTime = current_time_sec;
+
+            // Queue new video frame. Tile hashes of queued frame become reference for next frame, unless frame was dropped.
+            const bool queued = ImGuiCaptureVideoWriter_PushFrame(_VideoWriter, output, VideoFrameQueueSize, use_damage_tracking ? (frame_changed ? 1 : 0) : -1);
+            if (queued && VideoDamageTracking && _DamageFrameCount == g.FrameCount)
+                _DamageTilesQueued.swap(_DamageTiles);
+            else if (queued)
+                _DamageTilesQueued.clear();
         }
+        if (is_recording_video)
+            _VideoLastFrameTime = current_time_sec;
 
-        // Image is finalized immediately when we are not stitching. Otherwise, image is finalized when we have captured and stitched all frames.
-        if (!_VideoRecording && (!(args->InFlags & ImGuiCaptureFlags_StitchAll) || h <= 0))
+        // Image is finalized immediately when we are not stitching. Otherwise, image is finalized when we have captured and stitched all tiles.
+        if (!_VideoRecording && _ChunkNo >= tiles_count)
         {
             output->RemoveAlpha();
 
-            if (_VideoEncoderPipe != NULL)
+            if (_VideoFinalizing)
             {
-                // At this point _Recording is false, but we know we were recording because _VideoEncoderPipe is not NULL. Finalize video here.
-                ImOsPClose(_VideoEncoderPipe);
-                _VideoEncoderPipe = NULL;
+                // Finalize video (writer is NULL when recording with ImGuiCaptureFlags_NoSave).
+                // Remaining frames are written and encoder is closed in background. FlushPendingImages() waits for completion.
+                ImGuiCaptureVideoWriter* writer = _VideoWriter;
+                if (writer == NULL || writer->ExitRequested)
+                {
+                    output->Clear();
+                }
+                else
+                {
+                    args->OutVideoFramesCount = writer->FramesCount;
+                    args->OutVideoFramesRepeated = writer->FramesRepeated;
+                    args->OutVideoFramesDropped = writer->FramesDropped;
+                    const ImU64 frames_pixels = (ImU64)writer->FramesCount * writer->Width * writer->Height;
+                    fprintf(stdout, "# Video: %d frames, %d repeated, %d dropped (encoder too slow), %.1f%% pixels read back\n", writer->FramesCount, writer->FramesRepeated, writer->FramesDropped, frames_pixels ? (double)args->OutVideoPixelsCaptured * 100.0 / (double)frames_pixels : 0.0);
+                    if (args->OutVideoDamageFramesChecked > 0)
+                        fprintf(stdout, "# Video damage tracking check: %d frames checked, %d mismatched\n", args->OutVideoDamageFramesChecked, args->OutVideoDamageFramesMismatched);
+                    {
+                        std::unique_lock<std::mutex> lock(writer->Mutex);
+                        writer->ExitRequested = true;
+                    }
+                    writer->CondPending.notify_one();
+                }
             }
             else if (args->InOutputImageBuf == NULL)
             {
-                // Save single frame.
+                // Save single frame. With encoding threads, pixels are moved to encode queue and
+                // output buffer receives a recycled buffer instead of being freed.
                 if ((args->InFlags & ImGuiCaptureFlags_NoSave) == 0)
-                    output->SaveFile(args->InOutputFile);
-                output->Clear();
+                {
+                    const int png_compression_level = (args->InPngCompressionLevel > 0) ? args->InPngCompressionLevel : PngCompressionLevel;
+                    const ImGuiCapturePngFilter png_filter = (args->InPngFilter != ImGuiCapturePngFilter_Default) ? args->InPngFilter : PngFilter;
+                    _SaveImage(output, args->InOutputFile, png_compression_level, png_filter);
+                }
+                else
+                    output->Clear();
             }
 
             RestoreBackedUpData();
@@ -586,6 +2031,16 @@ ImGuiCaptureStatus ImGuiCaptureContext::CaptureUpdate(ImGuiCaptureArgs* args)
         }
     }
 
+    // Position windows to expose tile captured on next frame.
+    // Unlike SetNextWindowPos(), SetWindowPos() will still perform viewport clamping, affecting support for io.ConfigWindowsMoveFromTitleBarOnly.
+    if (_FrameNo > 2 && is_stitching)
+    {
+        const ImVec2 tile_pos((float)((_ChunkNo % tiles_columns) * tile_w), (float)((_ChunkNo / tiles_columns) * tile_h));
+        IM_ASSERT(args->InCaptureWindows.Size == _WindowsData.Size);
+        for (int n = 0; n < _WindowsData.Size; n++)
+            ImGui::SetWindowPos(_WindowsData[n].Window, _WindowsData[n].PosDuringCapture - tile_pos);
+    }
+
     // Keep going
     _FrameNo++;
     return ImGuiCaptureStatus_InProgress;
@@ -599,9 +2054,21 @@ void ImGuiCaptureContext::BeginVideoCapture(ImGuiCaptureArgs* args)
 {
     IM_ASSERT(args != NULL);
     IM_ASSERT(_VideoRecording == false);
-    IM_ASSERT(_VideoEncoderPipe == NULL);
     IM_ASSERT(args->InRecordFPSTarget >= 1 && args->InRecordFPSTarget <= 100);
 
+    // Finish writing previous video
+    if (_VideoWriter != NULL)
+    {
+        ImGuiCaptureVideoWriter_Destroy(_VideoWriter);
+        _VideoWriter = NULL;
+    }
+    _VideoFinalizing = false;
+    args->OutVideoFramesCount = args->OutVideoFramesRepeated = args->OutVideoFramesDropped = 0;
+    args->OutVideoPixelsCaptured = 0;
+    args->OutVideoDamageFramesChecked = args->OutVideoDamageFramesMismatched = 0;
+    _DamageTilesQueued.clear();
+    _DamageFrameCount = -1;
+
     ImFileCreateDirectoryChain(args->InOutputFile, ImPathFindFilename(args->InOutputFile));
     _VideoRecording = true;
     _CaptureArgs = args;
@@ -613,6 +2080,7 @@ void ImGuiCaptureContext::EndVideoCapture()
     IM_ASSERT(_VideoRecording == true);
 
     _VideoRecording = false;
+    _VideoFinalizing = true;
 }
 
 bool ImGuiCaptureContext::IsCapturingVideo()
@@ -625,6 +2093,13 @@ bool ImGuiCaptureContext::IsCapturing()
     return _CaptureArgs != NULL;
 }
 
+bool ImGuiCaptureContext::CanEncodeVideo(const char* output_file)
+{
+    if (GifUseBuiltinEncoder && strcmp(ImPathFindExtension(output_file), ".gif") == 0)
+        return true;
+    return VideoCaptureEncoderPath != NULL && ImFileExist(VideoCaptureEncoderPath);
+}
+
 //-----------------------------------------------------------------------------
 // ImGuiCaptureToolUI
 //-----------------------------------------------------------------------------
@@ -1025,7 +2500,7 @@ bool ImGuiCaptureToolUI::_ShowEncoderConfigFields(ImGuiCaptureContext* context)
         const bool encoder_exe_missing = !ImFileExist(context->VideoCaptureEncoderPath);
         if (encoder_exe_missing)
             ImGui::ItemErrorFrame(IM_COL32(255, 0, 0, 255));
-        ImGui::SetItemTooltip("Absolute or relative path to video encoder executable (e.g. \"path/to/ffmpeg.exe\"). Required for video recording.%s", encoder_exe_missing ? "\nFile does not exist!" : "");
+        ImGui::SetItemTooltip("Absolute or relative path to video encoder executable (e.g. \"path/to/ffmpeg.exe\"). Required for video recording%s.%s", context->GifUseBuiltinEncoder ? " (except .gif)" : "", encoder_exe_missing ? "\nFile does not exist!" : "");
     }
 
     struct CmdLineParamsInfo
@@ -12,11 +12,16 @@
 
 // Our types
 struct ImGuiCaptureArgs;                // Parameters for Capture
+struct ImGuiCaptureContentStoreStats;   // Statistics of content-addressed image store
 struct ImGuiCaptureContext;             // State of an active capture tool
+struct ImGuiCaptureEncodeQueue;         // Background image encoding threads (defined in imgui_capture_tool.cpp, uses std::thread)
+struct ImGuiCaptureGifEncoder;          // Builtin .gif video encoder (defined in imgui_capture_tool.cpp, uses std::thread)
 struct ImGuiCaptureImageBuf;            // Simple helper to store an RGBA image in memory
 struct ImGuiCaptureToolUI;              // Capture tool instance + UI window
+struct ImGuiCaptureVideoWriter;         // Background thread writing video frames to encoder (defined in imgui_capture_tool.cpp, uses std::thread)
 
 typedef unsigned int ImGuiCaptureFlags; // See enum: ImGuiCaptureFlags_
+typedef int ImGuiCapturePngFilter;      // See enum: ImGuiCapturePngFilter_
 
 // Capture function which needs to be provided by user application
 typedef bool (ImGuiScreenCaptureFunc)(ImGuiID viewport_id, int x, int y, int w, int h, unsigned int* pixels, void* user_data);
@@ -26,27 +31,48 @@ struct ImGuiWindow; // imgui.h
 
 //-----------------------------------------------------------------------------
 
+// PNG filter applied to each row before compression.
+// Adaptive filtering tries all filters on each row and typically produces smallest files, but is the slowest.
+// A fixed filter (e.g. Up or Sub) is much faster and works well on UI screenshots.
+enum ImGuiCapturePngFilter_
+{
+    ImGuiCapturePngFilter_Default               = -2,       // Use ImGuiCaptureContext::PngFilter (only valid in ImGuiCaptureArgs)
+    ImGuiCapturePngFilter_Adaptive              = -1,       // Pick best filter for each row (stb_image_write default)
+    ImGuiCapturePngFilter_None                  = 0,
+    ImGuiCapturePngFilter_Sub                   = 1,
+    ImGuiCapturePngFilter_Up                    = 2,
+    ImGuiCapturePngFilter_Average               = 3,
+    ImGuiCapturePngFilter_Paeth                 = 4,
+};
+
 // [Internal]
 // Helper class for simple bitmap manipulation (not particularly efficient!)
+// Image file format is selected by file extension:
+// - ".png": smallest files, slowest to encode. Speed/size trade-off is set by PNG compression level and filter.
+// - ".tga": RLE compressed, lossless. Much faster to encode than PNG, files are larger.
+// - ".bmp": uncompressed. Fastest to encode, largest files.
 struct IMGUI_API ImGuiCaptureImageBuf
 {
     int             Width;
     int             Height;
     unsigned int*   Data;       // RGBA8
+    int             Capacity;   // Number of pixels allocated. May be more than Width*Height when buffer is reused.
 
-    ImGuiCaptureImageBuf()      { Width = Height = 0; Data = NULL; }
+    ImGuiCaptureImageBuf()      { Width = Height = Capacity = 0; Data = NULL; }
     ~ImGuiCaptureImageBuf()     { Clear(); }
 
     void Clear();                                           // Free allocated memory buffer if such exists.
-    void CreateEmpty(int w, int h);                         // Reallocate buffer for pixel data and zero it.
-    bool SaveFile(const char* filename);                    // Save pixel data to specified image file.
+    void CreateEmpty(int w, int h);                         // Reallocate buffer for pixel data (unless existing one is large enough) and zero it.
+    bool SaveFile(const char* filename, int png_compression_level = 8, ImGuiCapturePngFilter png_filter = ImGuiCapturePngFilter_Adaptive); // Save pixel data to specified image file. Format is selected by file extension.
     void RemoveAlpha();                                     // Clear alpha channel from all pixels.
+    bool LoadFile(const char* filename);                    // Load pixel data from a .tga file (e.g. reference image saved with SaveFile()).
+    int  Compare(const ImGuiCaptureImageBuf* other, int tolerance, int* out_max_diff = NULL, ImGuiCaptureImageBuf* out_diff = NULL) const; // Return number of pixels with a channel differing by more than 'tolerance' (0..255), -1 if sizes differ. Optionally output a diff image.
 };
 
 enum ImGuiCaptureFlags_ : unsigned int
 {
     ImGuiCaptureFlags_None                      = 0,
-    ImGuiCaptureFlags_StitchAll                 = 1 << 0,   // Capture entire window scroll area (by scrolling and taking multiple screenshot). Only works for a single window.
+    ImGuiCaptureFlags_StitchAll                 = 1 << 0,   // Capture entire window scroll area (by moving window and taking multiple screenshots, one per frame). Window may be larger than viewport in both directions. Only works for a single window.
     ImGuiCaptureFlags_IncludeOtherWindows       = 1 << 1,   // Disable hiding other windows (when CaptureAddWindow has been called by default other windows are hidden)
     ImGuiCaptureFlags_IncludeTooltipsAndPopups  = 1 << 2,   // Expand capture area to automatically include visible popups and tooltips (use with ImGuiCaptureflags_HideOtherWindows)
     ImGuiCaptureFlags_HideMouseCursor           = 1 << 3,   // Hide render software mouse cursor during capture.
@@ -54,6 +80,14 @@ enum ImGuiCaptureFlags_ : unsigned int
     ImGuiCaptureFlags_NoSave                    = 1 << 5    // Do not save output image.
 };
 
+// [Internal]
+// Builtin .gif encoder, used by ImGuiCaptureContext when GifUseBuiltinEncoder is set. Exposed for tests and benchmarks.
+// Frames are RGBA8 images of width*height pixels. AddFrame(): 'pixels' == NULL repeats previous frame, 'prev_pixels' is
+// previous frame or NULL for first frame. Destroy() writes remaining frames and closes the file.
+IMGUI_API ImGuiCaptureGifEncoder*   ImGuiCaptureGifEncoder_Create(const char* filename, int width, int height, int fps, int threads_count);
+IMGUI_API void                      ImGuiCaptureGifEncoder_AddFrame(ImGuiCaptureGifEncoder* encoder, const unsigned int* pixels, const unsigned int* prev_pixels);
+IMGUI_API void                      ImGuiCaptureGifEncoder_Destroy(ImGuiCaptureGifEncoder* encoder);
+
 // Defines input and output arguments for capture process.
 // When capturing from tests you can usually use the ImGuiTestContext::CaptureXXX() helpers functions.
 struct ImGuiCaptureArgs
@@ -67,9 +101,34 @@ struct ImGuiCaptureArgs
     ImGuiCaptureImageBuf*   InOutputImageBuf = NULL;        // _OR_ Output will be saved to image buffer if specified.
     int                     InRecordFPSTarget = 30;         // FPS target for recording videos.
     int                     InSizeAlign = 0;                // Resolution alignment (0 = auto, 1 = no alignment, >= 2 = align width/height to be multiple of given value)
+    int                     InPngCompressionLevel = 0;      // PNG compression level (>= 5, higher is smaller and slower). 0 = use ImGuiCaptureContext::PngCompressionLevel.
+    ImGuiCapturePngFilter   InPngFilter = ImGuiCapturePngFilter_Default; // PNG filter. Default = use ImGuiCaptureContext::PngFilter.
 
     // [Output]
     ImVec2                  OutImageSize;                   // Produced image size.
+    int                     OutVideoFramesCount = 0;        // Video frames sent to encoder.
+    int                     OutVideoFramesRepeated = 0;     // Video frames identical to previous one, sent to encoder without copying pixels.
+    int                     OutVideoFramesDropped = 0;      // Video frames replaced by previous one because encoder was falling behind (see ImGuiCaptureContext::VideoFrameQueueSize).
+    ImU64                   OutVideoPixelsCaptured = 0;     // Pixels read back from framebuffer while recording video. Lower than frames * image size when damage tracking skips unchanged regions.
+    int                     OutVideoDamageFramesChecked = 0;    // Video frames recorded with damage tracking and compared to a full readback (see ImGuiCaptureContext::VideoDamageTrackingCheck).
+    int                     OutVideoDamageFramesMismatched = 0; // Checked frames which differed from full readback.
+};
+
+// Content-addressed image store (see ImGuiCaptureContext::ContentStorePath)
+// Saved images are keyed by a hash of their pixels. An image already in store is not encoded nor written again:
+// output file is a hard link to stored file (or a copy when hard links are not supported).
+struct ImGuiCaptureContentStoreStats
+{
+    int                     ImagesStored = 0;               // Images encoded and added to store.
+    int                     ImagesReused = 0;               // Images found in store, not encoded.
+    ImU64                   BytesStored = 0;                // Size of files added to store.
+    ImU64                   BytesReused = 0;                // Size of files found in store: disk writes avoided (unless copied because hard link failed).
+    ImU64                   PixelsStored = 0;
+    ImU64                   PixelsReused = 0;
+    double                  EncodeTimeStored = 0.0;         // Seconds spent encoding stored images.
+
+    // Encoding time avoided, extrapolated from average encoding speed of images stored by this session.
+    double                  GetEncodeTimeSavedEstimate() const { return (PixelsStored > 0) ? EncodeTimeStored * (double)PixelsReused / (double)PixelsStored : 0.0; }
 };
 
 enum ImGuiCaptureStatus
@@ -98,6 +157,16 @@ struct IMGUI_API ImGuiCaptureContext
     int                     VideoCaptureEncoderParamsSize = 0;  // Optional. Set in order to edit this parameter from UI.
     char*                   GifCaptureEncoderParams = NULL;     // Video encoder params for GIF output (not owned, stored externally).
     int                     GifCaptureEncoderParamsSize = 0;    // Optional. Set in order to edit this parameter from UI.
+    int                     EncodeThreadsCount = 2;             // Number of background threads encoding and saving images. 0 to save images on the capturing thread.
+    int                     EncodeQueueSize = 4;                // Max number of images waiting to be saved. Capture waits for a free slot when queue is full.
+    int                     VideoFrameQueueSize = 8;            // Max number of video frames waiting for video encoder. When full, new frames are dropped (previous frame is repeated) instead of stalling the application.
+    bool                    GifUseBuiltinEncoder = true;        // Encode .gif videos in-process (no video encoder executable needed). When false, .gif videos are encoded by VideoCaptureEncoderPath using GifCaptureEncoderParams.
+    int                     GifEncodeThreadsCount = 4;          // Number of background threads compressing .gif frames with builtin encoder. 0 to compress on video writer thread.
+    bool                    VideoDamageTracking = false;        // When recording video, only read back regions which changed according to draw data (requires PostRender() to be called). Only enable if captured area has no contents not drawn by Dear ImGui (e.g. 3D scene) nor textures updated in place: backend can't tell.
+    bool                    VideoDamageTrackingCheck = false;   // Debug: also read back whole video frames recorded with damage tracking and compare. Mismatching frames are replaced by full readback and counted in ImGuiCaptureArgs::OutVideoDamageFramesMismatched.
+    int                     PngCompressionLevel = 8;            // Default PNG compression level (>= 5, higher is smaller and slower). May be overridden by ImGuiCaptureArgs.
+    ImGuiCapturePngFilter   PngFilter = ImGuiCapturePngFilter_Adaptive; // Default PNG filter. May be overridden by ImGuiCaptureArgs.
+    char*                   ContentStorePath = NULL;            // Content-addressed image store directory (not owned, stored externally). NULL or empty to disable. See ImGuiCaptureContentStoreStats.
 
     // [Internal]
     ImRect                  _CaptureRect;                   // Viewport rect that is being captured.
@@ -107,13 +176,26 @@ struct IMGUI_API ImGuiCaptureContext
     ImVec2                  _MouseRelativeToWindowPos;      // Mouse cursor position relative to captured window (when _StitchAll is in use).
     ImGuiWindow*            _HoveredWindow = NULL;          // Window which was hovered at capture start.
     ImGuiCaptureImageBuf    _CaptureBuf;                    // Output image buffer.
+    ImGuiCaptureImageBuf    _StitchTileBuf;                 // Tile captured before being copied into output, when stitching an image wider than viewport or reading back changed regions of a video frame.
     const ImGuiCaptureArgs* _CaptureArgs = NULL;            // Current capture args. Set only if capture is in progress.
     ImVector<ImGuiCaptureWindowData> _WindowsData;          // Backup windows that will have their rect modified and restored. args->InCaptureWindows can not be used because popups may get closed during capture and no longer appear in that list.
 
     // [Internal] Video recording
     bool                    _VideoRecording = false;        // Flag indicating that video recording is in progress.
+    bool                    _VideoFinalizing = false;       // Set by EndVideoCapture(): last frame is recorded and video is closed by next CaptureUpdate().
     double                  _VideoLastFrameTime = 0;        // Time when last video frame was recorded.
-    FILE*                   _VideoEncoderPipe = NULL;       // File writing to stdin of video encoder process.
+    ImGuiCaptureVideoWriter* _VideoWriter = NULL;           // Writes frames to stdin of video encoder process from a background thread.
+
+    // [Internal] Video damage tracking
+    ImVector<ImU32>         _DamageTiles;                   // Hash of draw data primitives overlapping each tile of main viewport, for frame _DamageFrameCount.
+    ImVector<ImU32>         _DamageTilesQueued;             // Same, for last frame queued to video writer. Empty when unknown.
+    int                     _DamageTilesColumns = 0;
+    int                     _DamageTilesRows = 0;
+    int                     _DamageFrameCount = -1;         // Frame count when _DamageTiles was computed.
+
+    // [Internal] Image encoding
+    ImGuiCaptureEncodeQueue* _EncodeQueue = NULL;           // Created on first save with EncodeThreadsCount > 0.
+    ImGuiCaptureContentStoreStats _ContentStoreStats;       // Updated by encoding threads, use GetContentStoreStats().
 
     // [Internal] Backups
     bool                    _BackupMouseDrawCursor = false; // Initial value of g.IO.MouseDrawCursor
@@ -125,6 +207,7 @@ struct IMGUI_API ImGuiCaptureContext
     //-------------------------------------------------------------------------
 
     ImGuiCaptureContext(ImGuiScreenCaptureFunc capture_func = NULL) { ScreenCaptureFunc = capture_func; _MouseRelativeToWindowPos = ImVec2(-FLT_MAX, -FLT_MAX); }
+    ~ImGuiCaptureContext();                                 // Saves pending images and video, stops encoding threads.
 
     // These functions should be called from appropriate context hooks. See ImGui::AddContextHook() for more info.
     // (ImGuiTestEngine automatically calls that for you, so this only apply to independently created instance)
@@ -142,6 +225,16 @@ struct IMGUI_API ImGuiCaptureContext
     void                    EndVideoCapture();
     bool                    IsCapturingVideo();
     bool                    IsCapturing();
+    bool                    CanEncodeVideo(const char* output_file);                // Check if a video encoder is available for this file extension.
+
+    // Images and videos are saved asynchronously (see EncodeThreadsCount, VideoFrameQueueSize). Call before reading back a saved file.
+    void                    FlushPendingImages();                                   // Wait until all queued images are saved and last recorded video is finalized. A video ended by EndVideoCapture() is only finalized after next CaptureUpdate().
+    int                     GetPendingImagesCount();
+    ImGuiCaptureContentStoreStats GetContentStoreStats();                           // Call FlushPendingImages() first to include all saved images.
+
+    // [Internal]
+    bool                    _SaveImage(ImGuiCaptureImageBuf* image, const char* filename, int png_compression_level, ImGuiCapturePngFilter png_filter); // Pixels are moved out of 'image' when saving asynchronously.
+    bool                    _CaptureDamagedRegions(ImGuiCaptureArgs* args, ImGuiID viewport_id, int x1, int y1, ImGuiCaptureImageBuf* output, bool* out_changed); // Video: read back regions changed since last queued frame.
 };
 
 //-----------------------------------------------------------------------------
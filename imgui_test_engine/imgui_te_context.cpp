@@ -204,7 +204,7 @@ void    ImGuiTestContext::LogToTTY(ImGuiTestVerboseLevel level, const char* mess
                 if (line_info.Level > EngineIO->ConfigVerboseLevelOnError)
                     continue;
                 char* line_begin = log->Buffer.Buf.Data + line_info.LineOffset;
-                char* line_end = strchr(line_begin, '\n');
+                char* line_end = line_begin + line_info.LineSize;
                 LogToTTY(line_info.Level, line_begin, line_end + 1);
             }
             // We already printed current line as well, so return now.
@@ -219,24 +219,7 @@ void    ImGuiTestContext::LogToTTY(ImGuiTestVerboseLevel level, const char* mess
         return;
     }
 
-    switch (level)
-    {
-    case ImGuiTestVerboseLevel_Warning:
-        ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_BrightYellow);
-        break;
-    case ImGuiTestVerboseLevel_Error:
-        ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_BrightRed);
-        break;
-    default:
-        ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
-        break;
-    }
-    if (message_end)
-        fprintf(stdout, "%.*s", (int)(message_end - message), message);
-    else
-        fprintf(stdout, "%s", message);
-    ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
-    fflush(stdout);
+    ImGuiTestEngine_LogOutputWrite(Engine, ImGuiTestLogOutput_TTY, level, message, message_end);
 }
 
 void        ImGuiTestContext::LogToDebugger(ImGuiTestVerboseLevel level, const char* message)
@@ -249,28 +232,7 @@ void        ImGuiTestContext::LogToDebugger(ImGuiTestVerboseLevel level, const c
     if (EngineIO->ConfigVerboseLevel < level)
         return;
 
-    switch (level)
-    {
-    default:
-        break;
-    case ImGuiTestVerboseLevel_Error:
-        ImOsOutputDebugString("[error] ");
-        break;
-    case ImGuiTestVerboseLevel_Warning:
-        ImOsOutputDebugString("[warn.] ");
-        break;
-    case ImGuiTestVerboseLevel_Info:
-        ImOsOutputDebugString("[info ] ");
-        break;
-    case ImGuiTestVerboseLevel_Debug:
-        ImOsOutputDebugString("[debug] ");
-        break;
-    case ImGuiTestVerboseLevel_Trace:
-        ImOsOutputDebugString("[trace] ");
-        break;
-    }
-
-    ImOsOutputDebugString(message);
+    ImGuiTestEngine_LogOutputWrite(Engine, ImGuiTestLogOutput_Debugger, level, message);
 }
 
 void    ImGuiTestContext::LogBasicUiState()
@@ -718,7 +680,7 @@ static bool ImGuiTestContext_CanCaptureScreenshot(ImGuiTestContext* ctx)
 static bool ImGuiTestContext_CanCaptureVideo(ImGuiTestContext* ctx)
 {
     ImGuiTestEngineIO* io = ctx->EngineIO;
-    return io->ConfigCaptureEnabled && ImFileExist(io->VideoCaptureEncoderPath);
+    return io->ConfigCaptureEnabled && ctx->Engine->CaptureContext.CanEncodeVideo(ctx->CaptureArgs->InOutputFile);
 }
 #endif
 
@@ -749,7 +711,7 @@ bool ImGuiTestContext::CaptureScreenshot(int capture_flags)
     args->InFlags = capture_flags;
 
     // Auto filename
-    CaptureInitAutoFilename(this, ".png");
+    CaptureInitAutoFilename(this, EngineIO->ImageCaptureExtension);
 
 #if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
     // Way capture tool is implemented doesn't prevent ClampWindowPos() from running,
@@ -809,6 +771,111 @@ void ImGuiTestContext::CaptureSetExtension(const char* ext)
     }
 }
 
+// Visual regression check.
+// - On mismatch, captured image and a diff image (differences highlighted) are saved in output/captures/ and the test fails.
+// - Missing reference fails the test too. With ImGuiTestEngineIO::ConfigCaptureUpdateReferences, captured image is saved
+//   as the new reference instead, when reference is missing or doesn't match.
+bool ImGuiTestContext::CaptureCheckReference(const char* reference_file, int tolerance, int capture_flags)
+{
+    if (IsError())
+        return false;
+
+    IMGUI_TEST_CONTEXT_REGISTER_DEPTH(this);
+    LogInfo("CaptureCheckReference('%s', tolerance: %d)", reference_file, tolerance);
+    IM_ASSERT(reference_file != NULL && ImStricmp(ImPathFindExtension(reference_file), ".tga") == 0 && "Reference images must be .tga files.");
+    IM_ASSERT(tolerance >= 0 && tolerance <= 255);
+
+#if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
+    if (!ImGuiTestContext_CanCaptureScreenshot(this))
+    {
+        LogWarning("Skipped checking reference '%s' (enable in 'Misc->Options')", reference_file);
+        return true;
+    }
+
+    // Capture to memory
+    ImGuiCaptureImageBuf captured;
+    ImGuiCaptureArgs* args = CaptureArgs;
+    args->InFlags = capture_flags;
+    args->InOutputImageBuf = &captured;
+    bool ret = ImGuiTestEngine_CaptureScreenshot(Engine, args);
+    args->InOutputImageBuf = NULL;
+    if (!ret || captured.Data == NULL)
+    {
+        IM_ERRORF_NOHDR("Unable to capture image to check against reference '%s'", reference_file);
+        return false;
+    }
+
+    if (!ImFileExist(reference_file))
+    {
+        if (!EngineIO->ConfigCaptureUpdateReferences)
+        {
+            IM_ERRORF_NOHDR("Reference '%s' not found. Enable ConfigCaptureUpdateReferences to save capture as new reference.", reference_file);
+            return false;
+        }
+        if (!captured.SaveFile(reference_file))
+        {
+            IM_ERRORF_NOHDR("Unable to save new reference '%s'", reference_file);
+            return false;
+        }
+        LogWarning("Reference '%s' not found: saved capture as new reference (%d*%d pixels)", reference_file, captured.Width, captured.Height);
+        return true;
+    }
+
+    ImGuiCaptureImageBuf reference;
+    if (!reference.LoadFile(reference_file))
+    {
+        IM_ERRORF_NOHDR("Unable to load reference '%s'", reference_file);
+        return false;
+    }
+
+    int max_diff = 0;
+    ImGuiCaptureImageBuf diff;
+    const int mismatch_count = captured.Compare(&reference, tolerance, &max_diff, &diff);
+    if (mismatch_count == 0)
+    {
+        LogDebug("Matches reference '%s' (%d*%d pixels, max difference %d)", reference_file, captured.Width, captured.Height, max_diff);
+        return true;
+    }
+    if (EngineIO->ConfigCaptureUpdateReferences)
+    {
+        if (!captured.SaveFile(reference_file))
+        {
+            IM_ERRORF_NOHDR("Unable to update reference '%s'", reference_file);
+            return false;
+        }
+        LogWarning("Capture doesn't match reference '%s': updated reference (%d*%d pixels)", reference_file, captured.Width, captured.Height);
+        return true;
+    }
+
+    // Save captured and diff images
+    const char* reference_filename = ImPathFindFilename(reference_file);
+    const int reference_filename_len = (int)(ImPathFindExtension(reference_filename) - reference_filename);
+    Str256f actual_file("output/captures/%.*s_actual.tga", reference_filename_len, reference_filename);
+    Str256f diff_file("output/captures/%.*s_diff.png", reference_filename_len, reference_filename);
+    captured.SaveFile(actual_file.c_str());
+    if (mismatch_count < 0)
+    {
+        IM_ERRORF_NOHDR("Capture size %d*%d doesn't match reference '%s' size %d*%d. Saved '%s'.", captured.Width, captured.Height, reference_file, reference.Width, reference.Height, actual_file.c_str());
+        return false;
+    }
+    diff.SaveFile(diff_file.c_str(), EngineIO->ImageCapturePngCompressionLevel, EngineIO->ImageCapturePngFilter);
+    IM_ERRORF_NOHDR("Capture doesn't match reference '%s': %d pixels differ by more than %d (max difference %d). Saved '%s' and '%s'.", reference_file, mismatch_count, tolerance, max_diff, actual_file.c_str(), diff_file.c_str());
+    return false;
+#else
+    IM_UNUSED(capture_flags);
+    LogWarning("Skipped checking reference '%s': disabled by IMGUI_TEST_ENGINE_ENABLE_CAPTURE=0.", reference_file);
+    return true;
+#endif
+}
+
+bool ImGuiTestContext::CaptureCheckReferenceWindow(ImGuiTestRef ref, const char* reference_file, int tolerance, int capture_flags)
+{
+    CaptureReset();
+    if (!CaptureAddWindow(ref))
+        return false;
+    return CaptureCheckReference(reference_file, tolerance, capture_flags);
+}
+
 bool ImGuiTestContext::CaptureBeginVideo()
 {
     if (IsError())
@@ -853,7 +920,9 @@ bool ImGuiTestContext::CaptureEndVideo()
     bool can_capture = ImGuiTestContext_CanCaptureVideo(this);
     if (can_capture)
     {
-        LogInfo("Saved '%s' (%d*%d pixels)", args->InOutputFile, (int)args->OutImageSize.x, (int)args->OutImageSize.y);
+        LogInfo("Saved '%s' (%d*%d pixels, %d frames, %d repeated)", args->InOutputFile, (int)args->OutImageSize.x, (int)args->OutImageSize.y, args->OutVideoFramesCount, args->OutVideoFramesRepeated);
+        if (args->OutVideoFramesDropped > 0)
+            LogWarning("Dropped %d video frames: video encoder was too slow.", args->OutVideoFramesDropped);
     }
     else
     {
@@ -4050,21 +4119,104 @@ void    ImGuiTestContext::UndockWindow(const char* window_name)
 // ImGuiTestContext - Performance Tools
 //-------------------------------------------------------------------------
 
-// Calculate the reference DeltaTime, averaged over PerfIterations/500 frames, with GuiFunc disabled.
+// Decide how many frames a perf measurement needs.
+// - By default measure a fixed number of ctx->PerfIterations frames.
+// - With ImGuiTestEngineIO::ConfigPerfAdaptiveIterations: warm up until average frame time is stable, then sample until the
+//   95% confidence interval of the mean is within requested precision, or until time budget runs out.
+// - Relative precision applies to absolute frame time: samples are deltas vs reference frame time, whose mean may be ~0.
+struct ImGuiTestPerfSampler
+{
+    bool    Adaptive = false;
+    int     FixedIterations = 0;
+    double  TargetPrecision = 0.0;          // Relative to absolute frame time (RefMs + Mean)
+    double  TargetPrecisionMs = 0.0;        // Absolute
+    double  RefMs = 0.0;                    // Reference frame time samples are measured against, in ms (0.0 when sampling absolute frame times)
+    double  ExtraVariance = 0.0;            // Variance of other terms of the estimate (e.g. reference delta time), in ms^2
+    ImU64   TimeStart = 0;
+    ImU64   TimeBudget = 0;                 // In microseconds
+    bool    WarmingUp = false;
+    int     NumWarmUpFrames = 0;
+    int     WindowCount = 0;
+    double  WindowSum = 0.0;
+    double  WindowSumSq = 0.0;
+    double  WindowMeanPrev = -1.0;
+    int     Count = 0;                      // Running mean and variance of measured samples (Welford)
+    double  Mean = 0.0;
+    double  M2 = 0.0;
+
+    void Init(ImGuiTestContext* ctx, double ref_ms, double extra_variance)
+    {
+        const ImGuiTestEngineIO* io = ctx->EngineIO;
+        Adaptive = io->ConfigPerfAdaptiveIterations;
+        FixedIterations = ctx->PerfIterations;
+        TargetPrecision = io->ConfigPerfTargetPrecision;
+        TargetPrecisionMs = io->ConfigPerfTargetPrecisionMs;
+        RefMs = ref_ms;
+        ExtraVariance = extra_variance;
+        TimeStart = ImTimeGetInMicroseconds();
+        TimeBudget = (ImU64)(io->ConfigPerfTimeBudget * 1000000.0);
+        WarmingUp = Adaptive;
+    }
+
+    double GetStdError() const { return (Count > 1) ? sqrt(M2 / (Count - 1) / Count) : 0.0; }
+    double GetConfidenceInterval() const { return 1.96 * sqrt(GetStdError() * GetStdError() + ExtraVariance); } // Half-width, normal approximation (we require 30+ samples)
+
+    // Return false when no more samples are needed.
+    bool AddSample(double sample_ms)
+    {
+        const ImU64 time_elapsed = ImTimeGetInMicroseconds() - TimeStart;
+        if (WarmingUp)
+        {
+            // Compare averages of consecutive windows of frames: stable when they differ by less than 5% or less than
+            // their noise. Give up on stability after a quarter of time budget.
+            const int window_size = 10;
+            NumWarmUpFrames++;
+            WindowSum += sample_ms;
+            WindowSumSq += sample_ms * sample_ms;
+            if (++WindowCount < window_size)
+                return true;
+            const double window_mean = WindowSum / WindowCount;
+            const double window_variance = ImMax(0.0, (WindowSumSq - WindowSum * window_mean) / (WindowCount - 1));
+            const double window_noise = 2.0 * sqrt(2.0 * window_variance / WindowCount);
+            if (WindowMeanPrev >= 0.0 && fabs(window_mean - WindowMeanPrev) <= ImMax(ImMax(fabs(RefMs + WindowMeanPrev) * 0.05, window_noise), TargetPrecisionMs))
+                WarmingUp = false;
+            else if (time_elapsed >= TimeBudget / 4)
+                WarmingUp = false;
+            WindowMeanPrev = window_mean;
+            WindowCount = 0;
+            WindowSum = WindowSumSq = 0.0;
+            return true;
+        }
+
+        Count++;
+        const double delta = sample_ms - Mean;
+        Mean += delta / Count;
+        M2 += delta * (sample_ms - Mean);
+        if (!Adaptive)
+            return Count < FixedIterations;
+        if (Count < 30)
+            return time_elapsed < TimeBudget || Count < 2;
+        return GetConfidenceInterval() > ImMax(TargetPrecision * fabs(RefMs + Mean), TargetPrecisionMs) && time_elapsed < TimeBudget;
+    }
+};
+
+// Calculate the reference DeltaTime, averaged over PerfIterations frames (or calibrated number of frames), with GuiFunc disabled.
 void    ImGuiTestContext::PerfCalcRef()
 {
     LogDebug("Measuring ref dt...");
     RunFlags |= ImGuiTestRunFlags_GuiFuncDisable;
 
-    ImMovingAverage<double> delta_times;
-    delta_times.Init(PerfIterations);
-    for (int n = 0; n < PerfIterations && !Abort; n++)
+    ImGuiTestPerfSampler sampler;
+    sampler.Init(this, 0.0, 0.0);
+    while (!Abort)
     {
         Yield();
-        delta_times.AddSample(UiContext->IO.DeltaTime);
+        if (!sampler.AddSample(UiContext->IO.DeltaTime * 1000))
+            break;
     }
 
-    PerfRefDt = delta_times.GetAverage();
+    PerfRefDt = sampler.Mean / 1000;
+    PerfRefDtStdError = sampler.GetStdError() / 1000;
     RunFlags &= ~ImGuiTestRunFlags_GuiFuncDisable;
 }
 
@@ -4080,19 +4232,68 @@ void    ImGuiTestContext::PerfCapture(const char* category, const char* test_nam
 
     // Yield for the average to stabilize
     LogDebug("Measuring GUI dt...");
-    ImMovingAverage<double> delta_times;
-    delta_times.Init(PerfIterations);
-    for (int n = 0; n < PerfIterations && !Abort; n++)
+    ImGuiTestPerfSampler sampler;
+    sampler.Init(this, PerfRefDt * 1000, (PerfRefDtStdError * 1000) * (PerfRefDtStdError * 1000));
+    const int samples_reserve = sampler.Adaptive ? 0 : PerfIterations;
+    ImVector<double> delta_samples_ms;
+    delta_samples_ms.reserve(samples_reserve);
+    ImVector<double> cpu_samples_ms[ImGuiTestEnginePerfPhase_COUNT];
+    for (ImVector<double>& samples : cpu_samples_ms)
+        samples.reserve(samples_reserve);
+    const ImPerfCounters& hw_counters = Engine->PerfCounters.Counters;
+    ImVector<double> hw_samples[ImPerfCounter_COUNT];
+    ImGuiTestEnginePerfSampling& perf_sampling = Engine->PerfSampling;
+    perf_sampling.Profiler.Clear();
+    for (bool sampling = true; sampling && !Abort;)
     {
+        perf_sampling.Requested = EngineIO->ConfigPerfSampling && !sampler.WarmingUp;
         Yield();
-        delta_times.AddSample(UiContext->IO.DeltaTime);
+        const double delta_sample_ms = (UiContext->IO.DeltaTime - PerfRefDt) * 1000;
+        const bool warming_up = sampler.WarmingUp;
+        sampling = sampler.AddSample(delta_sample_ms);
+        if (warming_up)
+            continue;
+        delta_samples_ms.push_back(delta_sample_ms);
+        for (int phase = 0; phase < ImGuiTestEnginePerfPhase_COUNT; phase++)
+            cpu_samples_ms[phase].push_back(Engine->PerfPhases.LastFrame[phase]); // Last completed frame
+        if (hw_counters.IsOpen())
+            for (int counter = 0; counter < ImPerfCounter_COUNT; counter++)
+                hw_samples[counter].push_back((double)Engine->PerfCounters.LastFrame[counter]);
     }
+    perf_sampling.Requested = false;
+    perf_sampling.Profiler.Stop();  // Main thread is not running, no need to wait for next ImGuiTestEngine_PreNewFrame()
     if (Abort)
         return;
 
-    double dt_curr = delta_times.GetAverage();
     double dt_ref_ms = PerfRefDt * 1000;
-    double dt_delta_ms = (dt_curr - PerfRefDt) * 1000;
+    double dt_delta_ms = sampler.Mean;
+    double dt_delta_ms_error = sampler.GetConfidenceInterval();
+
+    // Distribution of per-frame delta times (sorts samples)
+    ImSampleStats stats;
+    stats.Calc(delta_samples_ms.Data, delta_samples_ms.Size);
+
+    // CPU time per frame phase, excluding backend rendering/swap. Median filters out occasional hitches from harness.
+    double cpu_ms[ImGuiTestEnginePerfPhase_COUNT];
+    for (int phase = 0; phase < ImGuiTestEnginePerfPhase_COUNT; phase++)
+    {
+        ImSampleStats cpu_stats;
+        cpu_stats.Calc(cpu_samples_ms[phase].Data, cpu_samples_ms[phase].Size);
+        cpu_ms[phase] = cpu_stats.Median;
+    }
+
+    // Hardware counters per frame (-1.0 when not available)
+    double hw_median[ImPerfCounter_COUNT];
+    for (int counter = 0; counter < ImPerfCounter_COUNT; counter++)
+    {
+        hw_median[counter] = -1.0;
+        if (hw_counters.IsOpen() && hw_counters.IsAvailable((ImPerfCounter)counter) && !hw_samples[counter].empty())
+        {
+            ImSampleStats hw_stats;
+            hw_stats.Calc(hw_samples[counter].Data, hw_samples[counter].Size);
+            hw_median[counter] = hw_stats.Median;
+        }
+    }
 
     const ImBuildInfo* build_info = ImBuildGetCompilationInfo();
 
@@ -4100,13 +4301,41 @@ void    ImGuiTestContext::PerfCapture(const char* category, const char* test_nam
     // FIXME-TESTS: Would be nice if we could submit a custom marker (e.g. branch/feature name)
     LogInfo("[PERF] Conditions: Stress x%d, %s, %s, %s, %s, %s",
         PerfStressAmount, build_info->Type, build_info->Cpu, build_info->OS, build_info->Compiler, build_info->Date);
+    LogInfo("[PERF] Environment: %s, load average %.2f", Engine->PerfEnv.Fingerprint, Engine->PerfEnv.LoadAverage);
     LogInfo("[PERF] Result: %+6.3f ms (from ref %+6.3f)", dt_delta_ms, dt_ref_ms);
+    LogInfo("[PERF] Iterations: %d frames (after %d warm-up frames), 95%% confidence interval +/-%.3f ms", sampler.Count, sampler.NumWarmUpFrames, dt_delta_ms_error);
+    LogInfo("[PERF] Distribution: median %+6.3f, p90 %+6.3f, p99 %+6.3f, stddev %6.3f, iqm %+6.3f, min %+6.3f, max %+6.3f ms (%d frames)",
+        stats.Median, stats.P90, stats.P99, stats.StdDev, stats.Iqm, stats.Min, stats.Max, stats.Count);
+    LogInfo("[PERF] CPU: GuiFunc %.3f, NewFrame %.3f, EndFrame %.3f, Render %.3f, Engine %.3f ms (median per frame)",
+        cpu_ms[ImGuiTestEnginePerfPhase_GuiFunc], cpu_ms[ImGuiTestEnginePerfPhase_NewFrame], cpu_ms[ImGuiTestEnginePerfPhase_EndFrame],
+        cpu_ms[ImGuiTestEnginePerfPhase_Render], cpu_ms[ImGuiTestEnginePerfPhase_Engine]);
+    if (hw_counters.IsOpen())
+        LogInfo("[PERF] Counters: %.0f instructions, %.0f cycles, %.0f cache misses, %.0f branch misses (median per frame)",
+            hw_median[ImPerfCounter_Instructions], hw_median[ImPerfCounter_Cycles], hw_median[ImPerfCounter_CacheMisses], hw_median[ImPerfCounter_BranchMisses]);
 
     ImGuiPerfToolEntry entry;
     entry.Timestamp = Engine->BatchStartTime;
     entry.Category = category ? category : Test->Category;
     entry.TestName = test_name ? test_name : Test->Name;
     entry.DtDeltaMs = dt_delta_ms;
+    entry.DtDeltaMsMedian = stats.Median;
+    entry.DtDeltaMsP90 = stats.P90;
+    entry.DtDeltaMsP99 = stats.P99;
+    entry.DtDeltaMsStdDev = stats.StdDev;
+    entry.DtDeltaMsIqm = stats.Iqm;
+    entry.DtDeltaMsFrameMin = stats.Min;
+    entry.DtDeltaMsFrameMax = stats.Max;
+    entry.NumFrames = stats.Count;
+    entry.CpuGuiFuncMs = cpu_ms[ImGuiTestEnginePerfPhase_GuiFunc];
+    entry.CpuNewFrameMs = cpu_ms[ImGuiTestEnginePerfPhase_NewFrame];
+    entry.CpuEndFrameMs = cpu_ms[ImGuiTestEnginePerfPhase_EndFrame];
+    entry.CpuRenderMs = cpu_ms[ImGuiTestEnginePerfPhase_Render];
+    entry.CpuEngineMs = cpu_ms[ImGuiTestEnginePerfPhase_Engine];
+    entry.NumCpuFrames = stats.Count;
+    entry.HwInstructions = hw_median[ImPerfCounter_Instructions];
+    entry.HwCycles = hw_median[ImPerfCounter_Cycles];
+    entry.HwCacheMisses = hw_median[ImPerfCounter_CacheMisses];
+    entry.HwBranchMisses = hw_median[ImPerfCounter_BranchMisses];
     entry.PerfStressAmount = PerfStressAmount;
     entry.GitBranchName = EngineIO->GitBranchName;
     entry.BuildType = build_info->Type;
@@ -4114,7 +4343,83 @@ void    ImGuiTestContext::PerfCapture(const char* category, const char* test_nam
     entry.OS = build_info->OS;
     entry.Compiler = build_info->Compiler;
     entry.Date = build_info->Date;
-    ImGuiTestEngine_PerfToolAppendToCSV(Engine->PerfTool, &entry, csv_file);
+    entry.Environment = Engine->PerfEnv.Fingerprint;
+    entry.LoadAverage = Engine->PerfEnv.LoadAverage;
+    if (PerfScalingStep >= 0)
+    {
+        // Scaling-curve mode: keep results at non-default stress amounts out of main perflog
+        ImGuiTestEngine_PerfToolAppend(NULL, &entry, csv_file ? csv_file : IMGUI_PERFLOG_SCALING_FILENAME, Engine->PerfLogPending);
+        Engine->PerfTool->_ScalingDirty = true;
+    }
+    else
+    {
+        ImGuiTestEngine_PerfToolAppend(Engine->PerfTool, &entry, csv_file, Engine->PerfLogPending);
+    }
+
+    // Write sampled call stacks next to perflog
+    if (perf_sampling.Profiler.SamplesCount > 0)
+    {
+        const char* perflog_file = csv_file ? csv_file : (PerfScalingStep >= 0) ? IMGUI_PERFLOG_SCALING_FILENAME : IMGUI_PERFLOG_DEFAULT_FILENAME;
+        Str256f stacks_file("%.*sperf_stacks/%s", (int)(ImPathFindFilename(perflog_file) - perflog_file), perflog_file, entry.TestName);
+        if (PerfScalingStep >= 0)
+            stacks_file.appendf("_x%d", PerfStressAmount);
+        stacks_file.append(".folded");
+        if (perf_sampling.Profiler.WriteFoldedStacks(stacks_file.c_str()))
+            LogInfo("[PERF] Stacks: %d samples (%d dropped) saved to '%s'", perf_sampling.Profiler.SamplesCount, perf_sampling.Profiler.SamplesDropped, stacks_file.c_str());
+        else
+            LogWarning("[PERF] Unable to write '%s'", stacks_file.c_str());
+        perf_sampling.Profiler.Clear();
+    }
+
+    // Store results for exporters
+    ImGuiTestPerfResult perf_result;
+    ImStrncpy(perf_result.Name, entry.TestName, IM_ARRAYSIZE(perf_result.Name));
+    perf_result.DtDeltaMs = dt_delta_ms;
+    perf_result.DtRefMs = dt_ref_ms;
+    perf_result.DtDeltaMsMedian = stats.Median;
+    perf_result.DtDeltaMsP90 = stats.P90;
+    perf_result.DtDeltaMsP99 = stats.P99;
+    perf_result.DtDeltaMsStdDev = stats.StdDev;
+    perf_result.CpuGuiFuncMs = entry.CpuGuiFuncMs;
+    perf_result.CpuNewFrameMs = entry.CpuNewFrameMs;
+    perf_result.CpuEndFrameMs = entry.CpuEndFrameMs;
+    perf_result.CpuRenderMs = entry.CpuRenderMs;
+    perf_result.CpuEngineMs = entry.CpuEngineMs;
+    perf_result.HwInstructions = entry.HwInstructions;
+    perf_result.HwCycles = entry.HwCycles;
+    perf_result.HwCacheMisses = entry.HwCacheMisses;
+    perf_result.HwBranchMisses = entry.HwBranchMisses;
+    perf_result.NumSamples = sampler.Count;
+    perf_result.NumWarmUpFrames = sampler.NumWarmUpFrames;
+    perf_result.DtDeltaMsError = dt_delta_ms_error;
+    perf_result.PerfStressAmount = PerfStressAmount;
+
+    // Compare against baseline perflog (test will be marked as failed on regression). Not done for scaling curves.
+    ImGuiPerfToolComparison comparison;
+    if (PerfScalingStep < 0 && ImGuiTestEngine_PerfToolCompareToBaseline(Engine->PerfBaseline, &entry, &comparison))
+    {
+        const double confidence_required = EngineIO->ConfigPerfRegressionConfidence;
+        const bool significant_change = fabs(comparison.VsBaseline) >= EngineIO->ConfigPerfRegressionMinChange * 100.0;
+        if (significant_change && comparison.VsBaseline > 0.0 && comparison.Confidence >= confidence_required)
+            perf_result.Verdict = ImGuiTestPerfVerdict_Regressed;
+        else if (significant_change && comparison.VsBaseline < 0.0 && 1.0 - comparison.Confidence >= confidence_required)
+            perf_result.Verdict = ImGuiTestPerfVerdict_Improved;
+        else
+            perf_result.Verdict = ImGuiTestPerfVerdict_Unchanged;
+        perf_result.BaselineDtDeltaMs = comparison.BaselineDtDeltaMs;
+        perf_result.VsBaseline = comparison.VsBaseline;
+        perf_result.Confidence = comparison.Confidence;
+
+        ImFormatString(perf_result.VerdictText, IM_ARRAYSIZE(perf_result.VerdictText), "[PERF] %s: %s %+.1f%% vs baseline (%+.3f -> %+.3f ms, noise %.3f ms, %d baseline runs, %.1f%% confidence)",
+            entry.TestName, ImGuiTestEngine_GetPerfVerdictName(perf_result.Verdict), comparison.VsBaseline, comparison.BaselineDtDeltaMs, entry.DtDeltaMs, comparison.StdError, comparison.BaselineRuns,
+            ((perf_result.Verdict == ImGuiTestPerfVerdict_Improved) ? 1.0 - comparison.Confidence : comparison.Confidence) * 100.0);
+        LogInfo("%s", perf_result.VerdictText);
+    }
+    else if (PerfScalingStep < 0 && Engine->PerfBaseline != NULL)
+    {
+        LogInfo("[PERF] %s: no baseline data.", entry.TestName);
+    }
+    TestOutput->PerfResults.push_back(perf_result);
 
     // Disable the "Success" message
     RunFlags |= ImGuiTestRunFlags_NoSuccessMsg;
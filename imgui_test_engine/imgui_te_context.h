@@ -243,7 +243,9 @@ struct IMGUI_API ImGuiTestContext
     int                     ErrorCounter = 0;                       // Number of errors (generally this maxxes at 1 as most functions will early out)
     bool                    Abort = false;
     double                  PerfRefDt = -1.0;
-    int                     PerfIterations = 400;                   // Number of frames for PerfCapture() measurements
+    double                  PerfRefDtStdError = 0.0;                // Standard error of PerfRefDt
+    int                     PerfIterations = 400;                   // Number of frames for PerfCapture() measurements. Unused with ImGuiTestEngineIO::ConfigPerfAdaptiveIterations.
+    int                     PerfScalingStep = -1;                   // Current step of scaling-curve mode (see ImGuiTestEngineIO::ConfigPerfScalingSteps), -1 otherwise
     char                    RefStr[256] = { 0 };                    // Reference window/path over which all named references are based
     ImGuiID                 RefID = 0;                              // Reference ID over which all named references are based
     ImGuiID                 RefWindowID = 0;                        // ID of a window that contains RefID item
@@ -342,6 +344,8 @@ struct IMGUI_API ImGuiTestContext
     bool        CaptureScreenshot(int capture_flags = 0);                           // Trigger a screen capture
     bool        CaptureBeginVideo();                                                // Start a video capture
     bool        CaptureEndVideo();
+    bool        CaptureCheckReference(const char* reference_file, int tolerance = 0, int capture_flags = 0); // Capture (using CaptureArgs, e.g. after CaptureAddWindow()) and compare to a reference .tga image. Tolerance is max difference per channel (0..255). Missing reference fails, unless ConfigCaptureUpdateReferences is set.
+    bool        CaptureCheckReferenceWindow(ImGuiTestRef ref, const char* reference_file, int tolerance = 0, int capture_flags = 0); // Same for a single window (== CaptureAddWindow() + CaptureCheckReference())
 
     // Mouse inputs
     void        MouseMove(ImGuiTestRef ref, ImGuiTestOpFlags flags = ImGuiTestOpFlags_None);
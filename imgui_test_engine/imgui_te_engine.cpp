@@ -17,6 +17,10 @@
 #include "imgui_te_perftool.h"
 #include "imgui_te_exporters.h"
 #include "thirdparty/Str/Str.h"
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #if _WIN32
 #ifndef WIN32_LEAN_AND_MEAN
 #define WIN32_LEAN_AND_MEAN
@@ -41,6 +45,8 @@ Index of this file:
 // [SECTION] FORWARD DECLARATIONS
 // [SECTION] DATA STRUCTURES
 // [SECTION] TEST ENGINE FUNCTIONS
+// [SECTION] TEST QUEUE SHARDING
+// [SECTION] LOG OUTPUT
 // [SECTION] CRASH HANDLING
 // [SECTION] HOOKS FOR CORE LIBRARY
 // [SECTION] CHECK/ERROR FUNCTIONS FOR TESTS
@@ -64,6 +70,8 @@ static ImGuiTestEngine* GImGuiTestEngine = NULL;
 static void ImGuiTestEngine_BindImGuiContext(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_UnbindImGuiContext(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_CoroutineStopAndJoin(ImGuiTestEngine* engine);
+static void ImGuiTestEngine_LogOutputShutdown(ImGuiTestEngine* engine);
+static void ImGuiTestEngine_LogOutputFlushFromCrashHandler(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_StartCalcSourceLineEnds(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ClearInput(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_ApplyInputToImGuiContext(ImGuiTestEngine* engine);
@@ -73,6 +81,7 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
 static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
 static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx);
+static void ImGuiTestEngine_PerfPhaseMark(ImGuiTestEngine* engine, ImGuiTestEnginePerfPhase phase_ended);
 static void ImGuiTestEngine_UpdateHooks(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_RunGuiFunc(ImGuiTestEngine* engine);
 static void ImGuiTestEngine_TestQueueCoroutineMain(void* engine_opaque);
@@ -100,6 +109,9 @@ static void  ImGuiTestEngine_SettingsWriteAll(ImGuiContext* imgui_ctx, ImGuiSett
 // - ImGuiTestEngine_PreNewFrame()
 // - ImGuiTestEngine_PostNewFrame()
 // - ImGuiTestEngine_Yield()
+// - ImGuiTestEngine_PerfEnvBegin()
+// - ImGuiTestEngine_PerfEnvWarmUp()
+// - ImGuiTestEngine_PerfEnvEnd()
 // - ImGuiTestEngine_ProcessTestQueue()
 // - ImGuiTestEngine_QueueTest()
 // - ImGuiTestEngine_RunTest()
@@ -111,6 +123,7 @@ ImGuiTestEngine::ImGuiTestEngine()
     PerfDeltaTime100.Init(100);
     PerfDeltaTime500.Init(500);
     PerfTool = IM_NEW(ImGuiPerfTool);
+    PerfLogPending = IM_NEW(ImGuiPerfLogPendingEntries);
     UiFilterTests = IM_NEW(Str256); // We bite the bullet of adding an extra alloc/indirection in order to avoid including Str.h in our header
     UiFilterPerfs = IM_NEW(Str256);
 
@@ -125,6 +138,8 @@ ImGuiTestEngine::~ImGuiTestEngine()
 {
     IM_ASSERT(TestQueueCoroutine == NULL);
     IM_DELETE(PerfTool);
+    IM_DELETE(PerfBaseline);
+    IM_DELETE(PerfLogPending);
     IM_DELETE(UiFilterTests);
     IM_DELETE(UiFilterPerfs);
 }
@@ -163,6 +178,17 @@ static void ImGuiTestEngine_BindImGuiContext(ImGuiTestEngine* engine, ImGuiConte
     hook.UserData = (void*)engine;
     ImGui::AddContextHook(ui_ctx, &hook);
 
+    // Those two are only used to time EndFrame() separately from application code
+    hook.Type = ImGuiContextHookType_EndFramePre;
+    hook.Callback = [](ImGuiContext* ui_ctx, ImGuiContextHook* hook) { ImGuiTestEngine* engine = (ImGuiTestEngine*)hook->UserData; if (engine->UiContextTarget == ui_ctx) ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_None); };
+    hook.UserData = (void*)engine;
+    ImGui::AddContextHook(ui_ctx, &hook);
+
+    hook.Type = ImGuiContextHookType_EndFramePost;
+    hook.Callback = [](ImGuiContext* ui_ctx, ImGuiContextHook* hook) { ImGuiTestEngine* engine = (ImGuiTestEngine*)hook->UserData; if (engine->UiContextTarget == ui_ctx) ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_EndFrame); };
+    hook.UserData = (void*)engine;
+    ImGui::AddContextHook(ui_ctx, &hook);
+
     hook.Type = ImGuiContextHookType_RenderPre;
     hook.Callback = [](ImGuiContext* ui_ctx, ImGuiContextHook* hook) { ImGuiTestEngine_PreRender((ImGuiTestEngine*)hook->UserData, ui_ctx); };
     hook.UserData = (void*)engine;
@@ -228,7 +254,10 @@ void    ImGuiTestEngine_DestroyContext(ImGuiTestEngine* engine)
     if (engine->UiContextTarget != NULL)
         ImGuiTestEngine_UnbindImGuiContext(engine, engine->UiContextTarget);
 
+    ImGuiTestEngine_PerfToolFlush(engine->PerfLogPending);
+    ImGuiTestEngine_ExportStreamShutdown(engine);
     ImGuiTestEngine_ClearTests(engine);
+    ImGuiTestEngine_LogOutputShutdown(engine);
 
     for (int n = 0; n < engine->InfoTasks.Size; n++)
         IM_DELETE(engine->InfoTasks[n]);
@@ -266,6 +295,9 @@ void    ImGuiTestEngine_Stop(ImGuiTestEngine* engine)
 
     engine->Abort = true;
     ImGuiTestEngine_CoroutineStopAndJoin(engine);
+    engine->CaptureContext.FlushPendingImages();
+    ImGuiTestEngine_PerfToolFlush(engine->PerfLogPending);
+    ImGuiTestEngine_LogOutputFlush(engine);
     ImGuiTestEngine_Export(engine);
     engine->Started = false;
 }
@@ -364,6 +396,11 @@ void    ImGuiTestEngine_PostSwap(ImGuiTestEngine* engine)
     engine->CaptureContext.VideoCaptureEncoderParamsSize = IM_ARRAYSIZE(engine->IO.VideoCaptureEncoderParams);
     engine->CaptureContext.GifCaptureEncoderParams = engine->IO.GifCaptureEncoderParams;
     engine->CaptureContext.GifCaptureEncoderParamsSize = IM_ARRAYSIZE(engine->IO.GifCaptureEncoderParams);
+    engine->CaptureContext.GifUseBuiltinEncoder = engine->IO.GifCaptureUseBuiltinEncoder;
+    engine->CaptureContext.VideoDamageTracking = engine->IO.VideoCaptureDamageTracking;
+    engine->CaptureContext.PngCompressionLevel = engine->IO.ImageCapturePngCompressionLevel;
+    engine->CaptureContext.PngFilter = engine->IO.ImageCapturePngFilter;
+    engine->CaptureContext.ContentStorePath = engine->IO.ImageCaptureStorePath;
     engine->CaptureTool.VideoCaptureExtension = engine->IO.VideoCaptureExtension;
     engine->CaptureTool.VideoCaptureExtensionSize = IM_ARRAYSIZE(engine->IO.VideoCaptureExtension);
 
@@ -748,6 +785,54 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
     IM_ASSERT(ui_ctx == GImGui);
     ImGuiContext& g = *ui_ctx;
 
+    // Complete timing of previous frame
+    ImGuiTestEnginePerfPhases& perf_phases = engine->PerfPhases;
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_None);
+    memcpy(perf_phases.LastFrame, perf_phases.CurrFrame, sizeof(perf_phases.LastFrame));
+    memset(perf_phases.CurrFrame, 0, sizeof(perf_phases.CurrFrame));
+
+    // Start hardware performance counters for this frame
+    ImGuiTestEnginePerfCounters& perf_counters = engine->PerfCounters;
+    if (engine->IO.ConfigPerfCounters && !perf_counters.Counters.IsOpen() && !perf_counters.OpenFailed)
+    {
+        perf_counters.OpenFailed = !perf_counters.Counters.Open();
+        if (perf_counters.OpenFailed)
+            fprintf(stderr, "Hardware performance counters are not available on this system (on Linux, check /proc/sys/kernel/perf_event_paranoid).\n");
+    }
+    else if (!engine->IO.ConfigPerfCounters && perf_counters.Counters.IsOpen())
+    {
+        perf_counters.Counters.Close();
+    }
+    if (perf_counters.Counters.IsOpen())
+        perf_counters.Counters.Read(perf_counters.FrameStart);
+
+    // Sample call stacks of this thread while PerfCapture() measures (samples are only taken while this thread uses CPU time)
+    ImGuiTestEnginePerfSampling& perf_sampling = engine->PerfSampling;
+    if (perf_sampling.Requested && !perf_sampling.Profiler.IsRunning() && !perf_sampling.StartFailed)
+    {
+        perf_sampling.StartFailed = !perf_sampling.Profiler.Start(engine->IO.ConfigPerfSamplingFrequency);
+        if (perf_sampling.StartFailed)
+            fprintf(stderr, "Call stack sampling is not available on this system.\n");
+    }
+    else if (!perf_sampling.Requested && perf_sampling.Profiler.IsRunning())
+    {
+        perf_sampling.Profiler.Stop();
+    }
+
+    // Follow test thread CPU pinning (see ImGuiTestEngine_PerfEnvBegin())
+    ImGuiTestEnginePerfEnv& perf_env = engine->PerfEnv;
+    if (perf_env.PinnedCpu >= 0 && !perf_env.MainThreadPinned && ImThreadGetCurrentAffinity(&perf_env.MainThreadBackup))
+    {
+        ImThreadAffinity affinity;
+        affinity.Set(perf_env.PinnedCpu);
+        perf_env.MainThreadPinned = ImThreadSetCurrentAffinity(affinity);
+    }
+    else if (perf_env.PinnedCpu < 0 && perf_env.MainThreadPinned)
+    {
+        ImThreadSetCurrentAffinity(perf_env.MainThreadBackup);
+        perf_env.MainThreadPinned = false;
+    }
+
     engine->CaptureContext.PreNewFrame();
 
     if (engine->ToolDebugRebootUiContext)
@@ -803,6 +888,7 @@ static void ImGuiTestEngine_PreNewFrame(ImGuiTestEngine* engine, ImGuiContext* u
 
     ImGuiTestEngine_ApplyInputToImGuiContext(engine);
     ImGuiTestEngine_UpdateHooks(engine);
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Engine);
 }
 
 static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -810,6 +896,7 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
     if (engine->UiContextTarget != ui_ctx)
         return;
     IM_ASSERT(ui_ctx == GImGui);
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_NewFrame);
 
     // Set initial mouse position to a decent value on startup
     if (engine->FrameCount == 1)
@@ -835,7 +922,9 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
         ImThreadSleepInMilliseconds(engine->ToolSlowDownMs);
 
     // Call user GUI function
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Engine);
     ImGuiTestEngine_RunGuiFunc(engine);
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_GuiFunc);
 
     // Process on-going queues in a coroutine
     // Run the test coroutine. This will resume the test queue from either the last point the test called YieldFromCoroutine(),
@@ -857,6 +946,7 @@ static void ImGuiTestEngine_PostNewFrame(ImGuiTestEngine* engine, ImGuiContext*
     if (engine->IO.ConfigRunSpeed == ImGuiTestRunSpeed_Fast && engine->IO.IsRunningTests)
         if (engine->TestContext && (engine->TestContext->RunFlags & ImGuiTestRunFlags_GuiFuncOnly) == 0)
             engine->IO.IsRequestingMaxAppSpeed = true;
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Engine);
 }
 
 static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -864,8 +954,10 @@ static void ImGuiTestEngine_PreRender(ImGuiTestEngine* engine, ImGuiContext* ui_
     if (engine->UiContextTarget != ui_ctx)
         return;
     IM_ASSERT(ui_ctx == GImGui);
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Render);
 
     engine->CaptureContext.PreRender();
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Engine);
 }
 
 static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui_ctx)
@@ -873,6 +965,7 @@ static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui
     if (engine->UiContextTarget != ui_ctx)
         return;
     IM_ASSERT(ui_ctx == GImGui);
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Render);
 
     // When test are running make sure real backend doesn't pick mouse cursor shape from tests.
     // (If were to instead set io.ConfigFlags |= ImGuiConfigFlags_NoMouseCursorChange in ImGuiTestEngine_RunTest() that would get us 99% of the way,
@@ -894,6 +987,26 @@ static void ImGuiTestEngine_PostRender(ImGuiTestEngine* engine, ImGuiContext* ui
 #endif
 
     engine->CaptureContext.PostRender();
+    ImGuiTestEngine_PerfPhaseMark(engine, ImGuiTestEnginePerfPhase_Engine);
+
+    ImGuiTestEnginePerfCounters& perf_counters = engine->PerfCounters;
+    if (perf_counters.Counters.IsOpen())
+    {
+        ImU64 frame_end[ImPerfCounter_COUNT];
+        perf_counters.Counters.Read(frame_end);
+        for (int n = 0; n < ImPerfCounter_COUNT; n++)
+            perf_counters.LastFrame[n] = frame_end[n] - perf_counters.FrameStart[n];
+    }
+}
+
+// Attribute time elapsed since previous call to 'phase_ended'.
+static void ImGuiTestEngine_PerfPhaseMark(ImGuiTestEngine* engine, ImGuiTestEnginePerfPhase phase_ended)
+{
+    ImGuiTestEnginePerfPhases& perf_phases = engine->PerfPhases;
+    const ImU64 time = ImTimeGetInNanoseconds();
+    if (phase_ended != ImGuiTestEnginePerfPhase_None && perf_phases.LastTime != 0)
+        perf_phases.CurrFrame[phase_ended] += (double)(time - perf_phases.LastTime) / 1000000.0;
+    perf_phases.LastTime = time;
 }
 
 static void ImGuiTestEngine_RunGuiFunc(ImGuiTestEngine* engine)
@@ -944,6 +1057,8 @@ void ImGuiTestEngine_Yield(ImGuiTestEngine* engine)
     if (ctx)
     {
         IM_ASSERT(ctx->ActiveFunc == ImGuiTestActiveFunc_TestFunc && "Can only yield inside TestFunc()!");
+        if (ctx->TestOutput)
+            ctx->TestOutput->YieldCount++;
         for (ImGuiWindow* window : ctx->ForeignWindowsToHide)
         {
             window->HiddenFramesForRenderOnly = 2;          // Hide root window
@@ -992,6 +1107,15 @@ const char* ImGuiTestEngine_GetVerboseLevelName(ImGuiTestVerboseLevel v)
     return "N/A";
 }
 
+const char* ImGuiTestEngine_GetPerfVerdictName(ImGuiTestPerfVerdict v)
+{
+    static const char* names[ImGuiTestPerfVerdict_COUNT] = { "Unknown", "Unchanged", "Improved", "Regressed" };
+    IM_STATIC_ASSERT(IM_ARRAYSIZE(names) == ImGuiTestPerfVerdict_COUNT);
+    if (v >= 0 && v < IM_ARRAYSIZE(names))
+        return names[v];
+    return "N/A";
+}
+
 bool ImGuiTestEngine_CaptureScreenshot(ImGuiTestEngine* engine, ImGuiCaptureArgs* args)
 {
     if (engine->IO.ScreenCaptureFunc == NULL)
@@ -1069,7 +1193,7 @@ bool ImGuiTestEngine_CaptureEndVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs*
     IM_ASSERT(engine->CaptureContext.IsCapturingVideo() && "No video capture is in progress.");
 
     engine->CaptureContext.EndVideoCapture();
-    while (engine->CaptureCurrentArgs != NULL)   // Wait until last frame is captured and gif is saved.
+    while (engine->CaptureCurrentArgs != NULL)   // Wait until last frame is captured. Encoder finishes writing video in background.
         ImGuiTestEngine_Yield(engine);
     engine->IO.ConfigRunSpeed = engine->BackupConfigRunSpeed;
     engine->IO.ConfigNoThrottle = engine->BackupConfigNoThrottle;
@@ -1078,6 +1202,86 @@ bool ImGuiTestEngine_CaptureEndVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs*
     return true;
 }
 
+// Query machine state and build fingerprint stored with every perflog entry of the batch.
+// With IO.ConfigPerfControlledEnv, pin test coroutine thread to a single CPU. Main thread follows in ImGuiTestEngine_PreNewFrame().
+static void ImGuiTestEngine_PerfEnvBegin(ImGuiTestEngine* engine)
+{
+    ImGuiTestEnginePerfEnv& perf_env = engine->PerfEnv;
+    perf_env.WarmedUp = false;
+
+    if (engine->IO.ConfigPerfControlledEnv && !perf_env.TestThreadPinned && ImThreadGetCurrentAffinity(&perf_env.TestThreadBackup))
+    {
+        int cpu = (engine->IO.ConfigPerfAffinityCpu >= 0) ? engine->IO.ConfigPerfAffinityCpu : perf_env.TestThreadBackup.GetLast();
+        ImThreadAffinity affinity;
+        affinity.Set(cpu);
+        if (cpu >= 0 && ImThreadSetCurrentAffinity(affinity))
+        {
+            perf_env.TestThreadPinned = true;
+            perf_env.PinnedCpu = cpu;
+        }
+        else
+        {
+            fprintf(stderr, "Unable to pin test thread to CPU %d.\n", cpu);
+        }
+    }
+
+    ImPerfEnvironment env;
+    ImPerfEnvironmentQuery(&env, perf_env.PinnedCpu >= 0 ? perf_env.PinnedCpu : 0);
+    perf_env.LoadAverage = env.LoadAverage;
+
+    // Perflog and settings are comma-separated
+    Str256f fingerprint("%s / %d cores", env.CpuModel[0] ? env.CpuModel : "Unknown CPU", env.NumCores);
+    if (env.CpuGovernor[0])
+        fingerprint.appendf(" / %s", env.CpuGovernor);
+    if (perf_env.PinnedCpu >= 0)
+        fingerprint.append(" / pinned");
+    for (char* p = fingerprint.c_str(); *p; p++)
+        if (*p == ',')
+            *p = ' ';
+
+    perf_env.Fingerprint = NULL;
+    for (const char* existing : perf_env.Fingerprints)
+        if (strcmp(existing, fingerprint.c_str()) == 0)
+            perf_env.Fingerprint = existing;
+    if (perf_env.Fingerprint == NULL)
+    {
+        perf_env.Fingerprints.push_back(ImStrdup(fingerprint.c_str()));
+        perf_env.Fingerprint = perf_env.Fingerprints.back();
+    }
+}
+
+// Busy-loop so CPU reaches a steady frequency before measuring. Yield regularly to keep application responsive.
+static void ImGuiTestEngine_PerfEnvWarmUp(ImGuiTestEngine* engine)
+{
+    ImGuiTestEnginePerfEnv& perf_env = engine->PerfEnv;
+    perf_env.WarmedUp = true;
+    if (engine->IO.ConfigPerfWarmUpTime <= 0.0f)
+        return;
+
+    const ImU64 end_time = ImTimeGetInMicroseconds() + (ImU64)(engine->IO.ConfigPerfWarmUpTime * 1000000.0f);
+    volatile ImU64 sink = 0;
+    while (!engine->Abort)
+    {
+        ImU64 now = ImTimeGetInMicroseconds();
+        if (now >= end_time)
+            break;
+        const ImU64 slice_end = ImMin(now + 50000, end_time);
+        while (ImTimeGetInMicroseconds() < slice_end)
+            for (int n = 0; n < 10000; n++)
+                sink = sink + (ImU64)n * 2654435761u;
+        ImGuiTestEngine_Yield(engine);
+    }
+}
+
+static void ImGuiTestEngine_PerfEnvEnd(ImGuiTestEngine* engine)
+{
+    ImGuiTestEnginePerfEnv& perf_env = engine->PerfEnv;
+    if (perf_env.TestThreadPinned)
+        ImThreadSetCurrentAffinity(perf_env.TestThreadBackup);
+    perf_env.TestThreadPinned = false;
+    perf_env.PinnedCpu = -1;
+}
+
 static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
 {
     // Avoid tracking scrolling in UI when running a single test
@@ -1092,10 +1296,20 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
     int ran_tests = 0;
     engine->BatchStartTime = ImTimeGetInMicroseconds();
     engine->IO.IsRunningTests = true;
+    ImGuiTestEngine_ExportStreamBegin(engine);
+    ImGuiTestEngine_PerfEnvBegin(engine);
     for (int n = 0; n < engine->TestsQueue.Size; n++)
     {
         ImGuiTestRunTask* run_task = &engine->TestsQueue[n];
-        IM_ASSERT(run_task->Test->Output.Status == ImGuiTestStatus_Queued);
+        ImGuiTest* test = run_task->Test;
+        IM_ASSERT(test->Output.Status == ImGuiTestStatus_Queued);
+
+        // Warm up before first perf test (may yield, queue may be modified meanwhile)
+        if (test->Group == ImGuiTestGroup_Perfs && engine->IO.ConfigPerfControlledEnv && !engine->PerfEnv.WarmedUp)
+        {
+            ImGuiTestEngine_PerfEnvWarmUp(engine);
+            run_task = &engine->TestsQueue[n];
+        }
 
         // FIXME-TESTS: Blind mode not supported
         IM_ASSERT(engine->UiContextTarget != NULL);
@@ -1113,6 +1327,9 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
         IM_ASSERT(engine->UiContextActive == engine->UiContextTarget);
         engine->UiContextActive = NULL;
 
+        // Stream results to export file (run_task may have been invalidated by tests queued while running)
+        ImGuiTestEngine_ExportStreamTest(engine, test);
+
         // Auto select the first error test
         //if (test->Status == ImGuiTestStatus_Error)
         //    if (engine->UiSelectedTest == NULL || engine->UiSelectedTest->Status != ImGuiTestStatus_Error)
@@ -1120,8 +1337,11 @@ static void ImGuiTestEngine_ProcessTestQueue(ImGuiTestEngine* engine)
 
         ran_tests++;
     }
+    ImGuiTestEngine_PerfEnvEnd(engine);
     engine->IO.IsRunningTests = false;
     engine->BatchEndTime = ImTimeGetInMicroseconds();
+    ImGuiTestEngine_ExportStreamEnd(engine);
+    ImGuiTestEngine_PerfToolFlush(engine->PerfLogPending); // Write perflog entries of this run as a single block
 
     engine->Abort = false;
     engine->TestsQueue.clear();
@@ -1220,6 +1440,21 @@ ImGuiPerfTool* ImGuiTestEngine_GetPerfTool(ImGuiTestEngine* engine)
     return engine->PerfTool;
 }
 
+// Load perflog used as a baseline by PerfCapture(). Perf tests regressing vs baseline will be marked as failed.
+bool ImGuiTestEngine_LoadPerfBaseline(ImGuiTestEngine* engine, const char* filename)
+{
+    if (engine->PerfBaseline == NULL)
+        engine->PerfBaseline = IM_NEW(ImGuiPerfTool);
+    if (!engine->PerfBaseline->Load(filename))
+    {
+        fprintf(stderr, "Unable to load baseline perflog '%s'.\n", filename);
+        IM_DELETE(engine->PerfBaseline);
+        engine->PerfBaseline = NULL;
+        return false;
+    }
+    return true;
+}
+
 // Filter tests by a specified query. Query is composed of one or more comma-separated filter terms optionally prefixed/suffixed with modifiers.
 // Available modifiers:
 // - '-' prefix excludes tests matched by the term.
@@ -1459,6 +1694,78 @@ struct ImGuiTestContextUiContextBackup
     }
 };
 
+// Scaling-curve mode (see ImGuiTestEngineIO::ConfigPerfScalingSteps): run TestFunc once per stress amount of a geometric
+// series, then fit results of each perf test name to complexity classes.
+// Tests may read ctx->PerfStressAmount only once when creating their vars, so vars are recreated for every stress amount.
+static void ImGuiTestEngine_RunPerfScaling(ImGuiTestEngine* engine, ImGuiTestContext* ctx, ImGuiTest* test)
+{
+    ImGuiTestOutput* test_output = ctx->TestOutput;
+    const int steps = engine->IO.ConfigPerfScalingSteps;
+    const int base_stress_amount = ImMax(ctx->PerfStressAmount, 1);
+    IM_ASSERT(steps >= 1 && steps <= 30 && base_stress_amount <= (INT_MAX >> (steps - 1)) && "ConfigPerfScalingSteps too large: stress amount would overflow.");
+    for (int step = 0; step < steps && !engine->Abort && test_output->Status == ImGuiTestStatus_Running; step++)
+    {
+        ctx->PerfScalingStep = step;
+        ctx->PerfStressAmount = base_stress_amount << step;
+        if (step > 0)
+        {
+            ctx->GenericVars.Clear();
+            if (test->VarsConstructor != NULL)
+            {
+                test->VarsDestructor(ctx->UserVars);
+                test->VarsConstructor(ctx->UserVars);
+                if (test->VarsPostConstructor != NULL && test->VarsPostConstructorUserFn != NULL)
+                    test->VarsPostConstructor(ctx, ctx->UserVars, test->VarsPostConstructorUserFn);
+            }
+            ctx->SetRef("");
+            ctx->Yield(2); // Same as initial GUI warm up
+        }
+        ctx->LogInfo("[PERF] Scaling step %d/%d: Stress x%d", step + 1, steps, ctx->PerfStressAmount);
+        test->TestFunc(ctx);
+    }
+    ctx->PerfScalingStep = -1;
+    ctx->PerfStressAmount = base_stress_amount;
+    if (engine->Abort || test_output->Status != ImGuiTestStatus_Running)
+        return;
+
+    // Fit results of every perf test name (a TestFunc may call PerfCapture() several times with different names)
+    ImVector<double> stress_amounts;
+    ImVector<double> dt_delta_ms;
+    for (int i = 0; i < test_output->PerfResults.Size; i++)
+    {
+        ImGuiTestPerfResult* first = &test_output->PerfResults[i];
+        bool fitted = false;
+        for (int j = 0; j < i && !fitted; j++)
+            fitted = strcmp(test_output->PerfResults[j].Name, first->Name) == 0;
+        if (fitted)
+            continue;
+
+        stress_amounts.resize(0);
+        dt_delta_ms.resize(0);
+        for (int j = i; j < test_output->PerfResults.Size; j++)
+            if (strcmp(test_output->PerfResults[j].Name, first->Name) == 0)
+            {
+                stress_amounts.push_back((double)test_output->PerfResults[j].PerfStressAmount);
+                dt_delta_ms.push_back(test_output->PerfResults[j].DtDeltaMs);
+            }
+
+        ImGuiPerfToolScalingFit fit;
+        if (!ImGuiTestEngine_PerfToolFitScaling(stress_amounts.Data, dt_delta_ms.Data, stress_amounts.Size, &fit))
+        {
+            ctx->LogWarning("[PERF] Scaling: %s: not enough stress amounts to fit a curve (%d).", first->Name, stress_amounts.Size);
+            continue;
+        }
+        for (int j = i; j < test_output->PerfResults.Size; j++)
+            if (strcmp(test_output->PerfResults[j].Name, first->Name) == 0)
+            {
+                test_output->PerfResults[j].ScalingComplexity = fit.Complexity;
+                test_output->PerfResults[j].ScalingExponent = fit.Exponent;
+            }
+        ctx->LogInfo("[PERF] Scaling: %s: %s (time ~ N^%.2f, R^2 %.3f, stress x%d..x%d)", first->Name,
+            ImGuiTestEngine_PerfToolGetComplexityName(fit.Complexity), fit.Exponent, fit.RSquared, base_stress_amount, base_stress_amount << (steps - 1));
+    }
+}
+
 // FIXME: Work toward simplifying this function?
 void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_ctx, ImGuiTest* test, ImGuiTestRunFlags run_flags)
 {
@@ -1490,11 +1797,14 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
     }
 
     ImGuiTestOutput* test_output;
+    const int start_frame_count = engine->FrameCount;
     if (parent_ctx == NULL)
     {
         ctx->Test = test;
         test_output = ctx->TestOutput = &test->Output;
         test_output->StartTime = ImTimeGetInMicroseconds();
+        test_output->FrameCount = test_output->YieldCount = 0;
+        test_output->PerfResults.clear();
     }
     else
     {
@@ -1643,7 +1953,10 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
         if (test->TestFunc)
         {
             // Test function
-            test->TestFunc(ctx);
+            if (test->Group == ImGuiTestGroup_Perfs && engine->IO.ConfigPerfScalingSteps > 0 && parent_ctx == NULL && (run_flags & ImGuiTestRunFlags_ShareVars) == 0)
+                ImGuiTestEngine_RunPerfScaling(engine, ctx, test);
+            else
+                test->TestFunc(ctx);
 
             // In case test failed without finishing gif capture - finish it here. This may trigger due to user error or
             // due to IM_SUSPEND_TESTFUNC() terminating TestFunc() early.
@@ -1671,7 +1984,7 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
             args.InFlags = ImGuiCaptureFlags_Instant;
             args.InCaptureRect.Min = ImGui::GetMainViewport()->Pos;
             args.InCaptureRect.Max = args.InCaptureRect.Min + ImGui::GetMainViewport()->Size;
-            ImFormatString(args.InOutputFile, IM_ARRAYSIZE(args.InOutputFile), "output/failures/%s_%04d.png", ctx->Test->Name, ctx->ErrorCounter);
+            ImFormatString(args.InOutputFile, IM_ARRAYSIZE(args.InOutputFile), "output/failures/%s_%04d%s", ctx->Test->Name, ctx->ErrorCounter, engine->IO.ImageCaptureExtension);
             if (ImGuiTestEngine_CaptureScreenshot(engine, &args))
                 ctx->LogDebug("Saved '%s' (%d*%d pixels)", args.InOutputFile, (int)args.OutImageSize.x, (int)args.OutImageSize.y);
         }
@@ -1716,8 +2029,19 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
 
     IM_ASSERT(engine->CaptureCurrentArgs == NULL && "Active capture was not terminated in the test code.");
 
+    // Fail test on perf regressions vs baseline. Done after TestFunc so all PerfCapture() calls of the test are recorded.
+    if (test_output->Status == ImGuiTestStatus_Running && !engine->Abort)
+        for (const ImGuiTestPerfResult& perf_result : test_output->PerfResults)
+            if (perf_result.Verdict == ImGuiTestPerfVerdict_Regressed)
+            {
+                ctx->LogError("%s", perf_result.VerdictText);
+                test_output->Status = ImGuiTestStatus_Error;
+            }
+
     // Process and display result/status
     test_output->EndTime = ImTimeGetInMicroseconds();
+    if (parent_ctx == NULL)
+        test_output->FrameCount = engine->FrameCount - start_frame_count;
     if (test_output->Status == ImGuiTestStatus_Running)
         test_output->Status = ImGuiTestStatus_Success;
     if (engine->Abort && test_output->Status != ImGuiTestStatus_Error)
@@ -1775,6 +2099,441 @@ void ImGuiTestEngine_RunTest(ImGuiTestEngine* engine, ImGuiTestContext* parent_c
     engine->TestContext = parent_ctx;
 }
 
+//-------------------------------------------------------------------------
+// [SECTION] TEST QUEUE SHARDING
+//-------------------------------------------------------------------------
+// - ImGuiTestEngine_GetTestDurationKey() [Internal]
+// - ImGuiTestEngine_LoadTestDurations()
+// - ImGuiTestEngine_SaveTestDurations()
+// - ImGuiTestEngine_ShardTestQueue()
+//-------------------------------------------------------------------------
+// Sharding splits the test queue across N processes (typically N CI machines running the same executable):
+// - Assignment only depends on the test queue and on loaded durations, so each shard computes it independently.
+//   Every shard MUST load the same durations file, otherwise shards disagree and tests get skipped or ran twice.
+// - Tests are assigned longest first to the least loaded shard, which with many short tests keeps shards
+//   within a few percent of each other.
+// - Durations are wall-clock durations recorded by previous runs. Tests without a recorded duration are assumed
+//   to take the average recorded duration. Without any recorded duration this is an even split by test count.
+// Durations file is a CSV file with "category,name,seconds" lines. Files from multiple shards may be concatenated.
+//-------------------------------------------------------------------------
+
+static ImGuiID ImGuiTestEngine_GetTestDurationKey(const char* category, const char* name)
+{
+    return ImHashStr(name, 0, ImHashStr(category));
+}
+
+bool ImGuiTestEngine_LoadTestDurations(ImGuiTestEngine* engine, const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    ImGuiCsvParser parser(3);
+    if (!parser.Load(filename))
+        return false;
+
+    // Later lines override earlier ones
+    for (int row = 0; row < parser.Rows; row++)
+    {
+        const float duration = (float)strtod(parser.GetCell(row, 2), NULL);
+        if (duration >= 0.0f)
+            engine->TestDurations.SetFloat(ImGuiTestEngine_GetTestDurationKey(parser.GetCell(row, 0), parser.GetCell(row, 1)), duration);
+    }
+    return true;
+}
+
+// Record durations of tests which ran, keep previously loaded durations of other tests.
+bool ImGuiTestEngine_SaveTestDurations(ImGuiTestEngine* engine, const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    for (ImGuiTest* test : engine->TestsAll)
+    {
+        ImGuiTestOutput* test_output = &test->Output;
+        if ((test_output->Status == ImGuiTestStatus_Success || test_output->Status == ImGuiTestStatus_Error) && test_output->EndTime > test_output->StartTime)
+            engine->TestDurations.SetFloat(ImGuiTestEngine_GetTestDurationKey(test->Category, test->Name), (float)((double)(test_output->EndTime - test_output->StartTime) / 1000000.0));
+    }
+
+    ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename));
+    FILE* fp = fopen(filename, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Writing '%s' failed.\n", filename);
+        return false;
+    }
+    for (ImGuiTest* test : engine->TestsAll)
+    {
+        const float duration = engine->TestDurations.GetFloat(ImGuiTestEngine_GetTestDurationKey(test->Category, test->Name), -1.0f);
+        if (duration >= 0.0f)
+            fprintf(fp, "%s,%s,%.6f\n", test->Category, test->Name, duration);
+    }
+    fclose(fp);
+    return true;
+}
+
+// Keep only queued tests assigned to shard 'shard_index' (0-based) out of 'shard_count' shards.
+// Return estimated duration of the shard, in seconds (or number of tests if no duration was recorded).
+float ImGuiTestEngine_ShardTestQueue(ImGuiTestEngine* engine, int shard_index, int shard_count)
+{
+    IM_ASSERT(shard_count > 0 && shard_index >= 0 && shard_index < shard_count);
+    ImVector<ImGuiTestRunTask>& queue = engine->TestsQueue;
+
+    struct ShardItem
+    {
+        int     QueueIdx;
+        float   Duration;
+        int     Shard;
+    };
+    ImVector<ShardItem> items;
+    items.resize(queue.Size);
+    double known_total = 0.0;
+    int known_count = 0;
+    for (int n = 0; n < queue.Size; n++)
+    {
+        ImGuiTest* test = queue[n].Test;
+        ShardItem& item = items[n];
+        item.QueueIdx = n;
+        item.Duration = engine->TestDurations.GetFloat(ImGuiTestEngine_GetTestDurationKey(test->Category, test->Name), -1.0f);
+        item.Shard = 0;
+        if (item.Duration >= 0.0f)
+        {
+            known_total += item.Duration;
+            known_count++;
+        }
+    }
+    const float default_duration = (known_count > 0) ? (float)(known_total / known_count) : 1.0f;
+    for (ShardItem& item : items)
+        if (item.Duration < 0.0f)
+            item.Duration = default_duration;
+
+    // Longest first. Ties are broken by queue order so all shards compute the same assignment.
+    ImQsort(items.Data, (size_t)items.Size, sizeof(ShardItem), [](const void* lhs, const void* rhs)
+    {
+        const ShardItem* a = (const ShardItem*)lhs;
+        const ShardItem* b = (const ShardItem*)rhs;
+        if (a->Duration != b->Duration)
+            return (a->Duration > b->Duration) ? -1 : +1;
+        return a->QueueIdx - b->QueueIdx;
+    });
+
+    // Assign each test to least loaded shard (lowest index on ties)
+    ImVector<double> shard_loads;
+    shard_loads.resize(shard_count, 0.0);
+    for (ShardItem& item : items)
+    {
+        int best_shard = 0;
+        for (int shard_n = 1; shard_n < shard_count; shard_n++)
+            if (shard_loads[shard_n] < shard_loads[best_shard])
+                best_shard = shard_n;
+        shard_loads[best_shard] += item.Duration;
+        item.Shard = best_shard;
+    }
+
+    // Filter queue, preserving original order
+    ImVector<bool> keep;
+    keep.resize(queue.Size, false);
+    for (const ShardItem& item : items)
+        keep[item.QueueIdx] = (item.Shard == shard_index);
+    int dst_n = 0;
+    for (int src_n = 0; src_n < queue.Size; src_n++)
+    {
+        if (keep[src_n])
+            queue[dst_n++] = queue[src_n];
+        else if (queue[src_n].Test->Output.Status == ImGuiTestStatus_Queued)
+            queue[src_n].Test->Output.Status = ImGuiTestStatus_Unknown;
+    }
+    queue.resize(dst_n);
+    return (float)shard_loads[shard_index];
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] LOG OUTPUT
+//-------------------------------------------------------------------------
+// - ImGuiTestEngine_LogOutputWriteDirect() [Internal]
+// - ImGuiTestEngine_LogOutputThreadMain() [Internal]
+// - ImGuiTestEngine_LogOutputQueueCreate()
+// - ImGuiTestEngine_LogOutputQueueDestroy()
+// - ImGuiTestEngine_LogOutputQueuePush()
+// - ImGuiTestEngine_LogOutputQueueFlush()
+// - ImGuiTestEngine_LogOutputWrite()
+// - ImGuiTestEngine_LogOutputFlush()
+// - ImGuiTestEngine_LogOutputFlushFromCrashHandler() [Internal]
+// - ImGuiTestEngine_LogOutputShutdown() [Internal]
+//-------------------------------------------------------------------------
+// Writing to stdout may block for a long time when it is piped into a slow consumer (typically on CI),
+// which would otherwise stall the test thread and pollute perf measurements. When IO.ConfigLogAsync is
+// enabled, lines are appended to a bounded queue and written by a background thread instead.
+// - When the queue is full, Info/Debug/Trace lines are dropped (and the number of dropped lines reported),
+//   while Warning/Error lines block until there is room, as we never want to lose those.
+// - The queue is double-buffered: the writer thread swaps buffers and performs I/O without holding the lock.
+// - Only lines going through ImGuiTestEngine_LogOutputWrite() are ordered with each other: direct writes to stdout
+//   (e.g. capture tool messages, application output) may appear before previously queued lines. Hence disabled by default
+//   (test suite enables it with -log-async, as used on CI and for perf runs).
+//-------------------------------------------------------------------------
+
+struct ImGuiTestLogOutputRecord
+{
+    ImGuiTestLogOutput          Output;
+    ImGuiTestVerboseLevel       Level;
+    int                         TextOffset;                     // Offset into text buffer. Text is zero-terminated.
+};
+
+struct ImGuiTestLogOutputQueue
+{
+    std::mutex                  Mutex;
+    std::condition_variable     CondPending;                    // Signaled when records are queued or exit is requested
+    std::condition_variable     CondWritten;                    // Signaled when writer thread has written a batch
+    std::thread                 Thread;
+    ImVector<char>              PendingText;                    // Protected by Mutex
+    ImVector<ImGuiTestLogOutputRecord> PendingRecords;          // Protected by Mutex
+    ImVector<char>              WritingText;                    // Only accessed by writer thread
+    ImVector<ImGuiTestLogOutputRecord> WritingRecords;          // Only accessed by writer thread
+    int                         WritingIndex = 0;               // Index of record being written in WritingRecords. Only accessed by writer thread (and crash handler running on it)
+    std::atomic<int>            QueuedCount;                    // Total number of records queued (only compared against WrittenCount)
+    std::atomic<int>            WrittenCount;                   // Total number of records written
+    int                         DroppedCount = 0;               // Number of lines dropped since last report. Protected by Mutex
+    int                         Capacity = 1024 * 1024;         // Max bytes of pending text
+    bool                        ExitRequested = false;          // Protected by Mutex
+    ImGuiTextBuffer*            RedirectBuf = NULL;             // Testing: append TTY output here instead of writing to stdout. Only accessed by writer thread.
+    int                         WriteDelayMs = 0;               // Testing: simulate a slow console
+
+    ImGuiTestLogOutputQueue() { QueuedCount = WrittenCount = 0; }
+};
+
+static void ImGuiTestEngine_LogOutputWriteDirect(ImGuiTestLogOutput output, ImGuiTestVerboseLevel level, const char* message, const char* message_end)
+{
+    if (output == ImGuiTestLogOutput_TTY)
+    {
+        switch (level)
+        {
+        case ImGuiTestVerboseLevel_Warning:
+            ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_BrightYellow);
+            break;
+        case ImGuiTestVerboseLevel_Error:
+            ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_BrightRed);
+            break;
+        default:
+            ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
+            break;
+        }
+        if (message_end)
+            fprintf(stdout, "%.*s", (int)(message_end - message), message);
+        else
+            fprintf(stdout, "%s", message);
+        ImOsConsoleSetTextColor(ImOsConsoleStream_StandardOutput, ImOsConsoleTextColor_White);
+    }
+    else if (output == ImGuiTestLogOutput_Debugger)
+    {
+        IM_ASSERT(message_end == NULL || *message_end == 0);
+        switch (level)
+        {
+        default:
+            break;
+        case ImGuiTestVerboseLevel_Error:
+            ImOsOutputDebugString("[error] ");
+            break;
+        case ImGuiTestVerboseLevel_Warning:
+            ImOsOutputDebugString("[warn.] ");
+            break;
+        case ImGuiTestVerboseLevel_Info:
+            ImOsOutputDebugString("[info ] ");
+            break;
+        case ImGuiTestVerboseLevel_Debug:
+            ImOsOutputDebugString("[debug] ");
+            break;
+        case ImGuiTestVerboseLevel_Trace:
+            ImOsOutputDebugString("[trace] ");
+            break;
+        }
+        ImOsOutputDebugString(message);
+    }
+}
+
+static void ImGuiTestEngine_LogOutputWriteRecords(ImGuiTestLogOutputQueue* queue, ImVector<ImGuiTestLogOutputRecord>& records, ImVector<char>& text, int* p_index)
+{
+    for (; *p_index < records.Size; (*p_index)++)
+    {
+        const ImGuiTestLogOutputRecord& record = records[*p_index];
+        if (queue->WriteDelayMs > 0)
+            ImThreadSleepInMilliseconds(queue->WriteDelayMs);
+        if (queue->RedirectBuf == NULL)
+            ImGuiTestEngine_LogOutputWriteDirect(record.Output, record.Level, text.Data + record.TextOffset, NULL);
+        else if (record.Output == ImGuiTestLogOutput_TTY)
+            queue->RedirectBuf->append(text.Data + record.TextOffset);
+    }
+    if (queue->RedirectBuf == NULL)
+        fflush(stdout);
+}
+
+static void ImGuiTestEngine_LogOutputThreadMain(ImGuiTestLogOutputQueue* queue)
+{
+    ImThreadSetCurrentThreadDescription("Dear ImGui Test Engine Log Output");
+
+    std::unique_lock<std::mutex> lock(queue->Mutex);
+    while (true)
+    {
+        queue->CondPending.wait(lock, [queue]() { return queue->ExitRequested || !queue->PendingRecords.empty(); });
+        if (queue->PendingRecords.empty())
+            break; // ExitRequested and nothing left to write
+
+        // Grab pending batch and perform I/O without holding the lock
+        queue->PendingText.swap(queue->WritingText);
+        queue->PendingRecords.swap(queue->WritingRecords);
+        lock.unlock();
+        queue->CondWritten.notify_all(); // Wake up producers waiting for room
+
+        queue->WritingIndex = 0;
+        ImGuiTestEngine_LogOutputWriteRecords(queue, queue->WritingRecords, queue->WritingText, &queue->WritingIndex);
+        const int written_count = queue->WritingRecords.Size;
+        queue->WritingText.resize(0);
+        queue->WritingRecords.resize(0);
+        queue->WritingIndex = 0;
+
+        lock.lock();
+        queue->WrittenCount += written_count;
+        queue->CondWritten.notify_all();
+    }
+}
+
+static void ImGuiTestEngine_LogOutputPushRecord(ImGuiTestLogOutputQueue* queue, ImGuiTestLogOutput output, ImGuiTestVerboseLevel level, const char* text, int text_len)
+{
+    ImGuiTestLogOutputRecord record;
+    record.Output = output;
+    record.Level = level;
+    record.TextOffset = queue->PendingText.Size;
+    queue->PendingText.resize(queue->PendingText.Size + text_len + 1);
+    memcpy(queue->PendingText.Data + record.TextOffset, text, (size_t)text_len);
+    queue->PendingText.Data[record.TextOffset + text_len] = 0;
+    queue->PendingRecords.push_back(record);
+    queue->QueuedCount++;
+}
+
+ImGuiTestLogOutputQueue* ImGuiTestEngine_LogOutputQueueCreate(int capacity, ImGuiTextBuffer* redirect_buf, int write_delay_ms)
+{
+    ImGuiTestLogOutputQueue* queue = IM_NEW(ImGuiTestLogOutputQueue)();
+    if (capacity > 0)
+        queue->Capacity = capacity;
+    queue->RedirectBuf = redirect_buf;
+    queue->WriteDelayMs = write_delay_ms;
+    queue->Thread = std::thread(ImGuiTestEngine_LogOutputThreadMain, queue);
+    return queue;
+}
+
+// Write remaining lines, stop writer thread and destroy queue
+void ImGuiTestEngine_LogOutputQueueDestroy(ImGuiTestLogOutputQueue* queue)
+{
+    {
+        std::unique_lock<std::mutex> lock(queue->Mutex);
+        queue->ExitRequested = true;
+    }
+    queue->CondPending.notify_one();
+    queue->Thread.join();
+    IM_DELETE(queue);
+}
+
+void ImGuiTestEngine_LogOutputQueuePush(ImGuiTestLogOutputQueue* queue, ImGuiTestLogOutput output, ImGuiTestVerboseLevel level, const char* message, const char* message_end)
+{
+    const int message_len = message_end ? (int)(message_end - message) : (int)strlen(message);
+    {
+        std::unique_lock<std::mutex> lock(queue->Mutex);
+        if (queue->PendingText.Size + message_len + 1 > queue->Capacity && !queue->PendingRecords.empty())
+        {
+            if (level > ImGuiTestVerboseLevel_Warning)
+            {
+                queue->DroppedCount++;
+                return;
+            }
+            queue->CondWritten.wait(lock, [queue, message_len]() { return queue->PendingRecords.empty() || queue->PendingText.Size + message_len + 1 <= queue->Capacity; });
+        }
+        if (queue->DroppedCount > 0 && output == ImGuiTestLogOutput_TTY)
+        {
+            char buf[64];
+            int buf_len = ImFormatString(buf, IM_ARRAYSIZE(buf), "(%d log lines dropped: console output too slow)\n", queue->DroppedCount);
+            ImGuiTestEngine_LogOutputPushRecord(queue, ImGuiTestLogOutput_TTY, ImGuiTestVerboseLevel_Warning, buf, buf_len);
+            queue->DroppedCount = 0;
+        }
+        ImGuiTestEngine_LogOutputPushRecord(queue, output, level, message, message_len);
+    }
+    queue->CondPending.notify_one();
+}
+
+void ImGuiTestEngine_LogOutputQueueFlush(ImGuiTestLogOutputQueue* queue)
+{
+    std::unique_lock<std::mutex> lock(queue->Mutex);
+    queue->CondWritten.wait(lock, [queue]() { return queue->WrittenCount == queue->QueuedCount; });
+}
+
+void ImGuiTestEngine_LogOutputWrite(ImGuiTestEngine* engine, ImGuiTestLogOutput output, ImGuiTestVerboseLevel level, const char* message, const char* message_end)
+{
+    if (!engine->IO.ConfigLogAsync && engine->LogOutputQueue == NULL)
+    {
+        ImGuiTestEngine_LogOutputWriteDirect(output, level, message, message_end);
+        if (output == ImGuiTestLogOutput_TTY)
+            fflush(stdout);
+        return;
+    }
+
+    // Create queue and writer thread on first use
+    if (engine->LogOutputQueue == NULL)
+        engine->LogOutputQueue = ImGuiTestEngine_LogOutputQueueCreate(0, NULL, 0);
+    ImGuiTestEngine_LogOutputQueuePush(engine->LogOutputQueue, output, level, message, message_end);
+}
+
+void ImGuiTestEngine_LogOutputFlush(ImGuiTestEngine* engine)
+{
+    if (engine->LogOutputQueue != NULL)
+        ImGuiTestEngine_LogOutputQueueFlush(engine->LogOutputQueue);
+}
+
+// Crash handler may run on any thread, including the writer thread, or while a producer holds the lock.
+// - On writer thread: finish writing the in-flight batch, skipping the record which was being written when crashing.
+// - On other threads: give writer thread a limited time to catch up.
+// Leftovers are then grabbed under the lock. If the lock can't be acquired in time (e.g. crashing thread holds it),
+// we report the number of lost lines instead of touching the queue.
+static void ImGuiTestEngine_LogOutputFlushFromCrashHandler(ImGuiTestEngine* engine)
+{
+    ImGuiTestLogOutputQueue* queue = engine->LogOutputQueue;
+    if (queue == NULL)
+        return;
+    if (queue->Thread.get_id() == std::this_thread::get_id())
+    {
+        queue->WritingIndex++;
+        ImGuiTestEngine_LogOutputWriteRecords(queue, queue->WritingRecords, queue->WritingText, &queue->WritingIndex);
+    }
+    else
+    {
+        for (int n = 0; n < 1000 && queue->WrittenCount != queue->QueuedCount; n++)
+            ImThreadSleepInMilliseconds(1);
+    }
+
+    bool locked = false;
+    for (int n = 0; n < 100 && !locked; n++)
+    {
+        locked = queue->Mutex.try_lock();
+        if (!locked)
+            ImThreadSleepInMilliseconds(1);
+    }
+    if (locked)
+    {
+        ImVector<ImGuiTestLogOutputRecord> records;
+        ImVector<char> text;
+        records.swap(queue->PendingRecords);
+        text.swap(queue->PendingText);
+        queue->Mutex.unlock();
+        int index = 0;
+        ImGuiTestEngine_LogOutputWriteRecords(queue, records, text, &index);
+    }
+    else if (queue->WrittenCount != queue->QueuedCount)
+    {
+        fprintf(stdout, "(%d log lines lost: log output queue is locked)\n", queue->QueuedCount - queue->WrittenCount);
+    }
+    fflush(stdout);
+}
+
+static void ImGuiTestEngine_LogOutputShutdown(ImGuiTestEngine* engine)
+{
+    if (engine->LogOutputQueue == NULL)
+        return;
+    ImGuiTestEngine_LogOutputQueueDestroy(engine->LogOutputQueue);
+    engine->LogOutputQueue = NULL;
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] CRASH HANDLING
 //-------------------------------------------------------------------------
@@ -1806,6 +2565,12 @@ void ImGuiTestEngine_CrashHandler()
                 }
     }
 
+    // Write out queued TTY/debugger output before anything else gets printed.
+    ImGuiTestEngine_LogOutputFlushFromCrashHandler(engine);
+
+    // Write perflog entries of tests which completed before the crash.
+    ImGuiTestEngine_PerfToolFlush(engine->PerfLogPending);
+
     // Export test run results.
     ImGuiTestEngine_Export(engine);
 }
@@ -2306,7 +3071,9 @@ static void     ImGuiTestEngine_SettingsReadLine(ImGuiContext* ui_ctx, ImGuiSett
     else if (SettingsTryReadString(line, "VideoCapturePathToEncoder=", e->IO.VideoCaptureEncoderPath, IM_ARRAYSIZE(e->IO.VideoCaptureEncoderPath))) { }
     else if (SettingsTryReadString(line, "VideoCaptureParamsToEncoder=", e->IO.VideoCaptureEncoderParams, IM_ARRAYSIZE(e->IO.VideoCaptureEncoderParams))) { }
     else if (SettingsTryReadString(line, "GifCaptureParamsToEncoder=", e->IO.GifCaptureEncoderParams, IM_ARRAYSIZE(e->IO.GifCaptureEncoderParams))) { }
+    else if (sscanf(line, "GifCaptureBuiltinEncoder=%d", &n) == 1)                                                                  { e->IO.GifCaptureUseBuiltinEncoder = (n != 0); }
     else if (SettingsTryReadString(line, "VideoCaptureExtension=", e->IO.VideoCaptureExtension, IM_ARRAYSIZE(e->IO.VideoCaptureExtension))) { }
+    else if (SettingsTryReadString(line, "ImageCaptureExtension=", e->IO.ImageCaptureExtension, IM_ARRAYSIZE(e->IO.ImageCaptureExtension))) { }
 }
 
 static void     ImGuiTestEngine_SettingsWriteAll(ImGuiContext* ui_ctx, ImGuiSettingsHandler* handler, ImGuiTextBuffer* buf)
@@ -2327,7 +3094,9 @@ static void     ImGuiTestEngine_SettingsWriteAll(ImGuiContext* ui_ctx, ImGuiSett
     buf->appendf("VideoCapturePathToEncoder=%s\n", engine->IO.VideoCaptureEncoderPath);
     buf->appendf("VideoCaptureParamsToEncoder=%s\n", engine->IO.VideoCaptureEncoderParams);
     buf->appendf("GifCaptureParamsToEncoder=%s\n", engine->IO.GifCaptureEncoderParams);
+    buf->appendf("GifCaptureBuiltinEncoder=%d\n", engine->IO.GifCaptureUseBuiltinEncoder);
     buf->appendf("VideoCaptureExtension=%s\n", engine->IO.VideoCaptureExtension);
+    buf->appendf("ImageCaptureExtension=%s\n", engine->IO.ImageCaptureExtension);
     buf->appendf("\n");
 }
 
@@ -2339,9 +3108,28 @@ void ImGuiTestLog::Clear()
 {
     Buffer.clear();
     LineInfo.clear();
+    for (ImVector<int>& line_indices : LineIndicesUpToLevel)
+        line_indices.clear();
     memset(&CountPerLevel, 0, sizeof(CountPerLevel));
 }
 
+int ImGuiTestLog::GetLineCountUpToLevel(ImGuiTestVerboseLevel level_max) const
+{
+    if (level_max >= ImGuiTestVerboseLevel_Trace)
+        return LineInfo.Size;
+    if (level_max <= ImGuiTestVerboseLevel_Silent)
+        return 0;
+    return LineIndicesUpToLevel[level_max].Size;
+}
+
+ImGuiTestLogLineInfo* ImGuiTestLog::GetLineUpToLevel(ImGuiTestVerboseLevel level_max, int n)
+{
+    IM_ASSERT(n >= 0 && n < GetLineCountUpToLevel(level_max));
+    if (level_max >= ImGuiTestVerboseLevel_Trace)
+        return &LineInfo.Data[n];
+    return &LineInfo.Data[LineIndicesUpToLevel[level_max].Data[n]];
+}
+
 // Output:
 // - If 'buffer != NULL': all extracted lines are appended to 'buffer'. Use 'buffer->c_str()' on your side to obtain the text.
 // - Return value: number of lines extracted (should be equivalent to number of '\n' inside buffer->c_str()).
@@ -2364,14 +3152,18 @@ int ImGuiTestLog::ExtractLinesForVerboseLevels(ImGuiTestVerboseLevel level_min,
     }
 
     // Extract lines and return count
-    for (auto& line_info : LineInfo)
-        if (line_info.Level >= level_min && line_info.Level <= level_max)
-        {
-            const char* line_begin = Buffer.c_str() + line_info.LineOffset;
-            const char* line_end = strchr(line_begin, '\n');
-            out_buffer->append(line_begin, line_end[0] == '\n' ? line_end + 1 : line_end);
-            count++;
-        }
+    // (walk index of lines <= level_max so we don't visit lines we'll filter out. Lines are never stored at ImGuiTestVerboseLevel_Silent.)
+    const int line_count = GetLineCountUpToLevel(level_max);
+    for (int line_n = 0; line_n < line_count; line_n++)
+    {
+        const ImGuiTestLogLineInfo* line_info = GetLineUpToLevel(level_max, line_n);
+        if (line_info->Level < level_min)
+            continue;
+        const char* line_begin = Buffer.c_str() + line_info->LineOffset;
+        const char* line_end = line_begin + line_info->LineSize;
+        out_buffer->append(line_begin, line_end[0] == '\n' ? line_end + 1 : line_end);
+        count++;
+    }
     return count;
 }
 
@@ -2379,6 +3171,7 @@ void ImGuiTestLog::UpdateLineOffsets(ImGuiTestEngineIO* engine_io, ImGuiTestVerb
 {
     IM_UNUSED(engine_io);
     IM_ASSERT(Buffer.begin() <= start && start < Buffer.end());
+    IM_ASSERT(level > ImGuiTestVerboseLevel_Silent && level < ImGuiTestVerboseLevel_COUNT);
     const char* p_begin = start;
     const char* p_end = Buffer.end();
     const char* p = p_begin;
@@ -2390,8 +3183,14 @@ void ImGuiTestLog::UpdateLineOffsets(ImGuiTestEngineIO* engine_io, ImGuiTestVerb
         bool last_empty_line = (p_bol + 1 == p_end);
         if (!last_empty_line)
         {
-            int offset = (int)(p_bol - Buffer.c_str());
-            LineInfo.push_back({level, offset});
+            ImGuiTestLogLineInfo line_info;
+            line_info.Level = level;
+            line_info.LineOffset = (int)(p_bol - Buffer.c_str());
+            line_info.LineSize = (int)((p_eol ? p_eol : p_end) - p_bol);
+            line_info.LinkFlags = ImGuiTestLogLineLinkFlags_None;
+            for (int n = level; n < ImGuiTestVerboseLevel_Trace; n++)
+                LineIndicesUpToLevel[n].push_back(LineInfo.Size);
+            LineInfo.push_back(line_info);
             CountPerLevel[level] += 1;
         }
         p = p_eol ? p_eol + 1 : NULL;
@@ -56,6 +56,7 @@ enum ImGuiTestRunSpeed : int;
 enum ImGuiTestStatus : int;
 enum ImGuiTestVerboseLevel : int;
 enum ImGuiTestEngineExportFormat : int;
+enum ImGuiPerfToolComplexity : int;     // Defined in imgui_te_perftool.h
 
 //-------------------------------------------------------------------------
 // Types
@@ -109,6 +110,16 @@ enum ImGuiTestGroup : int
     ImGuiTestGroup_COUNT
 };
 
+// Result of comparing a perf capture against a baseline perflog (see ImGuiTestEngine_LoadPerfBaseline(), stored in ImGuiTestPerfResult)
+enum ImGuiTestPerfVerdict : int
+{
+    ImGuiTestPerfVerdict_Unknown    = 0,    // No baseline loaded, or no usable baseline data for this perf test
+    ImGuiTestPerfVerdict_Unchanged  = 1,    // Difference is within noise or below ConfigPerfRegressionMinChange
+    ImGuiTestPerfVerdict_Improved   = 2,
+    ImGuiTestPerfVerdict_Regressed  = 3,    // Test is marked as failed
+    ImGuiTestPerfVerdict_COUNT
+};
+
 // Flags (stored in ImGuiTest)
 enum ImGuiTestFlags_
 {
@@ -198,6 +209,16 @@ IMGUI_API bool                ImGuiTestEngine_TryAbortEngine(ImGuiTestEngine* en
 IMGUI_API void                ImGuiTestEngine_AbortCurrentTest(ImGuiTestEngine* engine);
 IMGUI_API ImGuiTest*          ImGuiTestEngine_FindTestByName(ImGuiTestEngine* engine, const char* category, const char* name);
 
+// Functions: Sharding
+// Split queued tests across multiple processes/machines, balanced by durations of previous runs. See comments in imgui_te_engine.cpp.
+IMGUI_API bool                ImGuiTestEngine_LoadTestDurations(ImGuiTestEngine* engine, const char* filename);
+IMGUI_API bool                ImGuiTestEngine_SaveTestDurations(ImGuiTestEngine* engine, const char* filename);
+IMGUI_API float               ImGuiTestEngine_ShardTestQueue(ImGuiTestEngine* engine, int shard_index, int shard_count); // Keep queued tests assigned to 'shard_index' (0-based). Return estimated shard duration.
+
+// Functions: Perf Regressions
+// Once a baseline perflog is loaded, each PerfCapture() is compared against baseline entries of same test. Perf tests regressing beyond noise are marked as failed.
+IMGUI_API bool                ImGuiTestEngine_LoadPerfBaseline(ImGuiTestEngine* engine, const char* filename);
+
 // Functions: Status Queries
 // FIXME: Clarify API to avoid function calls vs raw bools in ImGuiTestEngineIO
 IMGUI_API bool                ImGuiTestEngine_IsTestQueueEmpty(ImGuiTestEngine* engine);
@@ -243,12 +264,27 @@ struct IMGUI_API ImGuiTestEngineIO
     ImGuiTestVerboseLevel       ConfigVerboseLevelOnError = ImGuiTestVerboseLevel_Info;
     bool                        ConfigLogToTTY = false;
     bool                        ConfigLogToDebugger = false;
+    bool                        ConfigLogAsync = false;             // Write TTY/debugger log output from a background thread, so a slow console can't stall the test thread. Flushed on ImGuiTestEngine_Stop() and by crash handler. Other writes to stdout (e.g. capture tool, application) are not ordered with queued lines. Test suite: -log-async.
     bool                        ConfigRestoreFocusAfterTests = true;// Restore focus back after running tests
     bool                        ConfigCaptureEnabled = true;        // Master enable flags for capturing and saving captures. Disable to avoid e.g. lengthy saving of large PNG files.
     bool                        ConfigCaptureOnError = false;
+    bool                        ConfigCaptureUpdateReferences = false;  // CaptureCheckReference(): save capture as new reference when reference is missing or doesn't match, instead of failing.
     bool                        ConfigNoThrottle = false;           // Disable vsync for performance measurement or fast test running
     bool                        ConfigMouseDrawCursor = true;       // Enable drawing of Dear ImGui software mouse cursor when running tests
     float                       ConfigFixedDeltaTime = 0.0f;        // Use fixed delta time instead of calculating it from wall clock
+    bool                        ConfigPerfCounters = false;         // Record hardware performance counters (instructions, cycles, cache/branch misses) in PerfCapture(). Linux only.
+    float                       ConfigPerfRegressionConfidence = 0.99f; // Statistical confidence required to report a perf regression/improvement vs baseline (see ImGuiTestEngine_LoadPerfBaseline())
+    float                       ConfigPerfRegressionMinChange = 0.05f;  // Minimum relative change vs baseline to report a perf regression/improvement (0.05f = 5%)
+    bool                        ConfigPerfAdaptiveIterations = false;   // Calibrate number of frames measured by PerfCapture() instead of using ctx->PerfIterations: warm up until stable, then sample until target precision or time budget is reached.
+    float                       ConfigPerfTargetPrecision = 0.01f;      // Adaptive iterations: stop when 95% confidence interval of result is within +/- this fraction of measured frame time (0.01f = 1%),
+    float                       ConfigPerfTargetPrecisionMs = 0.01f;    // ... or within +/- this amount of milliseconds.
+    float                       ConfigPerfTimeBudget = 10.0f;           // Adaptive iterations: maximum time (in seconds) spent in one measurement, including warm-up.
+    int                         ConfigPerfScalingSteps = 0;             // Scaling-curve mode: run TestFunc of perf tests this many times, doubling stress amount every time starting from PerfStressAmount, then fit results to complexity classes. PerfStressAmount << (steps - 1) must fit in an int. Results are stored in IMGUI_PERFLOG_SCALING_FILENAME. 0 to disable.
+    bool                        ConfigPerfControlledEnv = false;        // Pin main and test threads to a single CPU and warm up the CPU before first perf test of a batch, to reduce noise. Linux only. Environment fingerprint is recorded in perflog regardless.
+    int                         ConfigPerfAffinityCpu = -1;             // Controlled environment: CPU to pin threads to. -1 to use the last CPU the process is allowed to run on.
+    float                       ConfigPerfWarmUpTime = 2.0f;            // Controlled environment: time (in seconds) spent busy-looping before first perf test, to let CPU frequency settle.
+    bool                        ConfigPerfSampling = false;             // Sample call stacks of main thread while PerfCapture() measures, and write them to one folded-stack file per perf test in a "perf_stacks" folder next to the perflog. Linux only.
+    int                         ConfigPerfSamplingFrequency = 997;      // Call stack samples per second of main thread CPU time. A prime number avoids sampling in lockstep with periodic work.
     int                         PerfStressAmount = 1;               // Integer to scale the amount of items submitted in test
     char                        GitBranchName[64] = "";             // e.g. fill in branch name (e.g. recorded in perf samples .csv)
 
@@ -264,7 +300,13 @@ struct IMGUI_API ImGuiTestEngineIO
     char                        VideoCaptureEncoderPath[256] = "";  // Video encoder executable path, e.g. "path/to/ffmpeg.exe".
     char                        VideoCaptureEncoderParams[256] = "";// Video encoder parameters for .MP4 captures, e.g. see IMGUI_CAPTURE_DEFAULT_VIDEO_PARAMS_FOR_FFMPEG
     char                        GifCaptureEncoderParams[512] = "";  // Video encoder parameters for .GIF captures, e.g. see IMGUI_CAPTURE_DEFAULT_GIF_PARAMS_FOR_FFMPEG
+    bool                        GifCaptureUseBuiltinEncoder = true; // Encode .GIF captures in-process, without video encoder. Much faster. Disable to use VideoCaptureEncoderPath + GifCaptureEncoderParams.
+    bool                        VideoCaptureDamageTracking = false; // Only read back regions of video frames which changed according to draw data. Only enable when all recorded contents are rendered by Dear ImGui (no 3D scene, no textures updated in place).
     char                        VideoCaptureExtension[8] = ".mp4";  // Video file extension (default, may be overridden by test).
+    char                        ImageCaptureExtension[8] = ".png";  // Screenshot file extension (default, may be overridden by test): ".png", or ".tga"/".bmp" which are much faster to save but larger.
+    int                         ImageCapturePngCompressionLevel = 8;// PNG compression level (>= 5). Higher is smaller and slower.
+    int                         ImageCapturePngFilter = -1;         // PNG filter, see ImGuiCapturePngFilter_. -1 = adaptive (smaller, slower), 2 = Up (faster).
+    char                        ImageCaptureStorePath[256] = "";    // Content-addressed store for screenshots, e.g. "output/captures_store". Identical images are encoded once and hard-linked. Empty to disable.
 
     // Options: Watchdog. Set values to FLT_MAX to disable.
     // Interactive GUI applications that may be slower tend to use higher values.
@@ -276,6 +318,7 @@ struct IMGUI_API ImGuiTestEngineIO
     // While you can manually call ImGuiTestEngine_Export(), registering filename/format here ensure the crash handler will always export if application crash.
     const char*                 ExportResultsFilename = NULL;
     ImGuiTestEngineExportFormat ExportResultsFormat = (ImGuiTestEngineExportFormat)0;
+    bool                        ConfigExportKeepLogs = true;        // Keep log of each test after it has been written to export file (displayed by UI). Disable in non-interactive runs so memory doesn't grow with number of tests.
 
     // Options: Sanity Checks
     bool                        CheckDrawDataIntegrity = false;     // Check ImDrawData integrity (buffer count, etc.). Currently cheap but may become a slow operation.
@@ -339,12 +382,24 @@ struct IMGUI_API ImGuiTestLogLineInfo
 {
     ImGuiTestVerboseLevel           Level;
     int                             LineOffset;
+    int                             LineSize;               // Size of line, not including trailing '\n'
+    int                             LinkFlags;              // [Internal] Cached result of parsing line for links to files. Lazily filled by UI, see ImGuiTestLogLineLinkFlags_
+};
+
+// [Internal] Links detected in a log line (e.g. " filename:number " or "path/to/capture.png"), cached in ImGuiTestLogLineInfo::LinkFlags
+enum ImGuiTestLogLineLinkFlags_
+{
+    ImGuiTestLogLineLinkFlags_None          = 0,
+    ImGuiTestLogLineLinkFlags_Parsed        = 1 << 0,       // Line has been parsed, other flags are valid
+    ImGuiTestLogLineLinkFlags_SourceFile    = 1 << 1,
+    ImGuiTestLogLineLinkFlags_ImageFile     = 1 << 2,       // .png, .tga, .bmp, .gif or .mp4
 };
 
 struct IMGUI_API ImGuiTestLog
 {
     ImGuiTextBuffer                 Buffer;
     ImVector<ImGuiTestLogLineInfo>  LineInfo;
+    ImVector<int>                   LineIndicesUpToLevel[ImGuiTestVerboseLevel_COUNT]; // [level] = indices into LineInfo[] of lines with Level <= level. Left empty for Trace (would be identity).
     int                             CountPerLevel[ImGuiTestVerboseLevel_COUNT] = {};
 
     // Functions
@@ -352,6 +407,10 @@ struct IMGUI_API ImGuiTestLog
     bool    IsEmpty() const         { return Buffer.empty(); }
     void    Clear();
 
+    // Random access to lines with a verbose level <= level_max, in O(1).
+    int                     GetLineCountUpToLevel(ImGuiTestVerboseLevel level_max) const;
+    ImGuiTestLogLineInfo*   GetLineUpToLevel(ImGuiTestVerboseLevel level_max, int n);
+
     // Extract log contents filtered per log-level.
     // Output:
     // - If 'buffer != NULL': all extracted lines are appended to 'buffer'. Use 'buffer->c_str()' on your side to obtain the text.
@@ -379,6 +438,38 @@ typedef void    (ImGuiTestVarsConstructor)(void* buffer);
 typedef void    (ImGuiTestVarsPostConstructor)(ImGuiTestContext* ctx, void* ptr, void* fn);
 typedef void    (ImGuiTestVarsDestructor)(void* ptr);
 
+// Result of one ImGuiTestContext::PerfCapture() call (a test may capture more than one)
+struct IMGUI_API ImGuiTestPerfResult
+{
+    char                            Name[128] = "";                 // Perf test name as recorded in perflog
+    double                          DtDeltaMs = 0.0;                // Average delta time added by GuiFunc, compared to reference
+    double                          DtRefMs = 0.0;                  // Reference delta time (GuiFunc disabled)
+    double                          DtDeltaMsMedian = 0.0;          // Distribution of per-frame delta times
+    double                          DtDeltaMsP90 = 0.0;
+    double                          DtDeltaMsP99 = 0.0;
+    double                          DtDeltaMsStdDev = 0.0;
+    double                          CpuGuiFuncMs = 0.0;             // Median CPU time per frame spent in: test GuiFunc()
+    double                          CpuNewFrameMs = 0.0;            // " ImGui::NewFrame()
+    double                          CpuEndFrameMs = 0.0;            // " ImGui::EndFrame()
+    double                          CpuRenderMs = 0.0;              // " ImGui::Render()
+    double                          CpuEngineMs = 0.0;              // " Test engine hooks and test coroutine
+    double                          HwInstructions = -1.0;          // Median hardware counter per frame, -1.0 when not available (see ImGuiTestEngineIO::ConfigPerfCounters)
+    double                          HwCycles = -1.0;
+    double                          HwCacheMisses = -1.0;
+    double                          HwBranchMisses = -1.0;
+    int                             NumSamples = 0;                 // Number of measured frames
+    int                             NumWarmUpFrames = 0;            // Number of frames discarded before measuring (see ImGuiTestEngineIO::ConfigPerfAdaptiveIterations)
+    double                          DtDeltaMsError = 0.0;           // Half-width of 95% confidence interval of DtDeltaMs
+    int                             PerfStressAmount = 0;
+    ImGuiTestPerfVerdict            Verdict = ImGuiTestPerfVerdict_Unknown; // Comparison against baseline perflog (see ImGuiTestEngine_LoadPerfBaseline())
+    double                          BaselineDtDeltaMs = 0.0;
+    double                          VsBaseline = 0.0;               // Percent difference vs baseline
+    double                          Confidence = 0.0;               // Probability that result is slower than baseline
+    char                            VerdictText[256] = "";          // e.g. "Regressed +12.3% vs baseline (...)"
+    ImGuiPerfToolComplexity         ScalingComplexity = (ImGuiPerfToolComplexity)0; // Complexity fitted to results of this perf test across stress amounts (see ImGuiTestEngineIO::ConfigPerfScalingSteps), or _Unknown
+    double                          ScalingExponent = 0.0;          // Slope of log(DtDeltaMs) vs log(PerfStressAmount): ~1.0 for linear, ~2.0 for quadratic
+};
+
 // Storage for the output of a test run
 struct IMGUI_API ImGuiTestOutput
 {
@@ -386,6 +477,9 @@ struct IMGUI_API ImGuiTestOutput
     ImGuiTestLog                    Log;
     ImU64                           StartTime = 0;
     ImU64                           EndTime = 0;
+    int                             FrameCount = 0;                 // Number of frames elapsed while running test
+    int                             YieldCount = 0;                 // Number of times test yielded (including child tests)
+    ImVector<ImGuiTestPerfResult>   PerfResults;
 };
 
 // Storage for one test
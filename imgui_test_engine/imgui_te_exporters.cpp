@@ -8,6 +8,7 @@
 #include "imgui_te_exporters.h"
 #include "imgui_te_engine.h"
 #include "imgui_te_internal.h"
+#include "imgui_te_perftool.h"
 #include "thirdparty/Str/Str.h"
 
 //-------------------------------------------------------------------------
@@ -15,6 +16,42 @@
 //-------------------------------------------------------------------------
 
 static void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_file);
+static void ImGuiTestEngine_ExportJUnitXmlTestCase(ImGuiTestEngine* engine, FILE* fp, ImGuiTest* test);
+static void ImGuiTestEngine_ExportJsonLines(ImGuiTestEngine* engine, const char* output_file);
+static void ImGuiTestEngine_ExportJsonLinesBatch(ImGuiTestEngine* engine, FILE* fp);
+static void ImGuiTestEngine_ExportJsonLinesTest(ImGuiTestEngine* engine, FILE* fp, ImGuiTest* test);
+static void ImGuiTestEngine_ExportJsonLinesSummary(ImGuiTestEngine* engine, FILE* fp);
+
+//-------------------------------------------------------------------------
+// [SECTION] DATA STRUCTURES
+//-------------------------------------------------------------------------
+
+// Tests which didn't run (or were still waiting in queue when application crashed)
+static bool ImGuiTestEngine_IsSkipped(ImGuiTest* test)
+{
+    return test->Output.Status == ImGuiTestStatus_Unknown || test->Output.Status == ImGuiTestStatus_Queued;
+}
+
+// Per-testsuite (group) test statistics
+struct ImGuiTestEngineExportStats
+{
+    int         Tests = 0;
+    int         Failures = 0;
+    int         Disabled = 0;
+    double      Time = 0.0;
+
+    void Add(ImGuiTest* test)
+    {
+        ImGuiTestOutput* test_output = &test->Output;
+        Tests++;
+        if (test_output->Status == ImGuiTestStatus_Error)
+            Failures++;
+        else if (ImGuiTestEngine_IsSkipped(test))
+            Disabled++;
+        if (test_output->EndTime > test_output->StartTime)
+            Time += (double)(test_output->EndTime - test_output->StartTime) / 1000000.0;
+    }
+};
 
 //-------------------------------------------------------------------------
 // [SECTION] TEST ENGINE EXPORTER FUNCTIONS
@@ -23,6 +60,8 @@ static void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char*
 // - ImGuiTestEngine_Export()
 // - ImGuiTestEngine_ExportEx()
 // - ImGuiTestEngine_ExportJUnitXml()
+// - ImGuiTestEngine_ExportJUnitXmlTestCase()
+// - ImGuiTestEngine_ExportJsonLines()
 //-------------------------------------------------------------------------
 
 void ImGuiTestEngine_PrintResultSummary(ImGuiTestEngine* engine)
@@ -30,6 +69,48 @@ void ImGuiTestEngine_PrintResultSummary(ImGuiTestEngine* engine)
     int count_tested = 0;
     int count_success = 0;
     ImGuiTestEngine_GetResult(engine, count_tested, count_success);
+    ImGuiTestEngine_LogOutputFlush(engine); // Don't interleave with queued test log output
+
+    // Perf tests compared against a baseline perflog
+    int count_perf_changes = 0;
+    for (ImGuiTest* test : engine->TestsAll)
+        for (const ImGuiTestPerfResult& perf : test->Output.PerfResults)
+            if (perf.Verdict == ImGuiTestPerfVerdict_Regressed || perf.Verdict == ImGuiTestPerfVerdict_Improved)
+            {
+                if (count_perf_changes++ == 0)
+                    printf("\nPerf changes vs baseline:\n");
+                printf("- %s\n", perf.VerdictText);
+            }
+
+    // Perf tests run in scaling-curve mode. All results of a perf test name share same fit, print first one.
+    int count_perf_scaling = 0;
+    for (ImGuiTest* test : engine->TestsAll)
+    {
+        const ImVector<ImGuiTestPerfResult>& perf_results = test->Output.PerfResults;
+        for (int i = 0; i < perf_results.Size; i++)
+        {
+            const ImGuiTestPerfResult& perf = perf_results[i];
+            if (perf.ScalingComplexity == ImGuiPerfToolComplexity_Unknown)
+                continue;
+            bool printed = false;
+            for (int j = 0; j < i && !printed; j++)
+                printed = strcmp(perf_results[j].Name, perf.Name) == 0;
+            if (printed)
+                continue;
+            if (count_perf_scaling++ == 0)
+                printf("\nPerf scaling:\n");
+            printf("- %s: %s (time ~ N^%.2f)\n", perf.Name, ImGuiTestEngine_PerfToolGetComplexityName(perf.ScalingComplexity), perf.ScalingExponent);
+        }
+    }
+
+    // Screenshots saved through content-addressed store
+    const ImGuiCaptureContentStoreStats store_stats = engine->CaptureContext.GetContentStoreStats();
+    if (store_stats.ImagesStored + store_stats.ImagesReused > 0)
+    {
+        printf("\nCapture store: %d images reused, %d stored.\n", store_stats.ImagesReused, store_stats.ImagesStored);
+        printf("- Saved: %.1f MB of disk writes, ~%.2f s of encoding.\n", (double)store_stats.BytesReused / (1024.0 * 1024.0), store_stats.GetEncodeTimeSavedEstimate());
+        printf("- Spent: %.1f MB of disk writes, %.2f s of encoding.\n", (double)store_stats.BytesStored / (1024.0 * 1024.0), store_stats.EncodeTimeStored);
+    }
 
     if (count_success < count_tested)
     {
@@ -86,22 +167,18 @@ static void ImGuiTestEngine_ExportResultSummary(ImGuiTestEngine* engine, FILE* f
 
 static bool ImGuiTestEngine_HasAnyLogLines(ImGuiTestLog* test_log, ImGuiTestVerboseLevel level)
 {
-    for (auto& line_info : test_log->LineInfo)
-        if (line_info.Level <= level)
-            return true;
-    return false;
+    return test_log->GetLineCountUpToLevel(level) > 0;
 }
 
 static void ImGuiTestEngine_PrintLogLines(FILE* fp, ImGuiTestLog* test_log, int indent, ImGuiTestVerboseLevel level)
 {
     Str128 log_line;
-    for (auto& line_info : test_log->LineInfo)
+    const int line_count = test_log->GetLineCountUpToLevel(level);
+    for (int line_n = 0; line_n < line_count; line_n++)
     {
-        if (line_info.Level > level)
-            continue;
-        const char* line_start = test_log->Buffer.c_str() + line_info.LineOffset;
-        const char* line_end = strstr(line_start, "\n"); // FIXME: Incorrect.
-        log_line.set(line_start, line_end);
+        const ImGuiTestLogLineInfo* line_info = test_log->GetLineUpToLevel(level, line_n);
+        const char* line_start = test_log->Buffer.c_str() + line_info->LineOffset;
+        log_line.set(line_start, line_start + line_info->LineSize);
         ImStrXmlEscape(&log_line); // FIXME: Should not be here considering the function name.
 
         // Some users may want to disable indenting?
@@ -110,9 +187,15 @@ static void ImGuiTestEngine_PrintLogLines(FILE* fp, ImGuiTestLog* test_log, int
 }
 
 // Export using settings stored in ImGuiTestEngineIO
-// This is called by ImGuiTestEngine_CrashHandler().
+// This is called by ImGuiTestEngine_Stop() and ImGuiTestEngine_CrashHandler().
+// If results were streamed while tests were running, this only finalizes the stream.
 void ImGuiTestEngine_Export(ImGuiTestEngine* engine)
 {
+    if (engine->ExportStream != NULL)
+    {
+        ImGuiTestEngine_ExportStreamEnd(engine);
+        return;
+    }
     ImGuiTestEngineIO& io = engine->IO;
     ImGuiTestEngine_ExportEx(engine, io.ExportResultsFormat, io.ExportResultsFilename);
 }
@@ -126,6 +209,8 @@ void ImGuiTestEngine_ExportEx(ImGuiTestEngine* engine, ImGuiTestEngineExportForm
 
     if (format == ImGuiTestEngineExportFormat_JUnitXml)
         ImGuiTestEngine_ExportJUnitXml(engine, filename);
+    else if (format == ImGuiTestEngineExportFormat_JsonLines)
+        ImGuiTestEngine_ExportJsonLines(engine, filename);
     else
         IM_ASSERT(0);
 }
@@ -143,25 +228,12 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
     }
 
     // Per-testsuite test statistics.
-    struct
-    {
-        const char* Name     = NULL;
-        int         Tests    = 0;
-        int         Failures = 0;
-        int         Disabled = 0;
-    } testsuites[ImGuiTestGroup_COUNT];
-    testsuites[ImGuiTestGroup_Tests].Name = "tests";
-    testsuites[ImGuiTestGroup_Perfs].Name = "perfs";
-
+    ImGuiTestEngineExportStats testsuites[ImGuiTestGroup_COUNT];
+    const char* testsuites_names[ImGuiTestGroup_COUNT] = { "tests", "perfs" };
     for (int n = 0; n < engine->TestsAll.Size; n++)
     {
         ImGuiTest* test = engine->TestsAll[n];
-        auto* stats = &testsuites[test->Group];
-        stats->Tests += 1;
-        if (test->Output.Status == ImGuiTestStatus_Error)
-            stats->Failures += 1;
-        else if (test->Output.Status == ImGuiTestStatus_Unknown)
-            stats->Disabled += 1;
+        testsuites[test->Group].Add(test);
     }
 
     // Attributes for <testsuites> tag.
@@ -186,11 +258,11 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
     {
         // Attributes for <testsuite> tag.
         auto* testsuite = &testsuites[testsuite_id];
-        float testsuite_time = testsuites_time;         // FIXME: We do not differentiate between tests and perfs, they are executed in one big batch.
+        float testsuite_time = (float)testsuite->Time;  // Tests and perfs are executed in one big batch: accumulate time of tests in this suite.
         Str30 testsuite_timestamp = "";
         ImTimestampToISO8601(engine->BatchStartTime, &testsuite_timestamp);
         fprintf(fp, "  <testsuite name=\"%s\" tests=\"%d\" disabled=\"%d\" errors=\"0\" failures=\"%d\" hostname=\"\" id=\"%d\" package=\"\" skipped=\"0\" time=\"%.3f\" timestamp=\"%s\">\n",
-            testsuite->Name, testsuite->Tests, testsuite->Disabled, testsuite->Failures, testsuite_id, testsuite_time, testsuite_timestamp.c_str());
+            testsuites_names[testsuite_id], testsuite->Tests, testsuite->Disabled, testsuite->Failures, testsuite_id, testsuite_time, testsuite_timestamp.c_str());
 
         for (int n = 0; n < engine->TestsAll.Size; n++)
         {
@@ -198,66 +270,7 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
             if (test->Group != testsuite_id)
                 continue;
 
-            ImGuiTestOutput* test_output = &test->Output;
-            ImGuiTestLog* test_log = &test_output->Log;
-
-            // Attributes for <testcase> tag.
-            const char* testcase_name = test->Name;
-            const char* testcase_classname = test->Category;
-            const char* testcase_status = ImGuiTestEngine_GetStatusName(test_output->Status);
-            const float testcase_time = (float)((double)(test_output->EndTime - test_output->StartTime) / 1000000.0);
-
-            fprintf(fp, "    <testcase name=\"%s\" assertions=\"0\" classname=\"%s\" status=\"%s\" time=\"%.3f\">\n",
-                testcase_name, testcase_classname, testcase_status, testcase_time);
-
-            if (test_output->Status == ImGuiTestStatus_Error)
-            {
-                // Skip last error message because it is generic information that test failed.
-                Str128 log_line;
-                for (int i = test_log->LineInfo.Size - 2; i >= 0; i--)
-                {
-                    ImGuiTestLogLineInfo* line_info = &test_log->LineInfo[i];
-                    if (line_info->Level > engine->IO.ConfigVerboseLevelOnError)
-                        continue;
-                    if (line_info->Level == ImGuiTestVerboseLevel_Error)
-                    {
-                        const char* line_start = test_log->Buffer.c_str() + line_info->LineOffset;
-                        const char* line_end = strstr(line_start, "\n");
-                        log_line.set(line_start, line_end);
-                        ImStrXmlEscape(&log_line);
-                        break;
-                    }
-                }
-
-                // Failing tests save their "on error" log output in text element of <failure> tag.
-                fprintf(fp, "      <failure message=\"%s\" type=\"error\">\n", log_line.c_str());
-                ImGuiTestEngine_PrintLogLines(fp, test_log, 8, engine->IO.ConfigVerboseLevelOnError);
-                fprintf(fp, "      </failure>\n");
-            }
-
-            if (test_output->Status == ImGuiTestStatus_Unknown)
-            {
-                fprintf(fp, "      <skipped message=\"Skipped\" />\n");
-            }
-            else
-            {
-                // Succeeding tests save their default log output output as "stdout".
-                if (ImGuiTestEngine_HasAnyLogLines(test_log, engine->IO.ConfigVerboseLevel))
-                {
-                    fprintf(fp, "      <system-out>\n");
-                    ImGuiTestEngine_PrintLogLines(fp, test_log, 8, engine->IO.ConfigVerboseLevel);
-                    fprintf(fp, "      </system-out>\n");
-                }
-
-                // Save error messages as "stderr".
-                if (ImGuiTestEngine_HasAnyLogLines(test_log, ImGuiTestVerboseLevel_Error))
-                {
-                    fprintf(fp, "      <system-err>\n");
-                    ImGuiTestEngine_PrintLogLines(fp, test_log, 8, ImGuiTestVerboseLevel_Error);
-                    fprintf(fp, "      </system-err>\n");
-                }
-            }
-            fprintf(fp, "    </testcase>\n");
+            ImGuiTestEngine_ExportJUnitXmlTestCase(engine, fp, test);
         }
 
         if (testsuites[testsuite_id].Disabled < testsuites[testsuite_id].Tests) // Any tests executed
@@ -301,3 +314,430 @@ void ImGuiTestEngine_ExportJUnitXml(ImGuiTestEngine* engine, const char* output_
     fclose(fp);
     fprintf(stdout, "Saved test results to '%s' successfully.\n", output_file);
 }
+
+static void ImGuiTestEngine_ExportJUnitXmlTestCase(ImGuiTestEngine* engine, FILE* fp, ImGuiTest* test)
+{
+    ImGuiTestOutput* test_output = &test->Output;
+    ImGuiTestLog* test_log = &test_output->Log;
+
+    // Attributes for <testcase> tag.
+    const char* testcase_name = test->Name;
+    const char* testcase_classname = test->Category;
+    const char* testcase_status = ImGuiTestEngine_GetStatusName(test_output->Status);
+    const float testcase_time = (float)((double)(test_output->EndTime - test_output->StartTime) / 1000000.0);
+
+    fprintf(fp, "    <testcase name=\"%s\" assertions=\"0\" classname=\"%s\" status=\"%s\" time=\"%.3f\">\n",
+        testcase_name, testcase_classname, testcase_status, testcase_time);
+
+    if (test_output->Status == ImGuiTestStatus_Error)
+    {
+        // Skip last error message because it is generic information that test failed.
+        Str128 log_line;
+        for (int i = test_log->LineInfo.Size - 2; i >= 0; i--)
+        {
+            ImGuiTestLogLineInfo* line_info = &test_log->LineInfo[i];
+            if (line_info->Level > engine->IO.ConfigVerboseLevelOnError)
+                continue;
+            if (line_info->Level == ImGuiTestVerboseLevel_Error)
+            {
+                const char* line_start = test_log->Buffer.c_str() + line_info->LineOffset;
+                log_line.set(line_start, line_start + line_info->LineSize);
+                ImStrXmlEscape(&log_line);
+                break;
+            }
+        }
+
+        // Failing tests save their "on error" log output in text element of <failure> tag.
+        fprintf(fp, "      <failure message=\"%s\" type=\"error\">\n", log_line.c_str());
+        ImGuiTestEngine_PrintLogLines(fp, test_log, 8, engine->IO.ConfigVerboseLevelOnError);
+        fprintf(fp, "      </failure>\n");
+    }
+
+    if (ImGuiTestEngine_IsSkipped(test))
+    {
+        fprintf(fp, "      <skipped message=\"Skipped\" />\n");
+    }
+    else
+    {
+        // Succeeding tests save their default log output output as "stdout".
+        if (ImGuiTestEngine_HasAnyLogLines(test_log, engine->IO.ConfigVerboseLevel))
+        {
+            fprintf(fp, "      <system-out>\n");
+            ImGuiTestEngine_PrintLogLines(fp, test_log, 8, engine->IO.ConfigVerboseLevel);
+            fprintf(fp, "      </system-out>\n");
+        }
+
+        // Save error messages as "stderr".
+        if (ImGuiTestEngine_HasAnyLogLines(test_log, ImGuiTestVerboseLevel_Error))
+        {
+            fprintf(fp, "      <system-err>\n");
+            ImGuiTestEngine_PrintLogLines(fp, test_log, 8, ImGuiTestVerboseLevel_Error);
+            fprintf(fp, "      </system-err>\n");
+        }
+    }
+    fprintf(fp, "    </testcase>\n");
+}
+
+static void ImGuiTestEngine_ExportJsonString(FILE* fp, const char* str, const char* str_end = NULL)
+{
+    fputc('"', fp);
+    for (const char* p = str; str_end ? (p < str_end) : (*p != 0); p++)
+    {
+        const unsigned char c = (unsigned char)*p;
+        switch (c)
+        {
+        case '"':   fputs("\\\"", fp); break;
+        case '\\':  fputs("\\\\", fp); break;
+        case '\n':  fputs("\\n", fp); break;
+        case '\r':  fputs("\\r", fp); break;
+        case '\t':  fputs("\\t", fp); break;
+        default:
+            if (c < 0x20)
+                fprintf(fp, "\\u%04x", c);
+            else
+                fputc(c, fp);
+            break;
+        }
+    }
+    fputc('"', fp);
+}
+
+void ImGuiTestEngine_ExportJsonLines(ImGuiTestEngine* engine, const char* output_file)
+{
+    IM_ASSERT(engine != NULL);
+    IM_ASSERT(output_file != NULL);
+
+    FILE* fp = fopen(output_file, "wb");
+    if (fp == NULL)
+    {
+        fprintf(stderr, "Writing '%s' failed.\n", output_file);
+        return;
+    }
+    ImGuiTestEngine_ExportJsonLinesBatch(engine, fp);
+    for (ImGuiTest* test : engine->TestsAll)
+        ImGuiTestEngine_ExportJsonLinesTest(engine, fp, test);
+    ImGuiTestEngine_ExportJsonLinesSummary(engine, fp);
+    fclose(fp);
+    fprintf(stdout, "Saved test results to '%s' successfully.\n", output_file);
+}
+
+static void ImGuiTestEngine_ExportJsonLinesBatch(ImGuiTestEngine* engine, FILE* fp)
+{
+    const ImBuildInfo* build_info = ImBuildGetCompilationInfo();
+    const ImU64 start_time = engine->BatchStartTime ? engine->BatchStartTime : ImTimeGetInMicroseconds();
+    Str30 timestamp = "";
+    ImTimestampToISO8601(start_time, &timestamp);
+    fprintf(fp, "{\"type\":\"batch\",\"start_time\":%llu,\"timestamp\":\"%s\",\"git_branch\":", (unsigned long long)start_time, timestamp.c_str());
+    ImGuiTestEngine_ExportJsonString(fp, engine->IO.GitBranchName);
+    fprintf(fp, ",\"build_type\":\"%s\",\"cpu\":\"%s\",\"os\":\"%s\",\"compiler\":\"%s\",\"build_date\":\"%s\",\"perf_stress_amount\":%d,\"environment\":",
+        build_info->Type, build_info->Cpu, build_info->OS, build_info->Compiler, build_info->Date, engine->IO.PerfStressAmount);
+    ImGuiTestEngine_ExportJsonString(fp, engine->PerfEnv.Fingerprint);
+    fprintf(fp, ",\"load_average\":%.2f}\n", engine->PerfEnv.LoadAverage);
+}
+
+static void ImGuiTestEngine_ExportJsonLinesTest(ImGuiTestEngine* engine, FILE* fp, ImGuiTest* test)
+{
+    ImGuiTestOutput* test_output = &test->Output;
+    ImGuiTestLog* test_log = &test_output->Log;
+    const double test_time = (test_output->EndTime > test_output->StartTime) ? (double)(test_output->EndTime - test_output->StartTime) / 1000000.0 : 0.0;
+
+    fprintf(fp, "{\"type\":\"test\",\"category\":");
+    ImGuiTestEngine_ExportJsonString(fp, test->Category);
+    fprintf(fp, ",\"name\":");
+    ImGuiTestEngine_ExportJsonString(fp, test->Name);
+    fprintf(fp, ",\"group\":\"%s\",\"status\":\"%s\",\"skipped\":%s,\"arg_variant\":%d",
+        (test->Group == ImGuiTestGroup_Perfs) ? "perfs" : "tests", ImGuiTestEngine_GetStatusName(test_output->Status),
+        ImGuiTestEngine_IsSkipped(test) ? "true" : "false", test->ArgVariant);
+    if (!ImGuiTestEngine_IsSkipped(test))
+        fprintf(fp, ",\"start_time\":%llu,\"time\":%.6f,\"frames\":%d,\"yields\":%d",
+            (unsigned long long)test_output->StartTime, test_time, test_output->FrameCount, test_output->YieldCount);
+
+    // First error message (same as JUnit <failure message="">, skipping last line which is generic information that test failed)
+    if (test_output->Status == ImGuiTestStatus_Error)
+        for (int i = test_log->LineInfo.Size - 2; i >= 0; i--)
+        {
+            const ImGuiTestLogLineInfo* line_info = &test_log->LineInfo[i];
+            if (line_info->Level != ImGuiTestVerboseLevel_Error)
+                continue;
+            const char* line_start = test_log->Buffer.c_str() + line_info->LineOffset;
+            fprintf(fp, ",\"error\":");
+            ImGuiTestEngine_ExportJsonString(fp, line_start, line_start + line_info->LineSize);
+            break;
+        }
+
+    if (!test_output->PerfResults.empty())
+    {
+        fprintf(fp, ",\"perfs\":[");
+        for (const ImGuiTestPerfResult& perf : test_output->PerfResults)
+        {
+            fprintf(fp, "%s{\"name\":", (&perf == test_output->PerfResults.begin()) ? "" : ",");
+            ImGuiTestEngine_ExportJsonString(fp, perf.Name);
+            fprintf(fp, ",\"dt_delta_ms\":%.4f,\"dt_ref_ms\":%.4f,\"median_ms\":%.4f,\"p90_ms\":%.4f,\"p99_ms\":%.4f,\"stddev_ms\":%.4f,\"samples\":%d,\"warmup_frames\":%d,\"ci95_ms\":%.4f,\"stress\":%d",
+                perf.DtDeltaMs, perf.DtRefMs, perf.DtDeltaMsMedian, perf.DtDeltaMsP90, perf.DtDeltaMsP99, perf.DtDeltaMsStdDev, perf.NumSamples, perf.NumWarmUpFrames, perf.DtDeltaMsError, perf.PerfStressAmount);
+            fprintf(fp, ",\"cpu_ms\":{\"guifunc\":%.4f,\"newframe\":%.4f,\"endframe\":%.4f,\"render\":%.4f,\"engine\":%.4f}",
+                perf.CpuGuiFuncMs, perf.CpuNewFrameMs, perf.CpuEndFrameMs, perf.CpuRenderMs, perf.CpuEngineMs);
+            if (perf.HwInstructions >= 0.0 || perf.HwCycles >= 0.0)
+                fprintf(fp, ",\"counters\":{\"instructions\":%.0f,\"cycles\":%.0f,\"cache_misses\":%.0f,\"branch_misses\":%.0f}",
+                    perf.HwInstructions, perf.HwCycles, perf.HwCacheMisses, perf.HwBranchMisses);
+            if (perf.Verdict != ImGuiTestPerfVerdict_Unknown)
+            {
+                fprintf(fp, ",\"baseline\":{\"verdict\":\"%s\",\"dt_delta_ms\":%.4f,\"vs_baseline\":%.2f,\"confidence\":%.4f,\"text\":",
+                    ImGuiTestEngine_GetPerfVerdictName(perf.Verdict), perf.BaselineDtDeltaMs, perf.VsBaseline, perf.Confidence);
+                ImGuiTestEngine_ExportJsonString(fp, perf.VerdictText);
+                fprintf(fp, "}");
+            }
+            if (perf.ScalingComplexity != ImGuiPerfToolComplexity_Unknown)
+                fprintf(fp, ",\"scaling\":{\"complexity\":\"%s\",\"exponent\":%.3f}", ImGuiTestEngine_PerfToolGetComplexityName(perf.ScalingComplexity), perf.ScalingExponent);
+            fprintf(fp, "}");
+        }
+        fprintf(fp, "]");
+    }
+    fprintf(fp, "}\n");
+}
+
+static void ImGuiTestEngine_ExportJsonLinesSummary(ImGuiTestEngine* engine, FILE* fp)
+{
+    ImGuiTestEngineExportStats groups[ImGuiTestGroup_COUNT];
+    for (ImGuiTest* test : engine->TestsAll)
+        groups[test->Group].Add(test);
+
+    const ImU64 end_time = (engine->BatchEndTime > engine->BatchStartTime) ? engine->BatchEndTime : ImTimeGetInMicroseconds();
+    const double batch_time = engine->BatchStartTime ? (double)(end_time - engine->BatchStartTime) / 1000000.0 : 0.0;
+    fprintf(fp, "{\"type\":\"summary\",\"time\":%.6f", batch_time);
+    for (int group = ImGuiTestGroup_Tests; group < ImGuiTestGroup_COUNT; group++)
+    {
+        const ImGuiTestEngineExportStats& stats = groups[group];
+        fprintf(fp, ",\"%s\":{\"tests\":%d,\"success\":%d,\"failures\":%d,\"skipped\":%d,\"time\":%.6f}",
+            (group == ImGuiTestGroup_Perfs) ? "perfs" : "tests", stats.Tests, stats.Tests - stats.Failures - stats.Disabled, stats.Failures, stats.Disabled, stats.Time);
+    }
+    fprintf(fp, "}\n");
+}
+
+//-------------------------------------------------------------------------
+// [SECTION] STREAMING EXPORT
+//-------------------------------------------------------------------------
+// - ImGuiTestEngine_ExportStreamBegin()
+// - ImGuiTestEngine_ExportStreamTest()
+// - ImGuiTestEngine_ExportStreamEnd()
+// - ImGuiTestEngine_ExportStreamShutdown()
+//-------------------------------------------------------------------------
+// When IO.ExportResultsFilename is set, results are appended to the export file as each test finishes,
+// so a crash or a kill near the end of a long run still leaves a usable report. With IO.ConfigExportKeepLogs
+// disabled, log of each test is released once written, so we never hold more than one test worth of output.
+// ImGuiTestEngine_Export() then only needs to finalize the file.
+// - Export file is written per run (batch of queued tests): it is truncated when a run starts and finalized when
+//   the run ends, so re-running tests from the interactive UI doesn't append duplicate results.
+// JUnit XML:
+// - After each test we write closing tags, then seek back over them before writing the next test:
+//   the file is well-formed at all times (except while a single test is being written).
+// - Counters in <testsuites> and <testsuite> opening tags are rewritten in place. Attributes are padded to a
+//   fixed width with spaces, which is valid inside a tag.
+// - A <testsuite> is opened for the group of each test, closing previous one when group changes. Interleaved groups
+//   produce multiple <testsuite> elements with same name (accepted by JUnit consumers).
+// - Per-suite <system-out> only contains the result summary, as aggregating all logs would require keeping them.
+// JSON Lines:
+// - One line is appended per test, summary line is written when finalizing.
+//-------------------------------------------------------------------------
+
+struct ImGuiTestEngineExportStream
+{
+    ImGuiTestEngineExportFormat Format = ImGuiTestEngineExportFormat_None;
+    Str256                      Filename;
+    FILE*                       File = NULL;
+    ImU64                       StartTime = 0;
+    ImGuiStorage                ExportedTests;                      // Index of test in TestsAll -> true once written
+    bool                        Finished = false;                   // File was finalized and closed at end of run
+
+    // JUnit XML
+    long                        TestsuitesHeaderOffset = -1;        // Offset of attributes of <testsuites> tag
+    long                        TestsuiteHeaderOffset = -1;         // Offset of attributes of current <testsuite> tag, -1 if none open
+    long                        BodyEndOffset = -1;                 // Where closing tags start
+    ImGuiTestGroup              TestsuiteGroup = ImGuiTestGroup_Unknown;
+    int                         TestsuiteCount = 0;
+    ImGuiTestEngineExportStats  TestsuiteStats;
+    ImGuiTestEngineExportStats  TotalStats;
+};
+
+static const int JUNIT_XML_ATTRIBUTES_WIDTH = 240; // Fixed width of rewritable attributes in opening tags
+
+static void ImGuiTestEngine_ExportStreamJUnitXmlWriteAttributes(FILE* fp, long offset, const char* attributes)
+{
+    IM_ASSERT((int)strlen(attributes) <= JUNIT_XML_ATTRIBUTES_WIDTH);
+    fseek(fp, offset, SEEK_SET);
+    fprintf(fp, "%-*s>\n", JUNIT_XML_ATTRIBUTES_WIDTH, attributes);
+}
+
+static void ImGuiTestEngine_ExportStreamJUnitXmlUpdateHeaders(ImGuiTestEngine* engine, ImGuiTestEngineExportStream* stream)
+{
+    FILE* fp = stream->File;
+    Str512 attributes;
+
+    // <testsuites>
+    const ImGuiTestEngineExportStats& total = stream->TotalStats;
+    const double total_time = (double)(ImTimeGetInMicroseconds() - stream->StartTime) / 1000000.0;
+    attributes.setf("<testsuites disabled=\"%d\" errors=\"0\" failures=\"%d\" name=\"Dear ImGui\" tests=\"%d\" time=\"%.3f\"",
+        total.Disabled, total.Failures, total.Tests, total_time);
+    ImGuiTestEngine_ExportStreamJUnitXmlWriteAttributes(fp, stream->TestsuitesHeaderOffset, attributes.c_str());
+
+    // <testsuite>
+    if (stream->TestsuiteHeaderOffset >= 0)
+    {
+        const ImGuiTestEngineExportStats& suite = stream->TestsuiteStats;
+        Str30 testsuite_timestamp = "";
+        ImTimestampToISO8601(engine->BatchStartTime ? engine->BatchStartTime : stream->StartTime, &testsuite_timestamp);
+        attributes.setf("  <testsuite name=\"%s\" tests=\"%d\" disabled=\"%d\" errors=\"0\" failures=\"%d\" hostname=\"\" id=\"%d\" package=\"\" skipped=\"0\" time=\"%.3f\" timestamp=\"%s\"",
+            (stream->TestsuiteGroup == ImGuiTestGroup_Perfs) ? "perfs" : "tests", suite.Tests, suite.Disabled, suite.Failures, stream->TestsuiteCount - 1, suite.Time, testsuite_timestamp.c_str());
+        ImGuiTestEngine_ExportStreamJUnitXmlWriteAttributes(fp, stream->TestsuiteHeaderOffset, attributes.c_str());
+    }
+}
+
+static void ImGuiTestEngine_ExportStreamJUnitXmlCloseTestsuite(ImGuiTestEngine* engine, ImGuiTestEngineExportStream* stream)
+{
+    if (stream->TestsuiteHeaderOffset < 0)
+        return;
+    FILE* fp = stream->File;
+    fseek(fp, stream->BodyEndOffset, SEEK_SET);
+    fprintf(fp, "    <system-out>\n");
+    ImGuiTestEngine_ExportResultSummary(engine, fp, 6, stream->TestsuiteGroup);
+    fprintf(fp, "    </system-out>\n");
+    fprintf(fp, "  </testsuite>\n");
+    stream->BodyEndOffset = ftell(fp);
+    ImGuiTestEngine_ExportStreamJUnitXmlUpdateHeaders(engine, stream); // Final values for this <testsuite>
+    stream->TestsuiteHeaderOffset = -1;
+    stream->TestsuiteStats = ImGuiTestEngineExportStats();
+}
+
+static void ImGuiTestEngine_ExportStreamJUnitXmlTest(ImGuiTestEngine* engine, ImGuiTestEngineExportStream* stream, ImGuiTest* test)
+{
+    FILE* fp = stream->File;
+
+    // Open a new <testsuite> when group changes
+    if (stream->TestsuiteHeaderOffset < 0 || stream->TestsuiteGroup != test->Group)
+    {
+        ImGuiTestEngine_ExportStreamJUnitXmlCloseTestsuite(engine, stream);
+        fseek(fp, stream->BodyEndOffset, SEEK_SET);
+        stream->TestsuiteHeaderOffset = stream->BodyEndOffset;
+        stream->TestsuiteGroup = test->Group;
+        stream->TestsuiteCount++;
+        ImGuiTestEngine_ExportStreamJUnitXmlWriteAttributes(fp, stream->TestsuiteHeaderOffset, "  <testsuite");
+        stream->BodyEndOffset = ftell(fp);
+    }
+
+    // Append <testcase>, then closing tags so the file is valid until next test gets written
+    fseek(fp, stream->BodyEndOffset, SEEK_SET);
+    ImGuiTestEngine_ExportJUnitXmlTestCase(engine, fp, test);
+    stream->BodyEndOffset = ftell(fp);
+    fprintf(fp, "  </testsuite>\n</testsuites>\n");
+    stream->TestsuiteStats.Add(test);
+    stream->TotalStats.Add(test);
+    ImGuiTestEngine_ExportStreamJUnitXmlUpdateHeaders(engine, stream);
+}
+
+static void ImGuiTestEngine_ExportStreamJUnitXmlEnd(ImGuiTestEngine* engine, ImGuiTestEngineExportStream* stream)
+{
+    ImGuiTestEngine_ExportStreamJUnitXmlCloseTestsuite(engine, stream);
+    fseek(stream->File, stream->BodyEndOffset, SEEK_SET);
+    fprintf(stream->File, "</testsuites>\n");
+    ImGuiTestEngine_ExportStreamJUnitXmlUpdateHeaders(engine, stream);
+}
+
+// Called when a run starts. Discard previous run, export file will be truncated when first test finishes.
+void ImGuiTestEngine_ExportStreamBegin(ImGuiTestEngine* engine)
+{
+    ImGuiTestEngine_ExportStreamShutdown(engine);
+}
+
+// Called after each test ran. Opens export file on first call of a run.
+void ImGuiTestEngine_ExportStreamTest(ImGuiTestEngine* engine, ImGuiTest* test)
+{
+    ImGuiTestEngineIO& io = engine->IO;
+    ImGuiTestEngineExportStream* stream = engine->ExportStream;
+    if (stream != NULL && stream->Finished)
+    {
+        // Test ran outside of a run (e.g. queued after the end of a run): start a new file
+        ImGuiTestEngine_ExportStreamShutdown(engine);
+        stream = NULL;
+    }
+    if (stream == NULL)
+    {
+        if (io.ExportResultsFormat == ImGuiTestEngineExportFormat_None || io.ExportResultsFilename == NULL)
+            return;
+
+        FILE* fp = fopen(io.ExportResultsFilename, "w+b");
+        if (fp == NULL)
+        {
+            fprintf(stderr, "Writing '%s' failed.\n", io.ExportResultsFilename);
+            return;
+        }
+        stream = engine->ExportStream = IM_NEW(ImGuiTestEngineExportStream)();
+        stream->Format = io.ExportResultsFormat;
+        stream->Filename = io.ExportResultsFilename;
+        stream->File = fp;
+        stream->StartTime = engine->BatchStartTime ? engine->BatchStartTime : ImTimeGetInMicroseconds();
+
+        if (stream->Format == ImGuiTestEngineExportFormat_JUnitXml)
+        {
+            // FIXME: "errors" attribute and <error> tag in <testcase> may be supported if we have means to catch unexpected errors like assertions.
+            fprintf(fp, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n");
+            stream->TestsuitesHeaderOffset = ftell(fp);
+            ImGuiTestEngine_ExportStreamJUnitXmlWriteAttributes(fp, stream->TestsuitesHeaderOffset, "<testsuites");
+            stream->BodyEndOffset = ftell(fp);
+        }
+        else if (stream->Format == ImGuiTestEngineExportFormat_JsonLines)
+        {
+            ImGuiTestEngine_ExportJsonLinesBatch(engine, fp);
+        }
+    }
+
+    if (stream->Format == ImGuiTestEngineExportFormat_JUnitXml)
+        ImGuiTestEngine_ExportStreamJUnitXmlTest(engine, stream, test);
+    else if (stream->Format == ImGuiTestEngineExportFormat_JsonLines)
+        ImGuiTestEngine_ExportJsonLinesTest(engine, stream->File, test);
+    stream->ExportedTests.SetBool((ImGuiID)engine->TestsAll.index_from_ptr(engine->TestsAll.find(test)), true);
+    fflush(stream->File);
+    if (!io.ConfigExportKeepLogs)
+        test->Output.Log.Clear();
+}
+
+// Write remaining tests (not ran, or ran before the stream was opened) and close export file.
+// This is called at the end of a run, and by ImGuiTestEngine_Export(), therefore by ImGuiTestEngine_Stop() and
+// ImGuiTestEngine_CrashHandler() (no-op if run already ended).
+void ImGuiTestEngine_ExportStreamEnd(ImGuiTestEngine* engine)
+{
+    ImGuiTestEngineExportStream* stream = engine->ExportStream;
+    if (stream == NULL || stream->Finished)
+        return;
+
+    // Start with group of currently open <testsuite>
+    const int first_group = (stream->TestsuiteHeaderOffset >= 0) ? stream->TestsuiteGroup : ImGuiTestGroup_Tests;
+    for (int group_n = 0; group_n < ImGuiTestGroup_COUNT; group_n++)
+        for (int test_n = 0; test_n < engine->TestsAll.Size; test_n++)
+        {
+            ImGuiTest* test = engine->TestsAll[test_n];
+            if (test->Group == (first_group + group_n) % ImGuiTestGroup_COUNT && !stream->ExportedTests.GetBool((ImGuiID)test_n))
+            {
+                if (stream->Format == ImGuiTestEngineExportFormat_JUnitXml)
+                    ImGuiTestEngine_ExportStreamJUnitXmlTest(engine, stream, test);
+                else if (stream->Format == ImGuiTestEngineExportFormat_JsonLines)
+                    ImGuiTestEngine_ExportJsonLinesTest(engine, stream->File, test);
+            }
+        }
+
+    if (stream->Format == ImGuiTestEngineExportFormat_JUnitXml)
+        ImGuiTestEngine_ExportStreamJUnitXmlEnd(engine, stream);
+    else if (stream->Format == ImGuiTestEngineExportFormat_JsonLines)
+        ImGuiTestEngine_ExportJsonLinesSummary(engine, stream->File);
+
+    fclose(stream->File);
+    stream->File = NULL;
+    stream->Finished = true;
+    fprintf(stdout, "Saved test results to '%s' successfully.\n", stream->Filename.c_str());
+}
+
+// Finalize and destroy stream.
+void ImGuiTestEngine_ExportStreamShutdown(ImGuiTestEngine* engine)
+{
+    ImGuiTestEngine_ExportStreamEnd(engine);
+    IM_DELETE(engine->ExportStream);
+    engine->ExportStream = NULL;
+}
@@ -15,6 +15,10 @@
 //     test_io.ExportResultsFile = "output_file.xml";
 //     test_io.ExportResultsFormat = ImGuiTestEngineExportFormat_<...>;
 //
+// When configured this way, results are streamed to the file as each test finishes
+// (the file stays valid at all times), and finalized by ImGuiTestEngine_Stop() or
+// by the crash handler. ImGuiTestEngine_ExportEx() always writes a complete file.
+//
 // JUnit XML format
 //------------------
 // JUnit XML format described at https://llg.cubic.org/docs/junit/. Many
@@ -32,6 +36,16 @@
 //          node_modules/xunit-viewer/bin/xunit-viewer -r junit.xml -o junit.html
 //    - Open junit.html
 //
+// JSON Lines format
+//-------------------
+// One JSON object per line (https://jsonlines.org), easy to ingest at scale:
+// - First line:  {"type":"batch", ...}     build info, git branch, start time.
+// - Then:        {"type":"test", ...}      one line per test: category, name, group, status, arg_variant,
+//                                          wall time (seconds), frame count, yield count, error message,
+//                                          and "perfs" array with results of ImGuiTestContext::PerfCapture().
+// - Last line:   {"type":"summary", ...}   per-group counts and accumulated test times.
+// Lines are appended as tests finish, so a truncated file (e.g. after a crash) only lacks the last lines.
+//
 
 //-------------------------------------------------------------------------
 // Forward Declarations
@@ -47,6 +61,7 @@ enum ImGuiTestEngineExportFormat : int
 {
     ImGuiTestEngineExportFormat_None = 0,
     ImGuiTestEngineExportFormat_JUnitXml,
+    ImGuiTestEngineExportFormat_JsonLines,
 };
 
 //-------------------------------------------------------------------------
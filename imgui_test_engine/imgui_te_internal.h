@@ -13,6 +13,9 @@
 
 class Str;                          // Str<> from thirdparty/Str/Str.h
 struct ImGuiPerfTool;
+struct ImGuiPerfLogPendingEntries;
+struct ImGuiTestLogOutputQueue;     // Defined in imgui_te_engine.cpp (uses std::thread)
+struct ImGuiTestEngineExportStream; // Defined in imgui_te_exporters.cpp
 
 //-------------------------------------------------------------------------
 // DATA STRUCTURES
@@ -124,6 +127,58 @@ struct ImGuiTestInputs
     float                       HostEscDownDuration = -1.0f;    // Maintain our own DownDuration for host/backend ESC key so we can abort.
 };
 
+// [Internal] Frame phases timed by test engine hooks, to report CPU time of tested code separately from harness overhead
+enum ImGuiTestEnginePerfPhase
+{
+    ImGuiTestEnginePerfPhase_None = -1,             // Time not attributed (application code, backend rendering, swap)
+    ImGuiTestEnginePerfPhase_NewFrame,              // ImGui::NewFrame(), excluding test engine hooks
+    ImGuiTestEnginePerfPhase_GuiFunc,               // Test GuiFunc()
+    ImGuiTestEnginePerfPhase_EndFrame,              // ImGui::EndFrame()
+    ImGuiTestEnginePerfPhase_Render,                // ImGui::Render(), excluding EndFrame() and test engine hooks
+    ImGuiTestEnginePerfPhase_Engine,                // Test engine hooks, including running the test coroutine (TestFunc)
+    ImGuiTestEnginePerfPhase_COUNT
+};
+
+struct ImGuiTestEnginePerfPhases
+{
+    ImU64                       LastTime = 0;                   // Timestamp of last phase boundary (in nanoseconds)
+    double                      CurrFrame[ImGuiTestEnginePerfPhase_COUNT] = {}; // Accumulated time of current frame (in milliseconds)
+    double                      LastFrame[ImGuiTestEnginePerfPhase_COUNT] = {}; // Last completed frame (in milliseconds)
+};
+
+// [Internal] Hardware performance counters of main thread, sampled between start of NewFrame() and end of Render()
+struct ImGuiTestEnginePerfCounters
+{
+    ImPerfCounters              Counters;
+    bool                        OpenFailed = false;
+    ImU64                       FrameStart[ImPerfCounter_COUNT] = {};
+    ImU64                       LastFrame[ImPerfCounter_COUNT] = {};   // Counts of last completed frame
+};
+
+// [Internal] Call stacks of main thread sampled during PerfCapture() measurement (see ImGuiTestEngineIO::ConfigPerfSampling)
+struct ImGuiTestEnginePerfSampling
+{
+    ImSamplingProfiler          Profiler;
+    bool                        Requested = false;              // Set by PerfCapture(), profiler is started on main thread by ImGuiTestEngine_PreNewFrame()
+    bool                        StartFailed = false;
+};
+
+// [Internal] State of the machine perf tests are running on (see ImGuiTestEngineIO::ConfigPerfControlledEnv)
+struct ImGuiTestEnginePerfEnv
+{
+    int                         PinnedCpu = -1;                 // CPU threads are pinned to during current batch, or -1
+    bool                        MainThreadPinned = false;       // Main thread affinity changed, restore from MainThreadBackup.
+    bool                        TestThreadPinned = false;       // Test coroutine thread affinity changed, restore from TestThreadBackup.
+    ImThreadAffinity            MainThreadBackup;
+    ImThreadAffinity            TestThreadBackup;
+    bool                        WarmedUp = false;               // Warm-up was done for current batch
+    const char*                 Fingerprint = "";               // Environment of current batch, stored in perflog. Points into Fingerprints[].
+    double                      LoadAverage = -1.0;             // System load average over last minute at start of current batch, or -1.0
+    ImVector<char*>             Fingerprints;                   // Unique fingerprints, kept alive because perflog entries reference them
+
+    ~ImGuiTestEnginePerfEnv()   { for (char* fingerprint : Fingerprints) IM_FREE(fingerprint); }
+};
+
 // [Internal] Test Engine Context
 struct ImGuiTestEngine
 {
@@ -138,6 +193,7 @@ struct ImGuiTestEngine
     float                       OverrideDeltaTime = -1.0f;      // Inject custom delta time into imgui context to simulate clock passing faster than wall clock time.
     ImVector<ImGuiTest*>        TestsAll;
     ImVector<ImGuiTestRunTask>  TestsQueue;
+    ImGuiStorage                TestDurations;                  // Test durations (in seconds) recorded by previous runs, used by ImGuiTestEngine_ShardTestQueue()
     ImGuiTestContext*           TestContext = NULL;             // Running test context
     ImVector<ImGuiTestInfoTask*>InfoTasks;
     ImGuiTestGatherTask         GatherTask;
@@ -167,6 +223,18 @@ struct ImGuiTestEngine
     ImMovingAverage<double>     PerfDeltaTime100;
     ImMovingAverage<double>     PerfDeltaTime500;
     ImGuiPerfTool*              PerfTool = NULL;
+    ImGuiPerfTool*              PerfBaseline = NULL;                // Loaded by ImGuiTestEngine_LoadPerfBaseline()
+    ImGuiPerfLogPendingEntries* PerfLogPending = NULL;              // Binary perflog entries of current run, written at end of run
+    ImGuiTestEnginePerfPhases   PerfPhases;
+    ImGuiTestEnginePerfCounters PerfCounters;                       // Opened on first frame with IO.ConfigPerfCounters enabled
+    ImGuiTestEnginePerfEnv      PerfEnv;                            // Queried at start of every batch
+    ImGuiTestEnginePerfSampling PerfSampling;
+
+    // Log output (TTY/debugger)
+    ImGuiTestLogOutputQueue*    LogOutputQueue = NULL;              // Created on first use when IO.ConfigLogAsync is enabled
+
+    // Export
+    ImGuiTestEngineExportStream* ExportStream = NULL;               // Results of current/last run streamed to IO.ExportResultsFilename as tests finish. Finalized at end of run.
 
     // Screen/Video Capturing
     ImGuiCaptureToolUI          CaptureTool;                        // Capture tool UI
@@ -205,9 +273,29 @@ bool                ImGuiTestEngine_CaptureScreenshot(ImGuiTestEngine* engine, I
 bool                ImGuiTestEngine_CaptureBeginVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs* args);
 bool                ImGuiTestEngine_CaptureEndVideo(ImGuiTestEngine* engine, ImGuiCaptureArgs* args);
 
+// Log output (TTY/debugger)
+enum ImGuiTestLogOutput
+{
+    ImGuiTestLogOutput_TTY,
+    ImGuiTestLogOutput_Debugger,
+};
+void                ImGuiTestEngine_LogOutputWrite(ImGuiTestEngine* engine, ImGuiTestLogOutput output, ImGuiTestVerboseLevel level, const char* message, const char* message_end = NULL);
+void                ImGuiTestEngine_LogOutputFlush(ImGuiTestEngine* engine);    // Block until all queued output has been written
+ImGuiTestLogOutputQueue* ImGuiTestEngine_LogOutputQueueCreate(int capacity, ImGuiTextBuffer* redirect_buf, int write_delay_ms); // Standalone queue (used by engine when IO.ConfigLogAsync is enabled, and by tests). 0 = default capacity. 'redirect_buf' != NULL: append TTY output there instead of stdout
+void                ImGuiTestEngine_LogOutputQueueDestroy(ImGuiTestLogOutputQueue* queue);
+void                ImGuiTestEngine_LogOutputQueuePush(ImGuiTestLogOutputQueue* queue, ImGuiTestLogOutput output, ImGuiTestVerboseLevel level, const char* message, const char* message_end = NULL);
+void                ImGuiTestEngine_LogOutputQueueFlush(ImGuiTestLogOutputQueue* queue);
+
+// Export
+void                ImGuiTestEngine_ExportStreamBegin(ImGuiTestEngine* engine);                     // Start of a run: discard previous run results
+void                ImGuiTestEngine_ExportStreamTest(ImGuiTestEngine* engine, ImGuiTest* test);     // Append test results to export file (opened on first call of a run)
+void                ImGuiTestEngine_ExportStreamEnd(ImGuiTestEngine* engine);                       // End of a run: append remaining tests and close export file
+void                ImGuiTestEngine_ExportStreamShutdown(ImGuiTestEngine* engine);                  // Finalize and destroy stream
+
 // Helper functions
 const char*         ImGuiTestEngine_GetStatusName(ImGuiTestStatus v);
 const char*         ImGuiTestEngine_GetRunSpeedName(ImGuiTestRunSpeed v);
 const char*         ImGuiTestEngine_GetVerboseLevelName(ImGuiTestVerboseLevel v);
+const char*         ImGuiTestEngine_GetPerfVerdictName(ImGuiTestPerfVerdict v);
 
 //-------------------------------------------------------------------------
@@ -19,7 +19,9 @@ Index of this file:
 // * Entry: information about execution of a single perf test. This corresponds to one line in CSV file.
 // * Batch: a group of entries that were created together during a single execution. A new batch is created each time
 //   one or more perf tests are executed. All entries in a single batch will have a matching ImGuiPerflogEntry::Timestamp.
-// * Build: A group of batches that have matching BuildType, OS, Cpu, Compiler, GitBranchName.
+// * Build: A group of batches that have matching BuildType, OS, Cpu, Compiler, GitBranchName, Environment.
+// * Group: a cached range of sorted entries which will be aggregated into one batch when displayed (a batch, or a whole
+//   build when combining by build info).
 // * Baseline: A batch that we are comparing against. Baselines are identified by batch timestamp and build id.
 
 //-------------------------------------------------------------------------
@@ -60,6 +62,24 @@ void ImGuiPerfToolEntry::Set(const ImGuiPerfToolEntry& other)
     DtDeltaMs = other.DtDeltaMs;
     DtDeltaMsMin = other.DtDeltaMsMin;
     DtDeltaMsMax = other.DtDeltaMsMax;
+    DtDeltaMsMedian = other.DtDeltaMsMedian;
+    DtDeltaMsP90 = other.DtDeltaMsP90;
+    DtDeltaMsP99 = other.DtDeltaMsP99;
+    DtDeltaMsStdDev = other.DtDeltaMsStdDev;
+    DtDeltaMsIqm = other.DtDeltaMsIqm;
+    DtDeltaMsFrameMin = other.DtDeltaMsFrameMin;
+    DtDeltaMsFrameMax = other.DtDeltaMsFrameMax;
+    NumFrames = other.NumFrames;
+    CpuGuiFuncMs = other.CpuGuiFuncMs;
+    CpuNewFrameMs = other.CpuNewFrameMs;
+    CpuEndFrameMs = other.CpuEndFrameMs;
+    CpuRenderMs = other.CpuRenderMs;
+    CpuEngineMs = other.CpuEngineMs;
+    NumCpuFrames = other.NumCpuFrames;
+    HwInstructions = other.HwInstructions;
+    HwCycles = other.HwCycles;
+    HwCacheMisses = other.HwCacheMisses;
+    HwBranchMisses = other.HwBranchMisses;
     NumSamples = other.NumSamples;
     PerfStressAmount = other.PerfStressAmount;
     GitBranchName = other.GitBranchName;
@@ -69,6 +89,8 @@ void ImGuiPerfToolEntry::Set(const ImGuiPerfToolEntry& other)
     Compiler = other.Compiler;
     Date = other.Date;
     //DateMax = ...
+    Environment = other.Environment;
+    LoadAverage = other.LoadAverage;
     VsBaseline = other.VsBaseline;
     LabelIndex = other.LabelIndex;
 }
@@ -105,13 +127,83 @@ static const ImGuiPerfToolColumnInfo PerfToolColumnInfo[] =
     { /* 07 */ "Stress",      offsetof(ImGuiPerfToolEntry, PerfStressAmount), ImGuiDataType_S32,    true,  0 },
     { /* 08 */ "Avg ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMs),        ImGuiDataType_Double, true,  0 },
     { /* 09 */ "Min ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsMin),     ImGuiDataType_Double, false, 0 },
-    { /* 00 */ "Max ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsMax),     ImGuiDataType_Double, false, 0 },
-    { /* 11 */ "Samples",     offsetof(ImGuiPerfToolEntry, NumSamples),       ImGuiDataType_S32,    false, 0 },
-    { /* 12 */ "VS Baseline", offsetof(ImGuiPerfToolEntry, VsBaseline),       ImGuiDataType_Float,  true,  0 },
+    { /* 10 */ "Max ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsMax),     ImGuiDataType_Double, false, 0 },
+    { /* 11 */ "Median ms",   offsetof(ImGuiPerfToolEntry, DtDeltaMsMedian),  ImGuiDataType_Double, true,  0 },
+    { /* 12 */ "P90 ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsP90),     ImGuiDataType_Double, true,  0 },
+    { /* 13 */ "P99 ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsP99),     ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 14 */ "StdDev ms",   offsetof(ImGuiPerfToolEntry, DtDeltaMsStdDev),  ImGuiDataType_Double, true,  0 },
+    { /* 15 */ "IQM ms",      offsetof(ImGuiPerfToolEntry, DtDeltaMsIqm),     ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 16 */ "Fastest ms",  offsetof(ImGuiPerfToolEntry, DtDeltaMsFrameMin),ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 17 */ "Slowest ms",  offsetof(ImGuiPerfToolEntry, DtDeltaMsFrameMax),ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 18 */ "GuiFunc ms",  offsetof(ImGuiPerfToolEntry, CpuGuiFuncMs),     ImGuiDataType_Double, true,  0 },
+    { /* 19 */ "NewFrame ms", offsetof(ImGuiPerfToolEntry, CpuNewFrameMs),    ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 20 */ "EndFrame ms", offsetof(ImGuiPerfToolEntry, CpuEndFrameMs),    ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 21 */ "Render ms",   offsetof(ImGuiPerfToolEntry, CpuRenderMs),      ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 22 */ "Engine ms",   offsetof(ImGuiPerfToolEntry, CpuEngineMs),      ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 23 */ "Instructions",offsetof(ImGuiPerfToolEntry, HwInstructions),   ImGuiDataType_Double, true,  0 },
+    { /* 24 */ "Cycles",      offsetof(ImGuiPerfToolEntry, HwCycles),         ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 25 */ "Cache misses",offsetof(ImGuiPerfToolEntry, HwCacheMisses),    ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 26 */ "Branch misses",offsetof(ImGuiPerfToolEntry, HwBranchMisses),  ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 27 */ "Samples",     offsetof(ImGuiPerfToolEntry, NumSamples),       ImGuiDataType_S32,    false, 0 },
+    { /* 28 */ "VS Baseline", offsetof(ImGuiPerfToolEntry, VsBaseline),       ImGuiDataType_Float,  true,  0 },
+    { /* 29 */ "Environment", offsetof(ImGuiPerfToolEntry, Environment),      ImGuiDataType_COUNT,  true,  ImGuiTableColumnFlags_DefaultHide },
+    { /* 30 */ "Load avg",    offsetof(ImGuiPerfToolEntry, LoadAverage),      ImGuiDataType_Double, true,  ImGuiTableColumnFlags_DefaultHide },
 };
 
 static const char* PerfToolReportDefaultOutputPath = "./output/capture_perf_report.html";
 
+// Columns of .csv perflog, shared by PerfLogWriteCSVRow() and ImGuiPerfTool::LoadCSV().
+// New columns are only ever appended: LoadCSV() accepts rows written before a column was added (missing cells are empty)
+// and rows written after (extra cells are ignored). Tools built before ColumnsExtraIgnored was added reject rows with extra columns.
+enum PerfLogCsvColumn_
+{
+    PerfLogCsvColumn_Timestamp,
+    PerfLogCsvColumn_Category,
+    PerfLogCsvColumn_TestName,
+    PerfLogCsvColumn_DtDeltaMs,
+    PerfLogCsvColumn_PerfStressAmount,
+    PerfLogCsvColumn_GitBranchName,
+    PerfLogCsvColumn_BuildType,
+    PerfLogCsvColumn_Cpu,
+    PerfLogCsvColumn_OS,
+    PerfLogCsvColumn_Compiler,
+    PerfLogCsvColumn_Date,
+    PerfLogCsvColumn_NumFrames,             // Frame time distribution
+    PerfLogCsvColumn_DtDeltaMsMedian,
+    PerfLogCsvColumn_DtDeltaMsP90,
+    PerfLogCsvColumn_DtDeltaMsP99,
+    PerfLogCsvColumn_DtDeltaMsStdDev,
+    PerfLogCsvColumn_DtDeltaMsIqm,
+    PerfLogCsvColumn_DtDeltaMsFrameMin,
+    PerfLogCsvColumn_DtDeltaMsFrameMax,
+    PerfLogCsvColumn_NumCpuFrames,          // CPU breakdown
+    PerfLogCsvColumn_CpuGuiFuncMs,
+    PerfLogCsvColumn_CpuNewFrameMs,
+    PerfLogCsvColumn_CpuEndFrameMs,
+    PerfLogCsvColumn_CpuRenderMs,
+    PerfLogCsvColumn_CpuEngineMs,
+    PerfLogCsvColumn_HwInstructions,        // Hardware counters
+    PerfLogCsvColumn_HwCycles,
+    PerfLogCsvColumn_HwCacheMisses,
+    PerfLogCsvColumn_HwBranchMisses,
+    PerfLogCsvColumn_Environment,
+    PerfLogCsvColumn_LoadAverage,
+    PerfLogCsvColumn_COUNT,
+    PerfLogCsvColumn_MinRequired = PerfLogCsvColumn_NumFrames, // Perflog files written before distribution columns were added
+};
+
+static void PerfLogWriteCSVRow(FILE* f, const ImGuiPerfToolEntry* entry)
+{
+    // Order of values must match PerfLogCsvColumn_
+    fprintf(f, "%llu,%s,%s,%.3f,x%d,%s,%s,%s,%s,%s,%s,%d,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%.3f,%d,%.4f,%.4f,%.4f,%.4f,%.4f,%.0f,%.0f,%.0f,%.0f,%s,%.2f\n", entry->Timestamp, entry->Category, entry->TestName,
+            entry->DtDeltaMs, entry->PerfStressAmount, entry->GitBranchName, entry->BuildType, entry->Cpu, entry->OS,
+            entry->Compiler, entry->Date, entry->NumFrames, entry->DtDeltaMsMedian, entry->DtDeltaMsP90, entry->DtDeltaMsP99,
+            entry->DtDeltaMsStdDev, entry->DtDeltaMsIqm, entry->DtDeltaMsFrameMin, entry->DtDeltaMsFrameMax,
+            entry->NumCpuFrames, entry->CpuGuiFuncMs, entry->CpuNewFrameMs, entry->CpuEndFrameMs, entry->CpuRenderMs, entry->CpuEngineMs,
+            entry->HwInstructions, entry->HwCycles, entry->HwCacheMisses, entry->HwBranchMisses,
+            entry->Environment ? entry->Environment : "", entry->LoadAverage);
+}
+
 // This is declared as a standalone function in order to run without a PerfTool instance
 void ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename)
 {
@@ -131,9 +223,7 @@ void ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolE
         fprintf(stderr, "Unable to open '%s', perftool entry was not saved.\n", filename);
         return;
     }
-    fprintf(f, "%llu,%s,%s,%.3f,x%d,%s,%s,%s,%s,%s,%s\n", entry->Timestamp, entry->Category, entry->TestName,
-            entry->DtDeltaMs, entry->PerfStressAmount, entry->GitBranchName, entry->BuildType, entry->Cpu, entry->OS,
-            entry->Compiler, entry->Date);
+    PerfLogWriteCSVRow(f, entry);
     fflush(f);
     fclose(f);
 
@@ -142,6 +232,466 @@ void ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolE
         perf_log->AddEntry(entry);
 }
 
+//-------------------------------------------------------------------------
+// Binary perflog
+//-------------------------------------------------------------------------
+// Append-only columnar file, made of blocks each storing a batch of entries:
+// - File header: ImGuiPerfLogFileHeader.
+// - Block: ImGuiPerfLogBlockHeader, followed by column types (one byte per column), then one array of RowCount values per
+//   column, then zero-terminated strings referenced by string columns. Each of those parts is padded to 8 bytes.
+// - Columns may only be added at the end of PerfLogColumns[]. Blocks store their column types, so older blocks load with
+//   default values for missing columns and newer blocks can be loaded by older readers (extra columns are skipped).
+// - Appending a batch writes one block with a single fwrite(). A block truncated by an interrupted write is ignored on load.
+// - Test engine buffers entries of a run (ImGuiPerfLogPendingEntries) and appends them as one block per file at end of run.
+// Loading memory-maps the file, strings of loaded entries point directly into the mapping.
+//-------------------------------------------------------------------------
+
+enum ImGuiPerfLogColumnType : ImU8
+{
+    ImGuiPerfLogColumnType_U64,
+    ImGuiPerfLogColumnType_S32,
+    ImGuiPerfLogColumnType_Double,
+    ImGuiPerfLogColumnType_String,                              // Stored as ImU32 offset into block strings
+};
+
+struct ImGuiPerfLogColumn
+{
+    ImGuiPerfLogColumnType  Type;
+    int                     Offset;
+};
+
+// Same order as CSV columns
+static const ImGuiPerfLogColumn PerfLogColumns[] =
+{
+    { ImGuiPerfLogColumnType_U64,    offsetof(ImGuiPerfToolEntry, Timestamp) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, Category) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, TestName) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMs) },
+    { ImGuiPerfLogColumnType_S32,    offsetof(ImGuiPerfToolEntry, PerfStressAmount) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, GitBranchName) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, BuildType) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, Cpu) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, OS) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, Compiler) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, Date) },
+    { ImGuiPerfLogColumnType_S32,    offsetof(ImGuiPerfToolEntry, NumFrames) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsMedian) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsP90) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsP99) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsStdDev) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsIqm) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsFrameMin) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, DtDeltaMsFrameMax) },
+    { ImGuiPerfLogColumnType_S32,    offsetof(ImGuiPerfToolEntry, NumCpuFrames) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, CpuGuiFuncMs) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, CpuNewFrameMs) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, CpuEndFrameMs) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, CpuRenderMs) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, CpuEngineMs) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, HwInstructions) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, HwCycles) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, HwCacheMisses) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, HwBranchMisses) },
+    { ImGuiPerfLogColumnType_String, offsetof(ImGuiPerfToolEntry, Environment) },
+    { ImGuiPerfLogColumnType_Double, offsetof(ImGuiPerfToolEntry, LoadAverage) },
+};
+
+static const char   PerfLogFileMagic[8] = { 'I', 'M', 'P', 'E', 'R', 'F', 'L', 'G' };
+static const ImU32  PerfLogFileVersion = 1;                     // Also detects byte order mismatch
+static const ImU32  PerfLogBlockMagic = 0x4B4C4250;             // "PBLK"
+
+struct ImGuiPerfLogFileHeader
+{
+    char        Magic[8];
+    ImU32       Version;
+    ImU32       Reserved;
+};
+
+struct ImGuiPerfLogBlockHeader
+{
+    ImU32       Magic;
+    ImU32       ColumnCount;
+    ImU32       RowCount;
+    ImU32       StringsSize;                                    // Including padding
+    ImU64       BlockSize;                                      // Including this header
+};
+
+static size_t PerfLogAlign(size_t size)                         { return (size + 7) & ~(size_t)7; }
+static size_t PerfLogGetColumnTypeSize(ImGuiPerfLogColumnType type) { return (type == ImGuiPerfLogColumnType_U64 || type == ImGuiPerfLogColumnType_Double) ? 8 : 4; }
+
+static bool PerfLogIsBinaryFilename(const char* filename)
+{
+    const size_t len = strlen(filename);
+    const size_t ext_len = strlen(IMGUI_PERFLOG_BINARY_EXTENSION);
+    return len >= ext_len && ImStricmp(filename + len - ext_len, IMGUI_PERFLOG_BINARY_EXTENSION) == 0;
+}
+
+// Serialize entries into a block, appended to 'out_data'
+static void PerfLogWriteBinaryBlock(const ImGuiPerfToolEntry* entries, int count, ImVector<char>* out_data)
+{
+    const int columns_count = IM_ARRAYSIZE(PerfLogColumns);
+
+    // Deduplicated string table
+    ImVector<char> strings;
+    ImVector<ImU32> string_offsets;                             // [column_n * count + row_n]
+    ImGuiStorage string_lookup;                                 // Hash -> offset + 1
+    string_offsets.resize(columns_count * count);
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        const ImGuiPerfLogColumn& column = PerfLogColumns[column_n];
+        if (column.Type != ImGuiPerfLogColumnType_String)
+            continue;
+        for (int row_n = 0; row_n < count; row_n++)
+        {
+            const char* str = *(const char* const*)((const char*)&entries[row_n] + column.Offset);
+            if (str == NULL)
+                str = "";
+            const ImGuiID str_id = ImHashStr(str);
+            int offset = string_lookup.GetInt(str_id, 0) - 1;
+            if (offset < 0 || strcmp(strings.Data + offset, str) != 0)
+            {
+                offset = strings.Size;
+                strings.insert(strings.end(), str, str + strlen(str) + 1);
+                string_lookup.SetInt(str_id, offset + 1);
+            }
+            string_offsets[column_n * count + row_n] = (ImU32)offset;
+        }
+    }
+    strings.resize((int)PerfLogAlign((size_t)strings.Size), 0);
+
+    // Block layout
+    size_t block_size = sizeof(ImGuiPerfLogBlockHeader) + PerfLogAlign(columns_count);
+    for (const ImGuiPerfLogColumn& column : PerfLogColumns)
+        block_size += PerfLogAlign(PerfLogGetColumnTypeSize(column.Type) * count);
+    block_size += strings.Size;
+
+    const int block_offset = out_data->Size;
+    out_data->resize(block_offset + (int)block_size, 0);
+    char* p = out_data->Data + block_offset;
+
+    ImGuiPerfLogBlockHeader header;
+    header.Magic = PerfLogBlockMagic;
+    header.ColumnCount = (ImU32)columns_count;
+    header.RowCount = (ImU32)count;
+    header.StringsSize = (ImU32)strings.Size;
+    header.BlockSize = (ImU64)block_size;
+    memcpy(p, &header, sizeof(header));
+    p += sizeof(header);
+    for (int column_n = 0; column_n < columns_count; column_n++)
+        p[column_n] = (char)PerfLogColumns[column_n].Type;
+    p += PerfLogAlign(columns_count);
+
+    // Columns
+    for (int column_n = 0; column_n < columns_count; column_n++)
+    {
+        const ImGuiPerfLogColumn& column = PerfLogColumns[column_n];
+        const size_t value_size = PerfLogGetColumnTypeSize(column.Type);
+        for (int row_n = 0; row_n < count; row_n++)
+        {
+            const void* src = (const char*)&entries[row_n] + column.Offset;
+            if (column.Type == ImGuiPerfLogColumnType_String)
+                src = &string_offsets[column_n * count + row_n];
+            memcpy(p + value_size * row_n, src, value_size);
+        }
+        p += PerfLogAlign(value_size * count);
+    }
+
+    // Strings
+    memcpy(p, strings.Data, (size_t)strings.Size);
+    IM_ASSERT(p + strings.Size == out_data->Data + out_data->Size);
+}
+
+static bool PerfLogWriteBinaryFile(const ImGuiPerfToolEntry* entries, int count, const char* filename, const char* mode)
+{
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+    {
+        fprintf(stderr, "Unable to create missing directory '%*s', perftool entries were not saved.\n", (int)(ImPathFindFilename(filename) - filename), filename);
+        return false;
+    }
+
+    FILE* f = fopen(filename, mode);
+    if (f == NULL)
+    {
+        fprintf(stderr, "Unable to open '%s', perftool entries were not saved.\n", filename);
+        return false;
+    }
+
+    // Write file header for new files
+    ImVector<char> data;
+    fseek(f, 0, SEEK_END);
+    if (ftell(f) == 0)
+    {
+        ImGuiPerfLogFileHeader header;
+        memcpy(header.Magic, PerfLogFileMagic, sizeof(header.Magic));
+        header.Version = PerfLogFileVersion;
+        header.Reserved = 0;
+        data.resize(sizeof(header));
+        memcpy(data.Data, &header, sizeof(header));
+    }
+    PerfLogWriteBinaryBlock(entries, count, &data);
+
+    const bool ret = fwrite(data.Data, 1, (size_t)data.Size, f) == (size_t)data.Size;
+    if (!ret)
+        fprintf(stderr, "Unable to write '%s', perftool entries were not saved.\n", filename);
+    fclose(f);
+    return ret;
+}
+
+// This is declared as a standalone function in order to run without a PerfTool instance
+bool ImGuiTestEngine_PerfToolAppendToBinary(const ImGuiPerfToolEntry* entries, int count, const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    if (count <= 0)
+        return true;
+    return PerfLogWriteBinaryFile(entries, count, filename, "ab");
+}
+
+// Binary perflog is columnar and deduplicates strings within a block: entries should be appended in batches.
+// Test engine buffers entries of a run into 'pending' and writes them with ImGuiTestEngine_PerfToolFlush() at end of run.
+void ImGuiTestEngine_PerfToolAppend(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename, ImGuiPerfLogPendingEntries* pending)
+{
+    if (filename == NULL)
+        filename = IMGUI_PERFLOG_DEFAULT_FILENAME;
+
+    if (!PerfLogIsBinaryFilename(filename))
+    {
+        ImGuiTestEngine_PerfToolAppendToCSV(perf_log, entry, filename);
+        return;
+    }
+
+    if (pending != NULL)
+    {
+        int file_index = 0;
+        while (file_index < pending->Filenames.Size && strcmp(pending->Filenames[file_index], filename) != 0)
+            file_index++;
+        if (file_index == pending->Filenames.Size)
+            pending->Filenames.push_back(ImStrdup(filename));
+        pending->Entries.push_back(*entry);
+        pending->FileIndices.push_back(file_index);
+    }
+    else if (!ImGuiTestEngine_PerfToolAppendToBinary(entry, 1, filename))
+    {
+        return;
+    }
+
+    // Register to runtime perf tool if any
+    if (perf_log != NULL)
+        perf_log->AddEntry(entry);
+}
+
+bool ImGuiTestEngine_PerfToolFlush(ImGuiPerfLogPendingEntries* pending)
+{
+    bool ret = true;
+    ImVector<ImGuiPerfToolEntry> entries;
+    for (int file_index = 0; file_index < pending->Filenames.Size; file_index++)
+    {
+        entries.resize(0);
+        for (int entry_n = 0; entry_n < pending->Entries.Size; entry_n++)
+            if (pending->FileIndices[entry_n] == file_index)
+                entries.push_back(pending->Entries[entry_n]);
+        ret &= ImGuiTestEngine_PerfToolAppendToBinary(entries.Data, entries.Size, pending->Filenames[file_index]);
+    }
+    pending->Clear();
+    return ret;
+}
+
+static ImGuiID GetBuildID(const ImGuiPerfToolEntry* entry);
+
+// Compare 'entry' against entries of same test and stress amount recorded in a baseline perflog.
+// Only entries of same build (type, OS, CPU, compiler, branch and environment, as grouped by perf tool) are comparable.
+// - With 3 or more baseline runs: run-to-run noise is estimated from the spread of baseline results, and the entry
+//   is tested against the prediction interval of a new run (Student's t with n-1 degrees of freedom).
+// - Otherwise: Welch's t-test between per-frame distributions of the entry and of the most recent baseline run.
+//   Frame times are autocorrelated so this is over-confident: callers should also require a minimum change.
+// Return false when there is no usable baseline data.
+bool ImGuiTestEngine_PerfToolCompareToBaseline(ImGuiPerfTool* baseline, const ImGuiPerfToolEntry* entry, ImGuiPerfToolComparison* out_comparison)
+{
+    *out_comparison = ImGuiPerfToolComparison();
+    if (baseline == NULL)
+        return false;
+
+    int runs = 0;
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    const ImGuiPerfToolEntry* last_run = NULL;
+    const ImGuiID build_id = GetBuildID(entry);
+    for (const ImGuiPerfToolEntry& e : baseline->_SrcData)
+    {
+        if (e.PerfStressAmount != entry->PerfStressAmount || strcmp(e.TestName, entry->TestName) != 0)
+            continue;
+        if (GetBuildID(&e) != build_id)
+            continue;
+        runs++;
+        sum += e.DtDeltaMs;
+        sum_sq += e.DtDeltaMs * e.DtDeltaMs;
+        if (e.NumFrames > 1 && (last_run == NULL || e.Timestamp >= last_run->Timestamp))
+            last_run = &e;
+    }
+    if (runs == 0)
+        return false;
+
+    const double baseline_mean = sum / runs;
+    double std_error = 0.0;
+    double dof = 0.0;
+    if (runs >= 3)
+    {
+        const double variance = ImMax(0.0, (sum_sq - sum * baseline_mean) / (runs - 1));
+        std_error = sqrt(variance * (1.0 + 1.0 / runs));
+        dof = runs - 1;
+    }
+    else if (last_run != NULL && entry->NumFrames > 1)
+    {
+        const double v1 = entry->DtDeltaMsStdDev * entry->DtDeltaMsStdDev / entry->NumFrames;
+        const double v2 = last_run->DtDeltaMsStdDev * last_run->DtDeltaMsStdDev / last_run->NumFrames;
+        std_error = sqrt(v1 + v2);
+        dof = (v1 + v2) * (v1 + v2) / ((v1 * v1) / (entry->NumFrames - 1) + (v2 * v2) / (last_run->NumFrames - 1) + 1e-300);
+    }
+    else
+    {
+        return false; // Single baseline run without distribution data (older perflog): no way to estimate noise.
+    }
+
+    const double delta = entry->DtDeltaMs - baseline_mean;
+    out_comparison->BaselineRuns = runs;
+    out_comparison->BaselineDtDeltaMs = baseline_mean;
+    out_comparison->StdError = std_error;
+    out_comparison->VsBaseline = (baseline_mean != 0.0) ? delta / fabs(baseline_mean) * 100.0 : 0.0;
+    if (std_error > 0.0 && dof > 0.0)
+        out_comparison->Confidence = ImStudentTCdf(delta / std_error, dof);
+    else
+        out_comparison->Confidence = (delta > 0.0) ? 1.0 : (delta < 0.0) ? 0.0 : 0.5;
+    return true;
+}
+
+static double PerfToolComplexityFunc(ImGuiPerfToolComplexity complexity, double n)
+{
+    switch (complexity)
+    {
+    case ImGuiPerfToolComplexity_OLogN:     return log2(n);
+    case ImGuiPerfToolComplexity_ON:        return n;
+    case ImGuiPerfToolComplexity_ONLogN:    return n * log2(n);
+    case ImGuiPerfToolComplexity_ON2:       return n * n;
+    default:                                return 1.0;
+    }
+}
+
+const char* ImGuiTestEngine_PerfToolGetComplexityName(ImGuiPerfToolComplexity complexity)
+{
+    static const char* names[] = { "Unknown", "O(1)", "O(log N)", "O(N)", "O(N log N)", "O(N^2)" };
+    IM_STATIC_ASSERT(IM_ARRAYSIZE(names) == ImGuiPerfToolComplexity_COUNT);
+    IM_ASSERT(complexity >= 0 && complexity < ImGuiPerfToolComplexity_COUNT);
+    return names[complexity];
+}
+
+// Fit delta times measured at several stress amounts (N) to complexity classes.
+// - Each class is fitted by least squares as Intercept + Coefficient * f(N). Intercept absorbs fixed costs (e.g. window
+//   setup) which dominate at low stress amounts. Negative coefficients are rejected.
+// - Class explaining most variance is picked. It is preferred over O(1) only when it explains most of the variance and
+//   when growth it predicts over measured range is above noise level, otherwise test is reported as O(1).
+// Stress amounts should span at least an order of magnitude for classes to be distinguishable.
+// Return false when there are less than 3 points or stress amounts are all equal.
+bool ImGuiTestEngine_PerfToolFitScaling(const double* stress_amounts, const double* dt_delta_ms, int count, ImGuiPerfToolScalingFit* out_fit)
+{
+    *out_fit = ImGuiPerfToolScalingFit();
+    out_fit->NumPoints = count;
+    if (count < 3)
+        return false;
+
+    double n_min = stress_amounts[0];
+    double n_max = stress_amounts[0];
+    double t_mean = 0.0;
+    double t_max = 0.0;
+    for (int i = 0; i < count; i++)
+    {
+        IM_ASSERT(stress_amounts[i] > 0.0);
+        n_min = ImMin(n_min, stress_amounts[i]);
+        n_max = ImMax(n_max, stress_amounts[i]);
+        t_mean += dt_delta_ms[i];
+        t_max = ImMax(t_max, fabs(dt_delta_ms[i]));
+    }
+    if (n_min == n_max)
+        return false;
+    t_mean /= count;
+    double t_ss = 0.0;
+    for (int i = 0; i < count; i++)
+        t_ss += (dt_delta_ms[i] - t_mean) * (dt_delta_ms[i] - t_mean);
+
+    // O(1) is the fallback
+    out_fit->Complexity = ImGuiPerfToolComplexity_O1;
+    out_fit->Intercept = t_mean;
+
+    ImGuiPerfToolScalingFit best = *out_fit;
+    for (int complexity = ImGuiPerfToolComplexity_O1 + 1; complexity < ImGuiPerfToolComplexity_COUNT && t_ss > 0.0; complexity++)
+    {
+        double f_mean = 0.0;
+        for (int i = 0; i < count; i++)
+            f_mean += PerfToolComplexityFunc((ImGuiPerfToolComplexity)complexity, stress_amounts[i]);
+        f_mean /= count;
+        double f_ss = 0.0;
+        double ft_sp = 0.0;
+        for (int i = 0; i < count; i++)
+        {
+            const double f = PerfToolComplexityFunc((ImGuiPerfToolComplexity)complexity, stress_amounts[i]) - f_mean;
+            f_ss += f * f;
+            ft_sp += f * (dt_delta_ms[i] - t_mean);
+        }
+        if (f_ss <= 0.0 || ft_sp <= 0.0)
+            continue;
+        const double coefficient = ft_sp / f_ss;
+        const double intercept = t_mean - coefficient * f_mean;
+        double residual_ss = 0.0;
+        for (int i = 0; i < count; i++)
+        {
+            const double residual = dt_delta_ms[i] - (intercept + coefficient * PerfToolComplexityFunc((ImGuiPerfToolComplexity)complexity, stress_amounts[i]));
+            residual_ss += residual * residual;
+        }
+        const double r_squared = 1.0 - residual_ss / t_ss;
+        if (r_squared > best.RSquared)
+        {
+            best.Complexity = (ImGuiPerfToolComplexity)complexity;
+            best.Intercept = intercept;
+            best.Coefficient = coefficient;
+            best.RSquared = r_squared;
+        }
+    }
+    if (best.Complexity != ImGuiPerfToolComplexity_O1)
+    {
+        const double growth = best.Coefficient * (PerfToolComplexityFunc(best.Complexity, n_max) - PerfToolComplexityFunc(best.Complexity, n_min));
+        if (best.RSquared >= 0.75 && growth >= 0.05 * t_max)
+            *out_fit = best;
+    }
+
+    // Empirical exponent, from points with a positive delta time
+    int log_count = 0;
+    double x_mean = 0.0;
+    double y_mean = 0.0;
+    for (int i = 0; i < count; i++)
+        if (dt_delta_ms[i] > 0.0)
+        {
+            x_mean += log(stress_amounts[i]);
+            y_mean += log(dt_delta_ms[i]);
+            log_count++;
+        }
+    if (log_count >= 2)
+    {
+        x_mean /= log_count;
+        y_mean /= log_count;
+        double x_ss = 0.0;
+        double xy_sp = 0.0;
+        for (int i = 0; i < count; i++)
+            if (dt_delta_ms[i] > 0.0)
+            {
+                const double x = log(stress_amounts[i]) - x_mean;
+                x_ss += x * x;
+                xy_sp += x * (log(dt_delta_ms[i]) - y_mean);
+            }
+        if (x_ss > 0.0)
+            out_fit->Exponent = xy_sp / x_ss;
+    }
+
+    return true;
+}
+
 // Tri-state button. Copied and modified ButtonEx().
 static bool Button3(const char* label, int* value)
 {
@@ -199,6 +749,8 @@ static ImGuiID GetBuildID(const ImGuiPerfToolEntry* entry)
     build_id = ImHashStr(entry->Cpu, 0, build_id);
     build_id = ImHashStr(entry->Compiler, 0, build_id);
     build_id = ImHashStr(entry->GitBranchName, 0, build_id);
+    if (entry->Environment != NULL && entry->Environment[0])   // Keep IDs of builds recorded before environment was stored
+        build_id = ImHashStr(entry->Environment, 0, build_id);
     return build_id;
 }
 
@@ -366,15 +918,16 @@ static void PerfToolFormatBuildInfo(ImGuiPerfTool* perftool, Str* result, ImGuiP
 
 static int PerfToolCountBuilds(ImGuiPerfTool* perftool, bool only_visible)
 {
+    // Groups never span multiple builds, and groups of same build are adjacent.
     int num_builds = 0;
     ImU64 build_id = 0;
-    for (ImGuiPerfToolEntry& entry : perftool->_SrcData)
+    for (ImGuiPerfToolGroup& group : perftool->_Groups)
     {
-        if (build_id != GetBuildID(&entry))
+        if (build_id != group.BuildID)
         {
-            if (!only_visible || perftool->_IsVisibleBuild(&entry))
+            if (!only_visible || perftool->_IsVisibleBuild(&perftool->_SrcData.Data[group.SrcStart]))
                 num_builds++;
-            build_id = GetBuildID(&entry);
+            build_id = group.BuildID;
         }
     }
     return num_builds;
@@ -526,6 +1079,7 @@ static ImRect ImPlotGetYTickRect(int t, int y = 0)
 ImGuiPerfTool::ImGuiPerfTool()
 {
     _CsvParser = IM_NEW(ImGuiCsvParser)();
+    _FileMapping = IM_NEW(ImFileMapping)();
     Clear();
 }
 
@@ -533,7 +1087,10 @@ ImGuiPerfTool::~ImGuiPerfTool()
 {
     _SrcData.clear_destruct();
     _Batches.clear_destruct();
+    _GroupAggregates.clear_destruct();
     IM_DELETE(_CsvParser);
+    IM_DELETE(_FileMapping);
+    IM_DELETE(_ScalingData);
 }
 
 void ImGuiPerfTool::AddEntry(ImGuiPerfToolEntry* entry)
@@ -544,39 +1101,201 @@ void ImGuiPerfTool::AddEntry(ImGuiPerfToolEntry* entry)
         ImStrncpy(_FilterDateTo, entry->Date, IM_ARRAYSIZE(_FilterDateTo));
 
     _SrcData.push_back(*entry);
+    if (_SrcData.back().Environment == NULL)
+        _SrcData.back().Environment = "";
     _Batches.clear_destruct();
 }
 
-void ImGuiPerfTool::_Rebuild()
+// Running sums used while combining multiple entries of same perf test.
+struct ImGuiPerfToolAccumulator
 {
-    if (_SrcData.empty())
+    int         NumDistributions = 0;
+    int         NumCpuTimings = 0;
+    double      HwCountersSum[4] = {};
+    int         HwCountersNum[4] = {};
+    double      LoadAverageSum = 0.0;
+    int         LoadAverageNum = 0;
+};
+
+static bool PerfToolIsDateInFilter(const ImGuiPerfTool* perftool, const char* date)
+{
+    if (perftool->_FilterDateFrom[0] && strcmp(date, perftool->_FilterDateFrom) < 0)
+        return false;
+    if (perftool->_FilterDateTo[0] && strcmp(date, perftool->_FilterDateTo) > 0)
+        return false;
+    return true;
+}
+
+// Initialize aggregates with build information of `first` entry and reset all measurements.
+static void PerfToolInitAggregates(const ImGuiPerfToolEntry* first, const char* const* labels, int count, ImGuiPerfToolEntry* out_aggregates)
+{
+    for (int i = 0; i < count; i++)
+    {
+        ImGuiPerfToolEntry* e = &out_aggregates[i];
+        *e = *first;
+        e->DtDeltaMs = 0;
+        e->DtDeltaMsMin = +FLT_MAX;
+        e->DtDeltaMsMax = -FLT_MAX;
+        e->NumSamples = 0;
+        e->DtDeltaMsMedian = e->DtDeltaMsP90 = e->DtDeltaMsP99 = e->DtDeltaMsStdDev = e->DtDeltaMsIqm = 0;
+        e->DtDeltaMsFrameMin = +FLT_MAX;
+        e->DtDeltaMsFrameMax = -FLT_MAX;
+        e->NumFrames = 0;
+        e->CpuGuiFuncMs = e->CpuNewFrameMs = e->CpuEndFrameMs = e->CpuRenderMs = e->CpuEngineMs = 0;
+        e->NumCpuFrames = 0;
+        e->HwInstructions = e->HwCycles = e->HwCacheMisses = e->HwBranchMisses = -1.0;
+        e->LoadAverage = -1.0;
+        e->LabelIndex = i;
+        e->TestName = labels[i];
+    }
+}
+
+static void PerfToolAccumulate(ImGuiPerfToolEntry* aggregate, ImGuiPerfToolAccumulator* acc, const ImGuiPerfToolEntry* e)
+{
+    aggregate->DtDeltaMs += e->DtDeltaMs;
+    aggregate->NumSamples++;
+    aggregate->DtDeltaMsMin = ImMin(aggregate->DtDeltaMsMin, e->DtDeltaMs);
+    aggregate->DtDeltaMsMax = ImMax(aggregate->DtDeltaMsMax, e->DtDeltaMs);
+    const double hw_counters[] = { e->HwInstructions, e->HwCycles, e->HwCacheMisses, e->HwBranchMisses };
+    for (int counter_n = 0; counter_n < IM_ARRAYSIZE(hw_counters); counter_n++)
+        if (hw_counters[counter_n] >= 0.0)
+        {
+            acc->HwCountersSum[counter_n] += hw_counters[counter_n];
+            acc->HwCountersNum[counter_n]++;
+        }
+    if (e->LoadAverage >= 0.0)
+    {
+        acc->LoadAverageSum += e->LoadAverage;
+        acc->LoadAverageNum++;
+    }
+    if (e->NumCpuFrames > 0)
+    {
+        aggregate->CpuGuiFuncMs += e->CpuGuiFuncMs;
+        aggregate->CpuNewFrameMs += e->CpuNewFrameMs;
+        aggregate->CpuEndFrameMs += e->CpuEndFrameMs;
+        aggregate->CpuRenderMs += e->CpuRenderMs;
+        aggregate->CpuEngineMs += e->CpuEngineMs;
+        aggregate->NumCpuFrames += e->NumCpuFrames;
+        acc->NumCpuTimings++;
+    }
+    if (e->NumFrames == 0)
         return;
+    aggregate->DtDeltaMsMedian += e->DtDeltaMsMedian;
+    aggregate->DtDeltaMsP90 += e->DtDeltaMsP90;
+    aggregate->DtDeltaMsP99 += e->DtDeltaMsP99;
+    aggregate->DtDeltaMsStdDev += e->DtDeltaMsStdDev;
+    aggregate->DtDeltaMsIqm += e->DtDeltaMsIqm;
+    aggregate->DtDeltaMsFrameMin = ImMin(aggregate->DtDeltaMsFrameMin, e->DtDeltaMsFrameMin);
+    aggregate->DtDeltaMsFrameMax = ImMax(aggregate->DtDeltaMsFrameMax, e->DtDeltaMsFrameMax);
+    aggregate->NumFrames += e->NumFrames;
+    acc->NumDistributions++;
+}
 
-    ImGuiStorage& temp_set = _TempSet;
-    _Labels.resize(0);
-    _LabelsVisible.resize(0);
-    _InfoTableSort.resize(0);
-    _Batches.clear_destruct();
-    _InfoTableSortDirty = true;
+static void PerfToolAccumulateFinish(ImGuiPerfToolEntry* aggregate, const ImGuiPerfToolAccumulator* acc, bool combine_by_build_info)
+{
+    // Combined distributions are approximated by averaging their statistics.
+    if (acc->NumDistributions > 1)
+    {
+        aggregate->DtDeltaMsMedian /= acc->NumDistributions;
+        aggregate->DtDeltaMsP90 /= acc->NumDistributions;
+        aggregate->DtDeltaMsP99 /= acc->NumDistributions;
+        aggregate->DtDeltaMsStdDev /= acc->NumDistributions;
+        aggregate->DtDeltaMsIqm /= acc->NumDistributions;
+    }
+    if (acc->NumCpuTimings > 1)
+    {
+        aggregate->CpuGuiFuncMs /= acc->NumCpuTimings;
+        aggregate->CpuNewFrameMs /= acc->NumCpuTimings;
+        aggregate->CpuEndFrameMs /= acc->NumCpuTimings;
+        aggregate->CpuRenderMs /= acc->NumCpuTimings;
+        aggregate->CpuEngineMs /= acc->NumCpuTimings;
+    }
+    double* aggregate_hw_counters[] = { &aggregate->HwInstructions, &aggregate->HwCycles, &aggregate->HwCacheMisses, &aggregate->HwBranchMisses };
+    for (int counter_n = 0; counter_n < IM_ARRAYSIZE(aggregate_hw_counters); counter_n++)
+        if (acc->HwCountersNum[counter_n] > 0)
+            *aggregate_hw_counters[counter_n] = acc->HwCountersSum[counter_n] / acc->HwCountersNum[counter_n];
+    if (acc->LoadAverageNum > 0)
+        aggregate->LoadAverage = acc->LoadAverageSum / acc->LoadAverageNum;
+
+    // In case data is combined by build info, DtDeltaMs will be a sum of all combined entries. Average it out.
+    if (combine_by_build_info && aggregate->NumSamples > 0)
+        aggregate->DtDeltaMs /= aggregate->NumSamples;
+}
 
-    // Gather all visible labels. Legend batches will store data in this order.
-    temp_set.Data.resize(0);    // name_id:IsLabelSeen
-    for (ImGuiPerfToolEntry& entry : _SrcData)
+// Aggregate entries of a group, optionally only those passing date filter. Entry is accumulated into out_aggregates[label_slots[entry->LabelIndex]],
+// entries with a negative slot are skipped. Returns false when no entry of the group passes date filter.
+static bool PerfToolAggregateGroup(ImGuiPerfTool* perftool, const ImGuiPerfToolGroup* group, bool use_date_filter, const int* label_slots, const char* const* slot_labels, int slots_count, ImGuiPerfToolEntry* out_aggregates, ImVector<ImGuiPerfToolAccumulator>* accumulators)
+{
+    if (use_date_filter)
+    {
+        if (perftool->_FilterDateFrom[0] && strcmp(group->DateMax, perftool->_FilterDateFrom) < 0)
+            return false;
+        if (perftool->_FilterDateTo[0] && strcmp(group->DateMin, perftool->_FilterDateTo) > 0)
+            return false;
+    }
+
+    // Aggregates take build information from first entry passing the filter.
+    const bool filter_dates = use_date_filter && !(PerfToolIsDateInFilter(perftool, group->DateMin) && PerfToolIsDateInFilter(perftool, group->DateMax));
+    const ImGuiPerfToolEntry* src_begin = perftool->_SrcData.Data + group->SrcStart;
+    const ImGuiPerfToolEntry* src_end = perftool->_SrcData.Data + group->SrcEnd;
+    while (filter_dates && src_begin < src_end && !PerfToolIsDateInFilter(perftool, src_begin->Date))
+        src_begin++;
+    if (src_begin == src_end)
+        return false;
+
+    PerfToolInitAggregates(src_begin, slot_labels, slots_count, out_aggregates);
+    accumulators->resize(slots_count);
+    for (ImGuiPerfToolAccumulator& acc : *accumulators)
+        acc = ImGuiPerfToolAccumulator();
+    for (const ImGuiPerfToolEntry* e = src_begin; e < src_end; e++)
     {
-        ImGuiID name_id = ImHashStr(entry.TestName);
-        if (!temp_set.GetBool(name_id))
+        const int slot = label_slots[e->LabelIndex];
+        if (slot < 0 || (filter_dates && !PerfToolIsDateInFilter(perftool, e->Date)))
+            continue;
+        PerfToolAccumulate(&out_aggregates[slot], &accumulators->Data[slot], e);
+    }
+
+    const bool combine_by_build_info = perftool->_DisplayType == ImGuiPerfToolDisplayType_CombineByBuildInfo;
+    for (int slot = 0; slot < slots_count; slot++)
+        PerfToolAccumulateFinish(&out_aggregates[slot], &accumulators->Data[slot], combine_by_build_info);
+    return true;
+}
+
+// Sort and index entries added since last call. This is the only step whose cost depends on the size of entire dataset.
+void ImGuiPerfTool::_RebuildIndex()
+{
+    // Gather labels of new entries. Labels are sorted in reverse order so they appear to be oredered from top down.
+    const int sorted_count = _SrcDataSortedCount;
+    _Labels.resize(_NumSrcLabels);
+    for (int n = sorted_count; n < _SrcData.Size; n++)
+    {
+        const char* test_name = _SrcData.Data[n].TestName;
+        ImGuiID name_id = ImHashStr(test_name);
+        if (_LabelIndices.GetInt(name_id, -1) < 0)
         {
-            temp_set.SetBool(name_id, true);
-            _Labels.push_back(entry.TestName);
-            if (_IsVisibleTest(entry.TestName))
-                _LabelsVisible.push_front(entry.TestName);
+            _LabelIndices.SetInt(name_id, _Labels.Size);
+            _Labels.push_back(test_name);
         }
     }
-    int num_visible_labels = _LabelsVisible.Size;
 
-    // Labels are sorted in reverse order so they appear to be oredered from top down.
-    ImQsort(_Labels.Data, _Labels.Size, sizeof(const char*), &PerfToolComparerStr);
-    ImQsort(_LabelsVisible.Data, num_visible_labels, sizeof(const char*), &PerfToolComparerStr);
+    // Indices of already sorted entries are remapped when new labels were inserted.
+    if (_Labels.Size != _NumSrcLabels)
+    {
+        ImQsort(_Labels.Data, _Labels.Size, sizeof(const char*), &PerfToolComparerStr);
+        ImVector<int> remap;
+        remap.resize(_Labels.Size);
+        for (int n = 0; n < _Labels.Size; n++)
+        {
+            ImGuiID name_id = ImHashStr(_Labels.Data[n]);
+            remap.Data[_LabelIndices.GetInt(name_id)] = n;
+            _LabelIndices.SetInt(name_id, n);
+        }
+        for (int n = 0; n < sorted_count; n++)
+            _SrcData.Data[n].LabelIndex = remap.Data[_SrcData.Data[n].LabelIndex];
+        _NumSrcLabels = _Labels.Size;
+    }
+    for (int n = sorted_count; n < _SrcData.Size; n++)
+        _SrcData.Data[n].LabelIndex = _LabelIndices.GetInt(ImHashStr(_SrcData.Data[n].TestName));
 
     // _SrcData vector stores sorted raw entries of imgui_perflog.csv. Sorting is very important,
     // algorithm depends on data being correctly sorted. Sorting _SrcData is OK, because it is only
@@ -589,90 +1308,143 @@ void ImGuiPerfTool::_Rebuild()
     // This results in a neatly partitioned dataset where similar data is grouped together and where perf test order
     // is consistent in all batches. Sorting by build ID _before_ timestamp is also important as we will be aggregating
     // entries by build ID instead of timestamp, when appropriate display mode is enabled.
-    ImQsort(_SrcData.Data, _SrcData.Size, sizeof(ImGuiPerfToolEntry), &PerfToolComparerByEntryInfo);
+    // Only new entries are sorted, then merged with previously sorted entries.
+    ImQsort(_SrcData.Data + sorted_count, (size_t)(_SrcData.Size - sorted_count), sizeof(ImGuiPerfToolEntry), &PerfToolComparerByEntryInfo);
+    if (sorted_count > 0 && sorted_count < _SrcData.Size && PerfToolComparerByEntryInfo(&_SrcData.Data[sorted_count - 1], &_SrcData.Data[sorted_count]) > 0)
+    {
+        ImVector<ImGuiPerfToolEntry> merged;
+        merged.reserve(_SrcData.Size);
+        const ImGuiPerfToolEntry* a = _SrcData.Data;
+        const ImGuiPerfToolEntry* a_end = _SrcData.Data + sorted_count;
+        const ImGuiPerfToolEntry* b = a_end;
+        const ImGuiPerfToolEntry* b_end = _SrcData.end();
+        while (a < a_end && b < b_end)
+            merged.push_back(PerfToolComparerByEntryInfo(b, a) < 0 ? *b++ : *a++);
+        while (a < a_end)
+            merged.push_back(*a++);
+        while (b < b_end)
+            merged.push_back(*b++);
+        _SrcData.swap(merged);
+    }
+    _SrcDataSortedCount = _SrcData.Size;
+    _Groups.resize(0);
+}
 
-    // Sort groups of entries into batches.
+// Split sorted entries into groups of same batch ID. Groups spanning multiple runs cache aggregates of all perf tests,
+// so changing test visibility does not need to go through their entries again.
+void ImGuiPerfTool::_RebuildGroups()
+{
     const bool combine_by_build_info = _DisplayType == ImGuiPerfToolDisplayType_CombineByBuildInfo;
-    _LabelBarCounts.Data.resize(0);
-
-    // Process all batches. `entry` is always a first batch element (guaranteed by _SrcData being sorted by timestamp).
-    // At the end of this loop we fast-forward until next batch (first entry having different batch id (which is a
-    // timestamp or build info)).
-    for (ImGuiPerfToolEntry* entry = _SrcData.begin(); entry < _SrcData.end();)
+    _Groups.resize(0);
+    _GroupAggregates.resize(0);
+    _GroupsDisplayType = _DisplayType;
+
+    ImVector<int> label_slots;
+    label_slots.resize(_NumSrcLabels);
+    for (int n = 0; n < _NumSrcLabels; n++)
+        label_slots.Data[n] = n;
+    ImVector<ImGuiPerfToolEntry> aggregates;
+    aggregates.resize(_NumSrcLabels);
+    ImVector<ImGuiPerfToolAccumulator> accumulators;
+
+    for (int src_n = 0; src_n < _SrcData.Size;)
     {
-        // Filtered out entries can be safely ignored. Note that entry++ does not follow logic of fast-forwarding to the
-        // next batch, as found at the end of this loop. This is OK, because all entries belonging to a same batch will
-        // also have same date.
-        if ((_FilterDateFrom[0] && strcmp(entry->Date, _FilterDateFrom) < 0) || (_FilterDateTo[0] && strcmp(entry->Date, _FilterDateTo) > 0))
+        const ImGuiPerfToolEntry* entry = &_SrcData.Data[src_n];
+        ImGuiPerfToolGroup group;
+        group.BatchID = GetBatchID(this, entry);
+        group.BuildID = GetBuildID(entry);
+        group.SrcStart = src_n;
+        group.DateMin = group.DateMax = entry->Date;
+
+        // Fast-forward until next batch (first entry having different batch id (which is a timestamp or build info)),
+        // counting how many unique runs participate in this group.
+        ImU64 last_timestamp = entry->Timestamp;
+        for (src_n++; src_n < _SrcData.Size; src_n++)
         {
-            entry++;
-            continue;
+            const ImGuiPerfToolEntry* e = &_SrcData.Data[src_n];
+            if (combine_by_build_info ? GetBuildID(e) != group.BuildID : e->Timestamp != entry->Timestamp)
+                break;
+            if (e->Timestamp != last_timestamp)
+            {
+                group.NumSamples++;
+                last_timestamp = e->Timestamp;
+            }
+            if (strcmp(e->Date, group.DateMin) < 0)
+                group.DateMin = e->Date;
+            if (strcmp(e->Date, group.DateMax) > 0)
+                group.DateMax = e->Date;
         }
+        group.SrcEnd = src_n;
+
+        // Cache aggregates of all groups, including single runs, so toggling visibility never aggregates _SrcData again.
+        PerfToolAggregateGroup(this, &group, false, label_slots.Data, _Labels.Data, _NumSrcLabels, aggregates.Data, &accumulators);
+        group.AggregatesStart = _GroupAggregates.Size;
+        for (ImGuiPerfToolEntry& aggregate : aggregates)
+            if (aggregate.NumSamples > 0)
+                _GroupAggregates.push_back(aggregate);
+        group.AggregatesCount = _GroupAggregates.Size - group.AggregatesStart;
+        _Groups.push_back(group);
+    }
+}
+
+void ImGuiPerfTool::_Rebuild()
+{
+    if (_SrcData.empty())
+        return;
 
+    // Only work proportional to the visible data is done, unless new entries were added or display type changed.
+    if (_SrcDataSortedCount != _SrcData.Size)
+        _RebuildIndex();
+    if (_Groups.empty() || _GroupsDisplayType != _DisplayType)
+        _RebuildGroups();
+
+    ImGuiStorage& temp_set = _TempSet;
+    _Labels.resize(_NumSrcLabels);
+    _LabelsVisible.resize(0);
+    _InfoTableSort.resize(0);
+    _Batches.clear_destruct();
+    _InfoTableSortDirty = true;
+
+    // Gather all visible labels. Legend batches will store data in this order.
+    _LabelVisibleIndices.resize(_NumSrcLabels);
+    for (int n = 0; n < _NumSrcLabels; n++)
+    {
+        _LabelVisibleIndices.Data[n] = _IsVisibleTest(_Labels.Data[n]) ? _LabelsVisible.Size : -1;
+        if (_LabelVisibleIndices.Data[n] >= 0)
+            _LabelsVisible.push_back(_Labels.Data[n]);
+    }
+    int num_visible_labels = _LabelsVisible.Size;
+
+    // Build batches from groups.
+    const bool combine_by_build_info = _DisplayType == ImGuiPerfToolDisplayType_CombineByBuildInfo;
+    ImVector<ImGuiPerfToolAccumulator> accumulators;
+    _Batches.reserve(_Groups.Size);
+    for (ImGuiPerfToolGroup& group : _Groups)
+    {
         _Batches.push_back(ImGuiPerfToolBatch());
         ImGuiPerfToolBatch& batch = _Batches.back();
-        batch.BatchID = GetBatchID(this, entry);
+        batch.BatchID = group.BatchID;
+        batch.NumSamples = group.NumSamples;
         batch.Entries.resize(num_visible_labels);
 
-        // Fill in defaults. Done once before data aggregation loop, because same entry may be touched multiple times in
-        // the following loop when entries are being combined by build info.
-        for (int i = 0; i < num_visible_labels; i++)
+        if (group.AggregatesCount > 0 && PerfToolIsDateInFilter(this, group.DateMin) && PerfToolIsDateInFilter(this, group.DateMax))
         {
-            ImGuiPerfToolEntry* e = &batch.Entries.Data[i];
-            *e = *entry;
-            e->DtDeltaMs = 0;
-            e->NumSamples = 0;
-            e->LabelIndex = i;
-            e->TestName = _LabelsVisible.Data[i];
-        }
-
-        // Find perf test runs for this particular batch and accumulate them.
-        for (int i = 0; i < num_visible_labels; i++)
-        {
-            // This inner loop walks all entries that belong to current batch. Due to sorting we are sure that batch
-            // always starts with `entry`, and all entries that belong to a batch (whether we combine by build info or not)
-            // will be grouped in _SrcData.
-            ImGuiPerfToolEntry* aggregate = &batch.Entries.Data[i];
-            for (ImGuiPerfToolEntry* e = entry; e < _SrcData.end() && GetBatchID(this, e) == batch.BatchID; e++)
+            // Copy cached aggregates of visible tests.
+            PerfToolInitAggregates(&_SrcData.Data[group.SrcStart], _LabelsVisible.Data, num_visible_labels, batch.Entries.Data);
+            for (int n = group.AggregatesStart; n < group.AggregatesStart + group.AggregatesCount; n++)
             {
-                if (strcmp(e->TestName, aggregate->TestName) != 0)
+                const ImGuiPerfToolEntry* aggregate = &_GroupAggregates.Data[n];
+                const int slot = _LabelVisibleIndices.Data[aggregate->LabelIndex];
+                if (slot < 0)
                     continue;
-                aggregate->DtDeltaMs += e->DtDeltaMs;
-                aggregate->NumSamples++;
-                aggregate->DtDeltaMsMin = ImMin(aggregate->DtDeltaMsMin, e->DtDeltaMs);
-                aggregate->DtDeltaMsMax = ImMax(aggregate->DtDeltaMsMax, e->DtDeltaMs);
+                batch.Entries.Data[slot] = *aggregate;
+                batch.Entries.Data[slot].LabelIndex = slot;
             }
         }
-
-        // In case data is combined by build info, DtDeltaMs will be a sum of all combined entries. Average it out.
-        if (combine_by_build_info)
-            for (int i = 0; i < num_visible_labels; i++)
-            {
-                ImGuiPerfToolEntry* aggregate = &batch.Entries.Data[i];
-                if (aggregate->NumSamples > 0)
-                    aggregate->DtDeltaMs /= aggregate->NumSamples;
-            }
-
-        // Advance to the next batch.
-        batch.NumSamples = 1;
-        if (combine_by_build_info)
+        else if (!PerfToolAggregateGroup(this, &group, true, _LabelVisibleIndices.Data, _LabelsVisible.Data, num_visible_labels, batch.Entries.Data, &accumulators))
         {
-            ImU64 last_timestamp = entry->Timestamp;
-            for (ImGuiID build_id = GetBuildID(entry); entry < _SrcData.end() && build_id == GetBuildID(entry);)
-            {
-                // Also count how many unique batches participate in this aggregated batch.
-                if (entry->Timestamp != last_timestamp)
-                {
-                    batch.NumSamples++;
-                    last_timestamp = entry->Timestamp;
-                }
-                entry++;
-            }
-        }
-        else
-        {
-            for (ImU64 timestamp = entry->Timestamp; entry < _SrcData.end() && timestamp == entry->Timestamp;)
-                entry++;
+            // Filtered out by date.
+            _Batches.pop_back();
         }
     }
 
@@ -719,6 +1491,7 @@ void ImGuiPerfTool::_Rebuild()
             mean_entry->OS = "";
             mean_entry->Cpu = "";
             mean_entry->Date = "";
+            mean_entry->Environment = "";
             visible_label_i++;
             if (i == 0)
                 mean_entry->DtDeltaMs = num_visible_labels / delta_rec;
@@ -732,20 +1505,6 @@ void ImGuiPerfTool::_Rebuild()
         IM_ASSERT(batch.Entries.Size == _LabelsVisible.Size);
     }
 
-    // Find number of bars (batches) each label will render.
-    for (ImGuiPerfToolBatch& batch : _Batches)
-    {
-        if (!_IsVisibleBuild(&batch))
-            continue;
-
-        for (ImGuiPerfToolEntry& entry : batch.Entries)
-        {
-            ImGuiID label_id = ImHashStr(entry.TestName);
-            int num_bars = _LabelBarCounts.GetInt(label_id) + 1;
-            _LabelBarCounts.SetInt(label_id, num_bars);
-        }
-    }
-
     // Index branches, used for per-branch colors.
     temp_set.Data.resize(0);    // ImHashStr(branch_name):linear_index
     int branch_index_last = 0;
@@ -786,22 +1545,44 @@ void ImGuiPerfTool::_Rebuild()
             batch.NumSamples = temp_set.GetInt(build_id, 1);
         }
     }
+    temp_set.Data.resize(0);
 
-    _NumVisibleBuilds = PerfToolCountBuilds(this, true);
     _NumUniqueBuilds = PerfToolCountBuilds(this, false);
+    _UpdateBuildVisibility();
+}
+
+// Update data depending on build visibility. Cheaper than a full _Rebuild(), as batches hold data of hidden builds too.
+void ImGuiPerfTool::_UpdateBuildVisibility()
+{
+    // Find number of bars (batches) each label will render. Every batch has an entry for every visible label.
+    int num_visible_batches = 0;
+    for (ImGuiPerfToolBatch& batch : _Batches)
+        if (_IsVisibleBuild(&batch))
+            num_visible_batches++;
+    _LabelBarCounts.Data.resize(0);
+    for (const char* label : _LabelsVisible)
+        _LabelBarCounts.SetInt(ImHashStr(label), num_visible_batches);
 
+    _NumVisibleBuilds = PerfToolCountBuilds(this, true);
     _CalculateLegendAlignment();
-    temp_set.Data.resize(0);
 }
 
 void ImGuiPerfTool::Clear()
 {
     _Labels.clear();
     _LabelsVisible.clear();
+    _LabelIndices.Clear();
+    _LabelVisibleIndices.clear();
+    _NumSrcLabels = 0;
     _Batches.clear_destruct();
+    _Groups.clear();
+    _GroupAggregates.clear_destruct();
     _Visibility.Clear();
     _SrcData.clear_destruct();
+    _SrcDataSortedCount = 0;
     _CsvParser->Clear();
+    _FileMapping->Close();
+    _FileData.clear();
 
     ImStrncpy(_FilterDateFrom, "9999-99-99", IM_ARRAYSIZE(_FilterDateFrom));
     ImStrncpy(_FilterDateTo, "0000-00-00", IM_ARRAYSIZE(_FilterDateFrom));
@@ -815,7 +1596,9 @@ bool ImGuiPerfTool::LoadCSV(const char* filename)
     Clear();
 
     ImGuiCsvParser* parser = _CsvParser;
-    parser->Columns = 11;
+    parser->Columns = PerfLogCsvColumn_COUNT;
+    parser->ColumnsMin = PerfLogCsvColumn_MinRequired;
+    parser->ColumnsExtraIgnored = true; // Perflog files written by newer versions
     if (!parser->Load(filename))
         return false;
 
@@ -823,24 +1606,250 @@ bool ImGuiPerfTool::LoadCSV(const char* filename)
     for (int row = 0; row < parser->Rows; row++)
     {
         ImGuiPerfToolEntry entry;
-        int col = 0;
-        sscanf(parser->GetCell(row, col++), "%llu", &entry.Timestamp);
-        entry.Category = parser->GetCell(row, col++);
-        entry.TestName = parser->GetCell(row, col++);
-        sscanf(parser->GetCell(row, col++), "%lf", &entry.DtDeltaMs);
-        sscanf(parser->GetCell(row, col++), "x%d", &entry.PerfStressAmount);
-        entry.GitBranchName = parser->GetCell(row, col++);
-        entry.BuildType = parser->GetCell(row, col++);
-        entry.Cpu = parser->GetCell(row, col++);
-        entry.OS = parser->GetCell(row, col++);
-        entry.Compiler = parser->GetCell(row, col++);
-        entry.Date = parser->GetCell(row, col++);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_Timestamp), "%llu", &entry.Timestamp);
+        entry.Category = parser->GetCell(row, PerfLogCsvColumn_Category);
+        entry.TestName = parser->GetCell(row, PerfLogCsvColumn_TestName);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMs), "%lf", &entry.DtDeltaMs);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_PerfStressAmount), "x%d", &entry.PerfStressAmount);
+        entry.GitBranchName = parser->GetCell(row, PerfLogCsvColumn_GitBranchName);
+        entry.BuildType = parser->GetCell(row, PerfLogCsvColumn_BuildType);
+        entry.Cpu = parser->GetCell(row, PerfLogCsvColumn_Cpu);
+        entry.OS = parser->GetCell(row, PerfLogCsvColumn_OS);
+        entry.Compiler = parser->GetCell(row, PerfLogCsvColumn_Compiler);
+        entry.Date = parser->GetCell(row, PerfLogCsvColumn_Date);
+        if (sscanf(parser->GetCell(row, PerfLogCsvColumn_NumFrames), "%d", &entry.NumFrames) == 1)
+        {
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsMedian), "%lf", &entry.DtDeltaMsMedian);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsP90), "%lf", &entry.DtDeltaMsP90);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsP99), "%lf", &entry.DtDeltaMsP99);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsStdDev), "%lf", &entry.DtDeltaMsStdDev);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsIqm), "%lf", &entry.DtDeltaMsIqm);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsFrameMin), "%lf", &entry.DtDeltaMsFrameMin);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_DtDeltaMsFrameMax), "%lf", &entry.DtDeltaMsFrameMax);
+        }
+        if (sscanf(parser->GetCell(row, PerfLogCsvColumn_NumCpuFrames), "%d", &entry.NumCpuFrames) == 1)
+        {
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_CpuGuiFuncMs), "%lf", &entry.CpuGuiFuncMs);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_CpuNewFrameMs), "%lf", &entry.CpuNewFrameMs);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_CpuEndFrameMs), "%lf", &entry.CpuEndFrameMs);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_CpuRenderMs), "%lf", &entry.CpuRenderMs);
+            sscanf(parser->GetCell(row, PerfLogCsvColumn_CpuEngineMs), "%lf", &entry.CpuEngineMs);
+        }
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_HwInstructions), "%lf", &entry.HwInstructions);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_HwCycles), "%lf", &entry.HwCycles);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_HwCacheMisses), "%lf", &entry.HwCacheMisses);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_HwBranchMisses), "%lf", &entry.HwBranchMisses);
+        entry.Environment = parser->GetCell(row, PerfLogCsvColumn_Environment);
+        sscanf(parser->GetCell(row, PerfLogCsvColumn_LoadAverage), "%lf", &entry.LoadAverage);
         AddEntry(&entry);
     }
 
     return true;
 }
 
+bool ImGuiPerfTool::Load(const char* filename)
+{
+    if (filename == NULL)
+        filename = IMGUI_PERFLOG_DEFAULT_FILENAME;
+
+    // Detect format from file contents
+    char magic[sizeof(PerfLogFileMagic)] = {};
+    if (FILE* f = fopen(filename, "rb"))
+    {
+        if (fread(magic, 1, sizeof(magic), f) != sizeof(magic))
+            magic[0] = 0;
+        fclose(f);
+    }
+    if (memcmp(magic, PerfLogFileMagic, sizeof(magic)) == 0)
+        return LoadBinary(filename);
+    return LoadCSV(filename);
+}
+
+bool ImGuiPerfTool::LoadBinary(const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    Clear();
+
+    ImFileMapping* mapping = _FileMapping;
+    if (!mapping->Open(filename))
+        return false;
+
+    const char* data = (const char*)mapping->Data;
+    const size_t data_size = mapping->Size;
+    ImGuiPerfLogFileHeader file_header = {};
+    if (data_size >= sizeof(file_header))
+        memcpy(&file_header, data, sizeof(file_header));
+    if (memcmp(file_header.Magic, PerfLogFileMagic, sizeof(file_header.Magic)) != 0)
+    {
+        fprintf(stderr, "'%s' is not a binary perflog file.\n", filename);
+        mapping->Close();
+        return false;
+    }
+    if (file_header.Version != PerfLogFileVersion)
+    {
+        fprintf(stderr, "Binary perflog '%s' has unsupported version %u.\n", filename, file_header.Version);
+        mapping->Close();
+        return false;
+    }
+
+    // Validate blocks and count rows, so entries are allocated once
+    ImVector<size_t> blocks;
+    int rows_count = 0;
+    size_t offset = sizeof(file_header);
+    while (offset + sizeof(ImGuiPerfLogBlockHeader) <= data_size)
+    {
+        ImGuiPerfLogBlockHeader header;
+        memcpy(&header, data + offset, sizeof(header));
+        if (header.Magic != PerfLogBlockMagic || header.BlockSize < sizeof(header) || header.BlockSize > data_size - offset || (header.BlockSize & 7) != 0)
+            break;
+
+        // Check block contents fit
+        const char* column_types = data + offset + sizeof(header);
+        size_t contents_size = sizeof(header) + PerfLogAlign(header.ColumnCount);
+        bool valid = contents_size <= header.BlockSize;
+        for (ImU32 column_n = 0; valid && column_n < header.ColumnCount; column_n++)
+        {
+            const ImGuiPerfLogColumnType type = (ImGuiPerfLogColumnType)column_types[column_n];
+            valid = type <= ImGuiPerfLogColumnType_String && (column_n >= IM_ARRAYSIZE(PerfLogColumns) || type == PerfLogColumns[column_n].Type);
+            contents_size += PerfLogAlign(PerfLogGetColumnTypeSize(type) * header.RowCount);
+            valid &= contents_size <= header.BlockSize;
+        }
+        valid &= contents_size + header.StringsSize == header.BlockSize;
+        valid &= header.StringsSize == 0 || data[offset + header.BlockSize - 1] == 0; // Strings are zero-terminated
+        if (!valid)
+            break;
+
+        blocks.push_back(offset);
+        rows_count += (int)header.RowCount;
+        offset += (size_t)header.BlockSize;
+    }
+    if (offset != data_size)
+        fprintf(stderr, "Binary perflog '%s' has %d bytes of invalid or truncated data, ignored.\n", filename, (int)(data_size - offset));
+
+    // Read perf test entries from columns
+    _SrcData.reserve(_SrcData.Size + rows_count);
+    for (size_t block_offset : blocks)
+    {
+        ImGuiPerfLogBlockHeader header;
+        memcpy(&header, data + block_offset, sizeof(header));
+        const char* column_types = data + block_offset + sizeof(header);
+        const char* strings = data + block_offset + header.BlockSize - header.StringsSize;
+
+        // Locate columns we know about
+        const char* columns[IM_ARRAYSIZE(PerfLogColumns)] = {};
+        const char* p = column_types + PerfLogAlign(header.ColumnCount);
+        for (ImU32 column_n = 0; column_n < header.ColumnCount; column_n++)
+        {
+            if (column_n < IM_ARRAYSIZE(PerfLogColumns))
+                columns[column_n] = p;
+            p += PerfLogAlign(PerfLogGetColumnTypeSize((ImGuiPerfLogColumnType)column_types[column_n]) * header.RowCount);
+        }
+
+        for (ImU32 row_n = 0; row_n < header.RowCount; row_n++)
+        {
+            ImGuiPerfToolEntry entry;
+            for (int column_n = 0; column_n < IM_ARRAYSIZE(PerfLogColumns); column_n++)
+            {
+                const ImGuiPerfLogColumn& column = PerfLogColumns[column_n];
+                void* dst = (char*)&entry + column.Offset;
+                if (column.Type == ImGuiPerfLogColumnType_String)
+                {
+                    ImU32 str_offset = header.StringsSize; // Missing column or invalid offset: use empty string
+                    if (columns[column_n] != NULL)
+                        memcpy(&str_offset, columns[column_n] + row_n * sizeof(ImU32), sizeof(ImU32));
+                    *(const char**)dst = (str_offset < header.StringsSize) ? strings + str_offset : "";
+                }
+                else if (columns[column_n] != NULL)
+                {
+                    const size_t value_size = PerfLogGetColumnTypeSize(column.Type);
+                    memcpy(dst, columns[column_n] + row_n * value_size, value_size);
+                }
+            }
+            AddEntry(&entry);
+        }
+    }
+
+    return true;
+}
+
+// Entry strings may point into a memory mapping of the destination file: never truncate it in place.
+// Data is written to a temporary file which then replaces destination file.
+bool ImGuiPerfTool::Save(const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    Str256f tmp_filename("%s.tmp", filename);
+    ImFileDelete(tmp_filename.c_str());
+    const bool ret = PerfLogIsBinaryFilename(filename) ? SaveBinary(tmp_filename.c_str()) : SaveCSV(tmp_filename.c_str());
+    if (ret && rename(tmp_filename.c_str(), filename) == 0)
+        return true;
+    if (ret && ImFileDelete(filename) && rename(tmp_filename.c_str(), filename) == 0) // Windows: rename() fails when destination exists.
+        return true;
+    if (ret)
+        fprintf(stderr, "Unable to replace '%s', perftool entries were not saved.\n", filename);
+    ImFileDelete(tmp_filename.c_str());
+    return false;
+}
+
+static void PerfToolRebaseString(const char** p_str, const char* src_begin, const char* src_end, const char* dst)
+{
+    if (*p_str >= src_begin && *p_str < src_end)
+        *p_str = dst + (*p_str - src_begin);
+}
+
+// Copy memory mapped perflog to heap and close the mapping, so loaded file may be overwritten, renamed over or deleted.
+// (Windows doesn't allow any of that while a file is mapped, and on other platforms truncating a mapped file would crash us)
+void ImGuiPerfTool::_DetachFileMapping()
+{
+    if (!_FileMapping->IsOpen())
+        return;
+
+    const char* src_begin = (const char*)_FileMapping->Data;
+    const char* src_end = src_begin + _FileMapping->Size;
+    IM_ASSERT(_FileData.empty());
+    _FileData.resize((int)_FileMapping->Size);
+    memcpy(_FileData.Data, src_begin, _FileMapping->Size);
+    for (ImGuiPerfToolEntry& entry : _SrcData)
+    {
+        const char** strings[] = { &entry.Category, &entry.TestName, &entry.GitBranchName, &entry.BuildType, &entry.Cpu, &entry.OS, &entry.Compiler, &entry.Date, &entry.Environment };
+        for (const char** p_str : strings)
+            PerfToolRebaseString(p_str, src_begin, src_end, _FileData.Data);
+    }
+    for (const char*& label : _Labels)
+        PerfToolRebaseString(&label, src_begin, src_end, _FileData.Data);
+    _FileMapping->Close();
+
+    // Groups and batches hold copies of entry strings: rebuild them. Sorting and label indices remain valid.
+    _Groups.clear();
+    _GroupAggregates.clear_destruct();
+    _Batches.clear_destruct();
+}
+
+bool ImGuiPerfTool::SaveCSV(const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    _DetachFileMapping();
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+        return false;
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Unable to open '%s', perftool entries were not saved.\n", filename);
+        return false;
+    }
+    for (const ImGuiPerfToolEntry& entry : _SrcData)
+        PerfLogWriteCSVRow(f, &entry);
+    fclose(f);
+    return true;
+}
+
+bool ImGuiPerfTool::SaveBinary(const char* filename)
+{
+    IM_ASSERT(filename != NULL);
+    _DetachFileMapping();
+    ImFileDelete(filename);
+    return PerfLogWriteBinaryFile(_SrcData.Data, _SrcData.Size, filename, "wb");
+}
+
 void ImGuiPerfTool::ViewOnly(const char** perf_names)
 {
     // Data would not be built if we tried to view perftool of a particular test without first opening perftool via button. We need data to be built to hide perf tests.
@@ -890,7 +1899,8 @@ bool ImGuiPerfTool::_IsVisibleBuild(ImGuiPerfToolEntry* entry)
         _Visibility.GetBool(ImHashStr(entry->Compiler), true) &&
         _Visibility.GetBool(ImHashStr(entry->Cpu), true) &&
         _Visibility.GetBool(ImHashStr(entry->OS), true) &&
-        _Visibility.GetBool(ImHashStr(entry->BuildType), true);
+        _Visibility.GetBool(ImHashStr(entry->BuildType), true) &&
+        _Visibility.GetBool(ImHashStr(entry->Environment), true);
 }
 
 bool ImGuiPerfTool::_IsVisibleTest(const char* test_name)
@@ -1007,8 +2017,26 @@ bool ImGuiPerfTool::SaveHtmlReport(const char* file_name, const char* image_file
                 case 8:  fprintf(fp, "| %.2f ", entry->DtDeltaMs);          break;
                 case 9:  fprintf(fp, "| %.2f ", entry->DtDeltaMsMin);       break;
                 case 10: fprintf(fp, "| %.2f ", entry->DtDeltaMsMax);       break;
-                case 11: fprintf(fp, "| %d ", entry->NumSamples);           break;
-                case 12: FormatVsBaseline(entry, baseline_entry, label); fprintf(fp, "| %s ", label.c_str()); break;
+                case 11: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsMedian);   else fprintf(fp, "| -- "); break;
+                case 12: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsP90);      else fprintf(fp, "| -- "); break;
+                case 13: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsP99);      else fprintf(fp, "| -- "); break;
+                case 14: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsStdDev);   else fprintf(fp, "| -- "); break;
+                case 15: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsIqm);      else fprintf(fp, "| -- "); break;
+                case 16: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsFrameMin); else fprintf(fp, "| -- "); break;
+                case 17: if (entry->NumFrames > 0) fprintf(fp, "| %.2f ", entry->DtDeltaMsFrameMax); else fprintf(fp, "| -- "); break;
+                case 18: if (entry->NumCpuFrames > 0) fprintf(fp, "| %.3f ", entry->CpuGuiFuncMs);  else fprintf(fp, "| -- "); break;
+                case 19: if (entry->NumCpuFrames > 0) fprintf(fp, "| %.3f ", entry->CpuNewFrameMs); else fprintf(fp, "| -- "); break;
+                case 20: if (entry->NumCpuFrames > 0) fprintf(fp, "| %.3f ", entry->CpuEndFrameMs); else fprintf(fp, "| -- "); break;
+                case 21: if (entry->NumCpuFrames > 0) fprintf(fp, "| %.3f ", entry->CpuRenderMs);   else fprintf(fp, "| -- "); break;
+                case 22: if (entry->NumCpuFrames > 0) fprintf(fp, "| %.3f ", entry->CpuEngineMs);   else fprintf(fp, "| -- "); break;
+                case 23: if (entry->HwInstructions >= 0.0) fprintf(fp, "| %.0f ", entry->HwInstructions); else fprintf(fp, "| -- "); break;
+                case 24: if (entry->HwCycles >= 0.0)       fprintf(fp, "| %.0f ", entry->HwCycles);       else fprintf(fp, "| -- "); break;
+                case 25: if (entry->HwCacheMisses >= 0.0)  fprintf(fp, "| %.0f ", entry->HwCacheMisses);  else fprintf(fp, "| -- "); break;
+                case 26: if (entry->HwBranchMisses >= 0.0) fprintf(fp, "| %.0f ", entry->HwBranchMisses); else fprintf(fp, "| -- "); break;
+                case 27: fprintf(fp, "| %d ", entry->NumSamples);           break;
+                case 28: FormatVsBaseline(entry, baseline_entry, label); fprintf(fp, "| %s ", label.c_str()); break;
+                case 29: fprintf(fp, "| %s ", entry->Environment);          break;
+                case 30: if (entry->LoadAverage >= 0.0) fprintf(fp, "| %.2f ", entry->LoadAverage); else fprintf(fp, "| -- "); break;
                 default: IM_ASSERT(0); break;
                 }
             }
@@ -1053,7 +2081,7 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
     }
 
     if (ImGui::IsWindowAppearing() && Empty())
-        LoadCSV();
+        Load();
 
     // -----------------------------------------------------------------------------------------------------------------
     // Render utility buttons
@@ -1158,6 +2186,10 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
     ImGui::SameLine();
     if (ImGui::IsItemHovered())
         ImGui::SetTooltip("Generate a report and open it in the browser.");
+    ImGui::Checkbox("Scaling", &_ShowScaling);
+    if (ImGui::IsItemHovered())
+        ImGui::SetTooltip("Display results of perf tests across stress amounts, recorded in scaling-curve mode.");
+    ImGui::SameLine();
 
     // Align help button to the right.
     ImGui::SetCursorPosX(ImGui::GetCursorPosX() + ImMax(0.0f, ImGui::GetContentRegionAvail().x - ImGui::CalcTextSize("(?)").x));
@@ -1176,7 +2208,7 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
         ImGuiStorage& temp_set = _TempSet;
         temp_set.Data.resize(0);    // ImHashStr(BuildProperty):seen
 
-        static const char* columns[] = { "Branch", "Build", "CPU", "OS", "Compiler" };
+        static const char* columns[] = { "Branch", "Build", "CPU", "OS", "Compiler", "Environment" };
         bool show_all = ImGui::Button("Show All");
         ImGui::SameLine();
         bool hide_all = ImGui::Button("Hide All");
@@ -1186,11 +2218,13 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
                 ImGui::TableSetupColumn(columns[i]);
             ImGui::TableHeadersRow();
 
-            // Find columns with nothing checked.
-            bool checked_any[] = { false, false, false, false, false };
-            for (ImGuiPerfToolEntry& entry : _SrcData)
+            // Find columns with nothing checked. Build properties are same for all entries of a build, so it is enough
+            // to look at first entry of every group.
+            bool checked_any[] = { false, false, false, false, false, false };
+            for (ImGuiPerfToolGroup& group : _Groups)
             {
-                const char* properties[] = { entry.GitBranchName, entry.BuildType, entry.Cpu, entry.OS, entry.Compiler };
+                ImGuiPerfToolEntry& entry = _SrcData.Data[group.SrcStart];
+                const char* properties[] = { entry.GitBranchName, entry.BuildType, entry.Cpu, entry.OS, entry.Compiler, entry.Environment };
                 for (int i = 0; i < IM_ARRAYSIZE(properties); i++)
                 {
                     ImGuiID hash = ImHashStr(properties[i]);
@@ -1205,15 +2239,16 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
                 offsetof(ImGuiPerfToolEntry, Cpu),
                 offsetof(ImGuiPerfToolEntry, OS),
                 offsetof(ImGuiPerfToolEntry, Compiler),
+                offsetof(ImGuiPerfToolEntry, Environment),
             };
 
             ImGui::TableNextRow();
             for (int i = 0; i < IM_ARRAYSIZE(property_offsets); i++)
             {
                 ImGui::TableSetColumnIndex(i);
-                for (ImGuiPerfToolEntry& entry : _SrcData)
+                for (ImGuiPerfToolGroup& group : _Groups)
                 {
-                    const char* property = *(const char**)((const char*)&entry + property_offsets[i]);
+                    const char* property = *(const char**)((const char*)&_SrcData.Data[group.SrcStart] + property_offsets[i]);
                     ImGuiID hash = ImHashStr(property);
                     if (temp_set.GetBool(hash))
                         continue;
@@ -1222,14 +2257,10 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
                     bool visible = _Visibility.GetBool(hash, true) || show_all;
                     if (hide_all)
                         visible = false;
-                    bool modified = ImGui::Checkbox(property, &visible) || show_all || hide_all;
+                    bool modified = ImGui::Checkbox(property[0] ? property : "(unknown)", &visible) || show_all || hide_all;   // Environment is empty in older perflog files
                     _Visibility.SetBool(hash, visible);
                     if (modified)
-                    {
-                        _CalculateLegendAlignment();
-                        _NumVisibleBuilds = PerfToolCountBuilds(this, true);
-                        dirty = true;
-                    }
+                        _UpdateBuildVisibility();
                     if (!checked_any[i])
                     {
                         ImGui::TableSetBgColor(ImGuiTableBgTarget_CellBg, ImColor(1.0f, 0.0f, 0.0f, 0.2f));
@@ -1255,7 +2286,11 @@ void ImGuiPerfTool::ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open)
         _Rebuild();
 
     // Rendering a plot of empty dataset is not possible.
-    if (_Batches.empty() || _LabelsVisible.Size == 0 || _NumVisibleBuilds == 0)
+    if (_ShowScaling)
+    {
+        _ShowScalingView();
+    }
+    else if (_Batches.empty() || _LabelsVisible.Size == 0 || _NumVisibleBuilds == 0)
     {
         ImGui::TextUnformatted("No data is available. Run some perf tests or adjust filter settings.");
     }
@@ -1648,6 +2683,39 @@ void ImGuiPerfTool::_ShowEntriesTable()
         if (ImGui::TableNextColumn())
             ImGui::Text("%.3lf", entry->DtDeltaMsMax);
 
+        // Distribution of frame times: Median, P90, P99, StdDev, IQM, Fastest, Slowest
+        const double* distribution_values[] = { &entry->DtDeltaMsMedian, &entry->DtDeltaMsP90, &entry->DtDeltaMsP99, &entry->DtDeltaMsStdDev, &entry->DtDeltaMsIqm, &entry->DtDeltaMsFrameMin, &entry->DtDeltaMsFrameMax };
+        for (const double* value : distribution_values)
+            if (ImGui::TableNextColumn())
+            {
+                if (entry->NumFrames > 0)
+                    ImGui::Text("%.3lf", *value);
+                else
+                    ImGui::TextDisabled("--");
+            }
+
+        // CPU time per phase: GuiFunc, NewFrame, EndFrame, Render, Engine
+        const double* cpu_values[] = { &entry->CpuGuiFuncMs, &entry->CpuNewFrameMs, &entry->CpuEndFrameMs, &entry->CpuRenderMs, &entry->CpuEngineMs };
+        for (const double* value : cpu_values)
+            if (ImGui::TableNextColumn())
+            {
+                if (entry->NumCpuFrames > 0)
+                    ImGui::Text("%.3lf", *value);
+                else
+                    ImGui::TextDisabled("--");
+            }
+
+        // Hardware counters: Instructions, Cycles, Cache misses, Branch misses
+        const double* hw_values[] = { &entry->HwInstructions, &entry->HwCycles, &entry->HwCacheMisses, &entry->HwBranchMisses };
+        for (const double* value : hw_values)
+            if (ImGui::TableNextColumn())
+            {
+                if (*value >= 0.0)
+                    ImGui::Text("%.0lf", *value);
+                else
+                    ImGui::TextDisabled("--");
+            }
+
         // Num samples
         if (ImGui::TableNextColumn())
             ImGui::Text("%d", entry->NumSamples);
@@ -1673,6 +2741,19 @@ void ImGuiPerfTool::_ShowEntriesTable()
             }
         }
 
+        // Environment
+        if (ImGui::TableNextColumn())
+            ImGui::TextUnformatted(entry->Environment);
+
+        // Load average
+        if (ImGui::TableNextColumn())
+        {
+            if (entry->LoadAverage >= 0.0)
+                ImGui::Text("%.2lf", entry->LoadAverage);
+            else
+                ImGui::TextDisabled("--");
+        }
+
         if (_PlotHoverTest == entry_index_sorted && scroll_into_view)
         {
             ImGuiTable* table = ImGui::GetCurrentTable();
@@ -1691,6 +2772,198 @@ void ImGuiPerfTool::_ShowEntriesTable()
     ImGui::EndTable();
 }
 
+static int IMGUI_CDECL PerfToolComparerScaling(const void* lhs, const void* rhs)
+{
+    const ImGuiPerfToolEntry* a = (const ImGuiPerfToolEntry*)lhs;
+    const ImGuiPerfToolEntry* b = (const ImGuiPerfToolEntry*)rhs;
+    int result = strcmp(a->TestName, b->TestName);
+    if (result == 0)
+        result = (int)ImClamp<ImS64>((ImS64)a->Timestamp - (ImS64)b->Timestamp, -1, +1);
+    if (result == 0)
+        result = a->PerfStressAmount - b->PerfStressAmount;
+    return result;
+}
+
+// Scaling of a test got noticeably worse since previous run. Neighbor classes (e.g. O(N) and O(N log N)) are hard to
+// tell apart on noisy data, so a single class step is not enough.
+static bool PerfToolIsScalingWorse(const ImGuiPerfToolScalingFit& fit, const ImGuiPerfToolScalingFit& prev_fit)
+{
+    if (fit.Complexity == ImGuiPerfToolComplexity_Unknown || prev_fit.Complexity == ImGuiPerfToolComplexity_Unknown)
+        return false;
+    return fit.Complexity >= prev_fit.Complexity + 2 || fit.Exponent >= prev_fit.Exponent + 0.5;
+}
+
+// Load results of scaling-curve mode and fit every run of every test.
+void ImGuiPerfTool::_RebuildScaling()
+{
+    _ScalingDirty = false;
+    _ScalingCurves.resize(0);
+    if (_ScalingData == NULL)
+        _ScalingData = IM_NEW(ImGuiPerfTool)();
+    if (!ImFileExist(IMGUI_PERFLOG_SCALING_FILENAME) || !_ScalingData->Load(IMGUI_PERFLOG_SCALING_FILENAME))
+    {
+        _ScalingData->Clear();
+        return;
+    }
+
+    // Sort by test name, then by run, then by stress amount: entries of one run of a test make one curve.
+    ImVector<ImGuiPerfToolEntry>& entries = _ScalingData->_SrcData;
+    ImQsort(entries.Data, (size_t)entries.Size, sizeof(ImGuiPerfToolEntry), PerfToolComparerScaling);
+    ImVector<double> stress_amounts;
+    ImVector<double> dt_delta_ms;
+    for (int start = 0, end = 0; start < entries.Size; start = end)
+    {
+        for (end = start + 1; end < entries.Size; end++)
+            if (entries[end].Timestamp != entries[start].Timestamp || strcmp(entries[end].TestName, entries[start].TestName) != 0)
+                break;
+        stress_amounts.resize(0);
+        dt_delta_ms.resize(0);
+        for (int i = start; i < end; i++)
+        {
+            stress_amounts.push_back((double)ImMax(entries[i].PerfStressAmount, 1));
+            dt_delta_ms.push_back(entries[i].DtDeltaMs);
+        }
+
+        ImGuiPerfToolScalingCurve curve;
+        curve.SrcStart = start;
+        curve.SrcCount = end - start;
+        ImGuiTestEngine_PerfToolFitScaling(stress_amounts.Data, dt_delta_ms.Data, stress_amounts.Size, &curve.Fit);
+        if (!_ScalingCurves.empty() && strcmp(entries[_ScalingCurves.back().SrcStart].TestName, entries[start].TestName) == 0)
+            curve.PrevCurve = _ScalingCurves.Size - 1;
+        _ScalingCurves.push_back(curve);
+    }
+}
+
+void ImGuiPerfTool::_ShowScalingView()
+{
+    if (_ScalingDirty)
+        _RebuildScaling();
+    if (_ScalingCurves.empty())
+    {
+        ImGui::TextUnformatted("No scaling data is available. Run perf tests with ImGuiTestEngineIO::ConfigPerfScalingSteps > 0.");
+        return;
+    }
+
+#if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+    // Latest curve of selected test (curves of a test are sorted by timestamp). Select first test if selection is not in data.
+    int selected_curve = -1;
+    for (int pass = 0; pass < 2 && selected_curve == -1; pass++)
+    {
+        if (pass == 1)
+            _ScalingSelectedTest = ImHashStr(_ScalingData->_SrcData[_ScalingCurves[0].SrcStart].TestName);
+        for (int curve_index = 0; curve_index < _ScalingCurves.Size; curve_index++)
+            if (ImHashStr(_ScalingData->_SrcData[_ScalingCurves[curve_index].SrcStart].TestName) == _ScalingSelectedTest)
+                selected_curve = curve_index;
+    }
+
+    float plot_height = 0.0f;
+    float& table_height = _InfoTableHeight;
+    ImGui::Splitter("splitter", &plot_height, &table_height, ImGuiAxis_Y, +1);
+
+    // Plot most recent runs of selected test. Log-log scale: slope of a curve is the exponent of N.
+    if (ImGui::BeginChild(ImGui::GetID("scaling-plot"), ImVec2(0, plot_height)) && selected_curve != -1)
+    {
+        if (ImPlot::BeginPlot("PerfToolScaling", ImVec2(-1, -1), ImPlotFlags_NoTitle))
+        {
+            ImPlot::SetupAxes("Stress amount", "Delta time (ms)", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+            ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
+            ImPlot::SetupAxisScale(ImAxis_Y1, ImPlotScale_Log10);
+            ImPlot::SetupLegend(ImPlotLocation_NorthWest);
+            ImVector<double> xs;
+            ImVector<double> ys;
+            for (int curve_index = selected_curve, n = 0; curve_index != -1 && n < 8; curve_index = _ScalingCurves[curve_index].PrevCurve, n++)
+            {
+                const ImGuiPerfToolScalingCurve& curve = _ScalingCurves[curve_index];
+                xs.resize(0);
+                ys.resize(0);
+                for (int i = curve.SrcStart; i < curve.SrcStart + curve.SrcCount; i++)
+                {
+                    xs.push_back((double)_ScalingData->_SrcData[i].PerfStressAmount);
+                    ys.push_back(_ScalingData->_SrcData[i].DtDeltaMs);
+                }
+                const ImGuiPerfToolEntry& entry = _ScalingData->_SrcData[curve.SrcStart];
+                char date[64];
+                FormatDateAndTime(entry.Timestamp, date, IM_ARRAYSIZE(date));
+                Str256f label("%s %s %s: %s, N^%.2f###%d", date, entry.GitBranchName, entry.BuildType,
+                    ImGuiTestEngine_PerfToolGetComplexityName(curve.Fit.Complexity), curve.Fit.Exponent, curve_index);
+                ImPlot::SetNextMarkerStyle(ImPlotMarker_Circle);
+                ImPlot::PlotLine(label.c_str(), xs.Data, ys.Data, xs.Size);
+            }
+            ImPlot::EndPlot();
+        }
+    }
+    ImGui::EndChild();
+
+    if (table_height > 0.0f)
+    {
+        if (ImGui::BeginChild(ImGui::GetID("scaling-table"), ImVec2(0, table_height)))
+            _ShowScalingTable();
+        ImGui::EndChild();
+    }
+#else
+    _ShowScalingTable();
+#endif
+}
+
+// One row per test: fit of its latest run, compared to previous run.
+void ImGuiPerfTool::_ShowScalingTable()
+{
+    ImGuiTableFlags table_flags = ImGuiTableFlags_Borders | ImGuiTableFlags_Resizable | ImGuiTableFlags_SizingFixedFit | ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg;
+    if (!ImGui::BeginTable("PerfScaling", 7, table_flags))
+        return;
+    ImGui::TableSetupColumn("Test Name");
+    ImGui::TableSetupColumn("Date");
+    ImGui::TableSetupColumn("Build");
+    ImGui::TableSetupColumn("Stress");
+    ImGui::TableSetupColumn("Complexity");
+    ImGui::TableSetupColumn("Exponent");
+    ImGui::TableSetupColumn("Previous");
+    ImGui::TableSetupScrollFreeze(0, 1);
+    ImGui::TableHeadersRow();
+
+    for (int curve_index = 0; curve_index < _ScalingCurves.Size; curve_index++)
+    {
+        if (curve_index + 1 < _ScalingCurves.Size && _ScalingCurves[curve_index + 1].PrevCurve == curve_index)
+            continue; // Not latest run of this test
+        const ImGuiPerfToolScalingCurve& curve = _ScalingCurves[curve_index];
+        const ImGuiPerfToolScalingCurve* prev_curve = (curve.PrevCurve != -1) ? &_ScalingCurves[curve.PrevCurve] : NULL;
+        const ImGuiPerfToolEntry& first = _ScalingData->_SrcData[curve.SrcStart];
+        const ImGuiPerfToolEntry& last = _ScalingData->_SrcData[curve.SrcStart + curve.SrcCount - 1];
+        const ImGuiID test_id = ImHashStr(first.TestName);
+
+        ImGui::PushID(curve_index);
+        ImGui::TableNextRow();
+        if (prev_curve != NULL && PerfToolIsScalingWorse(curve.Fit, prev_curve->Fit))
+            ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg1, ImColor(1.0f, 0.0f, 0.0f, 0.2f));
+
+        ImGui::TableNextColumn();
+        if (ImGui::Selectable(first.TestName, _ScalingSelectedTest == test_id, ImGuiSelectableFlags_SpanAllColumns))
+            _ScalingSelectedTest = test_id;
+
+        char date[64];
+        FormatDateAndTime(first.Timestamp, date, IM_ARRAYSIZE(date));
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(date);
+        ImGui::TableNextColumn();
+        ImGui::Text("%s %s %s", first.GitBranchName, first.BuildType, first.Compiler);
+        ImGui::TableNextColumn();
+        ImGui::Text("x%d..x%d", first.PerfStressAmount, last.PerfStressAmount);
+        ImGui::TableNextColumn();
+        ImGui::TextUnformatted(ImGuiTestEngine_PerfToolGetComplexityName(curve.Fit.Complexity));
+        if (ImGui::IsItemHovered())
+            ImGui::SetTooltip("%d points, R^2 %.3f", curve.Fit.NumPoints, curve.Fit.RSquared);
+        ImGui::TableNextColumn();
+        ImGui::Text("%.2f", curve.Fit.Exponent);
+        ImGui::TableNextColumn();
+        if (prev_curve != NULL)
+            ImGui::Text("%s, %.2f", ImGuiTestEngine_PerfToolGetComplexityName(prev_curve->Fit.Complexity), prev_curve->Fit.Exponent);
+        else
+            ImGui::TextDisabled("--");
+        ImGui::PopID();
+    }
+    ImGui::EndTable();
+}
+
 //-------------------------------------------------------------------------
 // [SECTION] SETTINGS
 //-------------------------------------------------------------------------
@@ -1743,13 +3016,14 @@ static void PerflogSettingsHandler_WriteAll(ImGuiContext*, ImGuiSettingsHandler*
 
     ImGuiStorage& temp_set = perftool->_TempSet;
     temp_set.Data.clear();
-    for (ImGuiPerfToolEntry& entry : perftool->_SrcData)
+    for (ImGuiPerfToolGroup& group : perftool->_Groups)
     {
-        const char* properties[] = { entry.GitBranchName, entry.BuildType, entry.Cpu, entry.OS, entry.Compiler };
+        ImGuiPerfToolEntry& entry = perftool->_SrcData.Data[group.SrcStart];
+        const char* properties[] = { entry.GitBranchName, entry.BuildType, entry.Cpu, entry.OS, entry.Compiler, entry.Environment };
         for (int i = 0; i < IM_ARRAYSIZE(properties); i++)
         {
             ImGuiID hash = ImHashStr(properties[i]);
-            if (!temp_set.GetBool(hash))
+            if (properties[i][0] && !temp_set.GetBool(hash))
             {
                 temp_set.SetBool(hash, true);
                 buf->appendf("BuildVisibility=%s,%d\n", properties[i], perftool->_Visibility.GetBool(hash, true));
@@ -1870,7 +3144,7 @@ void RegisterTests_TestEnginePerfTool(ImGuiTestEngine* e)
         // Restore original state.
         perftool->Clear();                                           // Clear test data and load original data
         ImFileDelete(temp_perf_csv);
-        perftool->LoadCSV();
+        perftool->Load();
         ctx->Yield();
 #if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
         ctx->MouseMoveToPos(plot_child->Rect().GetCenter());
@@ -1883,6 +3157,263 @@ void RegisterTests_TestEnginePerfTool(ImGuiTestEngine* e)
         SetPerfToolWindowOpen(ctx, perf_was_open);                   // Restore window visibility
     };
 
+    // ## Binary perflog: appends, CSV import and export.
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perflog_binary");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        const char* temp_csv = "output/testengine_perflog_binary.csv";
+        const char* temp_csv_2 = "output/testengine_perflog_binary_2.csv";
+        const char* temp_bin = "output/testengine_perflog_binary" IMGUI_PERFLOG_BINARY_EXTENSION;
+        ImFileDelete(temp_csv);
+        ImFileDelete(temp_bin);
+
+        const char* test_names[] = { "perf_a", "perf_b", "perf_c" };
+        ImGuiPerfToolEntry entries[6];
+        for (int n = 0; n < IM_ARRAYSIZE(entries); n++)
+        {
+            ImGuiPerfToolEntry& entry = entries[n];
+            entry.Timestamp = 1000 + n / 3;
+            entry.Category = "perf";
+            entry.TestName = test_names[n % 3];
+            entry.DtDeltaMs = 0.125 * n;
+            entry.PerfStressAmount = 5;
+            entry.GitBranchName = "master";
+            entry.BuildType = "Release";
+            entry.Cpu = "X64";
+            entry.OS = "Linux";
+            entry.Compiler = "GCC";
+            entry.Date = "2024-01-01";
+            entry.NumFrames = 100 + n;
+            entry.HwInstructions = (n & 1) ? 1000000.0 * n : -1.0;
+            entry.Environment = (n < 3) ? "Test CPU / 8 cores / performance / pinned" : "Test CPU / 8 cores / powersave";
+            entry.LoadAverage = 0.25 * n;
+            ImGuiTestEngine_PerfToolAppendToCSV(NULL, &entry, temp_csv);
+        }
+        IM_CHECK(ImGuiTestEngine_PerfToolAppendToBinary(entries, 4, temp_bin));
+        IM_CHECK(ImGuiTestEngine_PerfToolAppendToBinary(entries + 4, 2, temp_bin));
+
+        ImGuiPerfTool* perftool = IM_NEW(ImGuiPerfTool)();
+        IM_CHECK(perftool->Load(temp_bin));
+        IM_CHECK_EQ(perftool->_SrcData.Size, IM_ARRAYSIZE(entries));
+        IM_CHECK_STR_EQ(perftool->_SrcData[4].TestName, "perf_b");
+        IM_CHECK_EQ(perftool->_SrcData[4].Timestamp, 1001ULL);
+        IM_CHECK_EQ(perftool->_SrcData[4].NumFrames, 104);
+        IM_CHECK_EQ(perftool->_SrcData[5].HwInstructions, 5000000.0);
+        IM_CHECK_STR_EQ(perftool->_SrcData[4].Environment, "Test CPU / 8 cores / powersave");
+        IM_CHECK_EQ(perftool->_SrcData[2].LoadAverage, 0.5);
+
+        // Binary -> CSV export matches CSV written directly
+        IM_CHECK(perftool->Save(temp_csv_2));
+        size_t csv_size = 0, csv_size_2 = 0;
+        char* csv_data = (char*)ImFileLoadToMemory(temp_csv, "rb", &csv_size);
+        char* csv_data_2 = (char*)ImFileLoadToMemory(temp_csv_2, "rb", &csv_size_2);
+        IM_CHECK(csv_data != NULL && csv_data_2 != NULL);
+        IM_CHECK(csv_size == csv_size_2 && memcmp(csv_data, csv_data_2, csv_size) == 0);
+        IM_FREE(csv_data);
+        IM_FREE(csv_data_2);
+
+        // CSV -> binary import
+        IM_CHECK(perftool->Load(temp_csv));
+        IM_CHECK(perftool->Save(temp_bin));
+        IM_CHECK(perftool->Load(temp_bin));
+        IM_CHECK_EQ(perftool->_SrcData.Size, IM_ARRAYSIZE(entries));
+        IM_CHECK_STR_EQ(perftool->_SrcData[2].TestName, "perf_c");
+        IM_CHECK_EQ(perftool->_SrcData[3].HwInstructions, 3000000.0);
+        IM_CHECK_STR_EQ(perftool->_SrcData[1].Environment, "Test CPU / 8 cores / performance / pinned");
+        IM_CHECK_EQ(perftool->_SrcData[5].LoadAverage, 1.25);
+
+        // Save over currently loaded (memory mapped) binary file: mapping is closed first, entries now use a copy of its data
+        IM_CHECK(perftool->_FileMapping->IsOpen());
+        IM_CHECK(perftool->Save(temp_bin));
+        IM_CHECK(!perftool->_FileMapping->IsOpen());
+        IM_CHECK_STR_EQ(perftool->_SrcData[2].TestName, "perf_c");
+        IM_CHECK_STR_EQ(perftool->_SrcData[1].Environment, "Test CPU / 8 cores / performance / pinned");
+        IM_CHECK(perftool->Load(temp_bin));
+        IM_CHECK_EQ(perftool->_SrcData.Size, IM_ARRAYSIZE(entries));
+        IM_CHECK_STR_EQ(perftool->_SrcData[4].TestName, "perf_b");
+        IM_DELETE(perftool);
+
+        // Pending entries are written on flush, as a single block
+        size_t bin_size = 0, bin_size_2 = 0;
+        char* bin_data = (char*)ImFileLoadToMemory(temp_bin, "rb", &bin_size);
+        IM_FREE(bin_data);
+        ImFileDelete(temp_bin);
+        ImGuiPerfLogPendingEntries pending;
+        for (ImGuiPerfToolEntry& entry : entries)
+            ImGuiTestEngine_PerfToolAppend(NULL, &entry, temp_bin, &pending);
+        IM_CHECK(!ImFileExist(temp_bin));
+        IM_CHECK(ImGuiTestEngine_PerfToolFlush(&pending));
+        IM_CHECK_EQ(pending.Entries.Size, 0);
+        bin_data = (char*)ImFileLoadToMemory(temp_bin, "rb", &bin_size_2);
+        IM_FREE(bin_data);
+        IM_CHECK(bin_size > 0 && bin_size == bin_size_2);
+
+        ImFileDelete(temp_csv);
+        ImFileDelete(temp_csv_2);
+        ImFileDelete(temp_bin);
+    };
+
+    // ## CSV perflog written by older (less columns) and newer (more columns) versions.
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perflog_csv_columns");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        const char* temp_csv = "output/testengine_perflog_csv_columns.csv";
+        FILE* f = fopen(temp_csv, "wb");
+        IM_CHECK_NO_RET(f != NULL);
+        if (f == NULL)
+            return;
+        fprintf(f, "1000,perf,perf_old,0.500,x5,master,Release,X64,Linux,GCC,2024-01-01\n");
+        ImGuiPerfToolEntry entry;
+        entry.Timestamp = 1001;
+        entry.Category = "perf";
+        entry.TestName = "perf_current";
+        entry.DtDeltaMs = 0.25;
+        entry.PerfStressAmount = 5;
+        entry.GitBranchName = "master";
+        entry.BuildType = "Release";
+        entry.Cpu = "X64";
+        entry.OS = "Linux";
+        entry.Compiler = "GCC";
+        entry.Date = "2024-01-01";
+        entry.NumFrames = 100;
+        entry.LoadAverage = 0.75;
+        PerfLogWriteCSVRow(f, &entry);
+        entry.Timestamp = 1002;
+        entry.TestName = "perf_new";
+        PerfLogWriteCSVRow(f, &entry);
+        fseek(f, -1, SEEK_END);     // Append two columns to last row
+        fprintf(f, ",extra,42\n");
+        fclose(f);
+
+        ImGuiPerfTool* perftool = IM_NEW(ImGuiPerfTool)();
+        IM_CHECK(perftool->LoadCSV(temp_csv));
+        IM_CHECK_EQ(perftool->_SrcData.Size, 3);
+        IM_CHECK_STR_EQ(perftool->_SrcData[0].TestName, "perf_old");
+        IM_CHECK_EQ(perftool->_SrcData[0].DtDeltaMs, 0.5);
+        IM_CHECK_STR_EQ(perftool->_SrcData[1].TestName, "perf_current");
+        IM_CHECK_EQ(perftool->_SrcData[1].NumFrames, 100);
+        IM_CHECK_STR_EQ(perftool->_SrcData[2].TestName, "perf_new");
+        IM_CHECK_EQ(perftool->_SrcData[2].LoadAverage, 0.75);
+        IM_DELETE(perftool);
+        ImFileDelete(temp_csv);
+    };
+
+    // ## Fit perf results across stress amounts to complexity classes.
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_perftool_fit_scaling");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // Fixed cost + cost per item, at stress amounts x5..x160, with +/-2% deterministic noise
+        const ImGuiPerfToolComplexity complexities[] = { ImGuiPerfToolComplexity_O1, ImGuiPerfToolComplexity_OLogN, ImGuiPerfToolComplexity_ON, ImGuiPerfToolComplexity_ONLogN, ImGuiPerfToolComplexity_ON2 };
+        for (ImGuiPerfToolComplexity complexity : complexities)
+        {
+            double stress_amounts[6];
+            double dt_delta_ms[6];
+            for (int i = 0; i < IM_ARRAYSIZE(stress_amounts); i++)
+            {
+                const double n = stress_amounts[i] = (double)(5 << i);
+                dt_delta_ms[i] = 0.05 + 0.002 * PerfToolComplexityFunc(complexity, n);
+                dt_delta_ms[i] *= (i & 1) ? 1.02 : 0.98;
+            }
+            ImGuiPerfToolScalingFit fit;
+            IM_CHECK(ImGuiTestEngine_PerfToolFitScaling(stress_amounts, dt_delta_ms, IM_ARRAYSIZE(stress_amounts), &fit));
+            ctx->LogDebug("%s: fitted %s, exponent %.2f, R^2 %.3f", ImGuiTestEngine_PerfToolGetComplexityName(complexity), ImGuiTestEngine_PerfToolGetComplexityName(fit.Complexity), fit.Exponent, fit.RSquared);
+            IM_CHECK_EQ((int)fit.Complexity, (int)complexity);
+            IM_CHECK_EQ(fit.NumPoints, IM_ARRAYSIZE(stress_amounts));
+        }
+
+        // Linear to quadratic is flagged, small exponent changes are not
+        ImGuiPerfToolScalingFit linear, quadratic;
+        linear.Complexity = ImGuiPerfToolComplexity_ON;
+        linear.Exponent = 0.9;
+        quadratic.Complexity = ImGuiPerfToolComplexity_ON2;
+        quadratic.Exponent = 1.8;
+        IM_CHECK(PerfToolIsScalingWorse(quadratic, linear));
+        IM_CHECK(!PerfToolIsScalingWorse(linear, quadratic));
+        IM_CHECK(!PerfToolIsScalingWorse(linear, linear));
+
+        // Not enough data
+        const double stress_amounts[] = { 5.0, 5.0, 5.0 };
+        const double dt_delta_ms[] = { 1.0, 1.1, 1.2 };
+        ImGuiPerfToolScalingFit fit;
+        IM_CHECK(!ImGuiTestEngine_PerfToolFitScaling(stress_amounts, dt_delta_ms, 3, &fit));
+        IM_CHECK(!ImGuiTestEngine_PerfToolFitScaling(stress_amounts, dt_delta_ms, 2, &fit));
+        IM_CHECK_EQ((int)fit.Complexity, (int)ImGuiPerfToolComplexity_Unknown);
+    };
+
+    // ## Measure perf tool rebuild latency with 1M entries (10 builds, 1000 runs, 100 tests), while toggling test visibility every frame.
+    struct PerfToolRebuildVars
+    {
+        ImGuiPerfTool*  PerfTool = NULL;
+        char            TestNames[100][16] = {};
+        ~PerfToolRebuildVars() { IM_DELETE(PerfTool); }
+    };
+    t = IM_REGISTER_TEST(e, "perf", "perf_perftool_rebuild_1m");
+    t->SetVarsDataType<PerfToolRebuildVars>();
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        PerfToolRebuildVars& vars = ctx->GetVars<PerfToolRebuildVars>();
+        if (vars.PerfTool == NULL)
+            return;
+        ImGuiID test_id = ImHashStr(vars.TestNames[ctx->FrameCount % IM_ARRAYSIZE(vars.TestNames)]);
+        vars.PerfTool->_Visibility.SetBool(test_id, !vars.PerfTool->_Visibility.GetBool(test_id, true));
+        vars.PerfTool->_Rebuild();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        PerfToolRebuildVars& vars = ctx->GetVars<PerfToolRebuildVars>();
+        const char* branches[] = { "master", "docking" };
+        const char* build_types[] = { "Release", "Debug", "RelWithDebInfo", "MinSizeRel", "Asan" };
+        for (int n = 0; n < IM_ARRAYSIZE(vars.TestNames); n++)
+            ImFormatString(vars.TestNames[n], IM_ARRAYSIZE(vars.TestNames[n]), "perf_%03d", n);
+
+        ImGuiPerfTool* perftool = vars.PerfTool = IM_NEW(ImGuiPerfTool)();
+        ImGuiPerfToolEntry entry;
+        entry.Category = "perf";
+        entry.PerfStressAmount = 1;
+        entry.Cpu = "X64";
+        entry.OS = "Linux";
+        entry.Compiler = "GCC";
+        entry.Date = "2024-01-01";
+        for (int run_n = 0; run_n < 10 * 1000; run_n++)
+        {
+            entry.Timestamp = 1000 + run_n;
+            entry.GitBranchName = branches[run_n % IM_ARRAYSIZE(branches)];
+            entry.BuildType = build_types[(run_n / IM_ARRAYSIZE(branches)) % IM_ARRAYSIZE(build_types)];
+            for (int test_n = 0; test_n < IM_ARRAYSIZE(vars.TestNames); test_n++)
+            {
+                entry.TestName = vars.TestNames[test_n];
+                entry.DtDeltaMs = 0.1 + ((run_n * 7919 + test_n * 104729) % 1000) * 0.01;
+                perftool->AddEntry(&entry);
+            }
+        }
+
+        // Initial rebuild sorts and indexes all entries.
+        ImU64 time_start = ImTimeGetInMicroseconds();
+        perftool->_Rebuild();
+        ImU64 time_index = ImTimeGetInMicroseconds();
+        IM_CHECK_EQ(perftool->_SrcData.Size, 1000000);
+        IM_CHECK_EQ(perftool->_NumUniqueBuilds, 10);
+        IM_CHECK_EQ(perftool->_Batches.Size, 10);
+
+        // Switching display type regroups entries, without sorting them again.
+        perftool->_DisplayType = ImGuiPerfToolDisplayType_Simple;
+        perftool->_Rebuild();
+        ImU64 time_regroup = ImTimeGetInMicroseconds();
+        IM_CHECK_EQ(perftool->_Batches.Size, 10 * 1000);
+        perftool->_DisplayType = ImGuiPerfToolDisplayType_CombineByBuildInfo;
+        perftool->_Rebuild();
+        ctx->LogInfo("Rebuild of %d entries: %.2f ms initial, %.2f ms after display type change", perftool->_SrcData.Size, (time_index - time_start) / 1000.0, (time_regroup - time_index) / 1000.0);
+
+        ctx->PerfCapture();
+
+        // Toggling visibility in Simple display type, where every group is a single run.
+        perftool->_DisplayType = ImGuiPerfToolDisplayType_Simple;
+        perftool->_Rebuild();
+        IM_CHECK_EQ(perftool->_GroupAggregates.Size, perftool->_SrcData.Size);
+        ctx->PerfIterations = 50; // Each rebuild creates 10k batches
+        ctx->PerfCapture("perf", "perf_perftool_rebuild_1m_simple");
+    };
+
     // ## Capture perf tool graph.
     t = IM_REGISTER_TEST(e, "capture", "capture_perf_report");
     t->TestFunc = [](ImGuiTestContext* ctx)
@@ -1930,6 +3461,7 @@ void RegisterTests_TestEnginePerfTool(ImGuiTestEngine* e)
         ImGuiCaptureArgs* args = ctx->CaptureArgs;
         args->InCaptureRect = plot_child->Rect();
         ctx->CaptureAddWindow(window->ID);
+        ctx->CaptureSetExtension(".png");                           // Embedded as PNG in HTML report
         ctx->CaptureScreenshot(ImGuiCaptureFlags_HideMouseCursor);
         ctx->ItemDragWithDelta("splitter", ImVec2(0, -180));        // Show info table
         perf_report_image = args->InOutputFile;
@@ -1943,6 +3475,7 @@ void RegisterTests_TestEnginePerfTool(ImGuiTestEngine* e)
         const char* perf_report_output = getenv("CAPTURE_PERF_REPORT_OUTPUT");
         if (perf_report_output == NULL)
             perf_report_output = PerfToolReportDefaultOutputPath;
+        ctx->Engine->CaptureContext.FlushPendingImages();           // Image is saved asynchronously
         perftool->SaveHtmlReport(perf_report_output, perf_report_image);
     };
 }
@@ -11,15 +11,26 @@
 struct ImGuiPerfToolColumnInfo;
 struct ImGuiTestEngine;
 struct ImGuiCsvParser;
+struct ImFileMapping;
 
 // Configuration
+// Perflog format is selected by file extension: files ending with IMGUI_PERFLOG_BINARY_EXTENSION use the binary columnar format, other files use CSV.
+// The binary format is much faster to load and append to. Use ImGuiPerfTool::Load() + Save() to convert between formats.
+#ifndef IMGUI_PERFLOG_DEFAULT_FILENAME
 #define IMGUI_PERFLOG_DEFAULT_FILENAME  "output/imgui_perflog.csv"
+#endif
+#define IMGUI_PERFLOG_BINARY_EXTENSION  ".perflog"
+#ifndef IMGUI_PERFLOG_SCALING_FILENAME
+#define IMGUI_PERFLOG_SCALING_FILENAME  "output/imgui_perflog_scaling.csv" // Results of scaling-curve mode (see ImGuiTestEngineIO::ConfigPerfScalingSteps)
+#endif
 
 // [Internal] Perf log entry. Changes to this struct should be reflected in ImGuiTestContext::PerfCapture() and ImGuiTestEngine_Start().
 // This struct assumes strings stored here will be available until next ImGuiPerfTool::Clear() call. Fortunately we do not have to actively
 // manage lifetime of these strings. New entries are created only in two cases:
 // 1. ImGuiTestEngine_PerfToolAppendToCSV() call after perf test has run. This call receives ImGuiPerfToolEntry with const strings stored indefinitely by application.
 // 2. As a consequence of ImGuiPerfTool::LoadCSV() call, we persist the ImGuiCSVParser instance, which keeps parsed CSV text, from which strings are referenced.
+//    Similarly ImGuiPerfTool::LoadBinary() keeps the file memory-mapped, and strings are referenced from the mapping.
+//    Mapped data is copied to ImGuiPerfTool::_FileData before saving, as a mapped file may not be replaced on all platforms.
 // As a result our solution also doesn't make many allocations.
 struct IMGUI_API ImGuiPerfToolEntry
 {
@@ -29,6 +40,24 @@ struct IMGUI_API ImGuiPerfToolEntry
     double                      DtDeltaMs = 0.0;                // Result of perf test.
     double                      DtDeltaMsMin = +FLT_MAX;        // May be used by perftool.
     double                      DtDeltaMsMax = -FLT_MAX;        // May be used by perftool.
+    double                      DtDeltaMsMedian = 0.0;          // Distribution of per-frame delta times measured by one PerfCapture() call.
+    double                      DtDeltaMsP90 = 0.0;             // "
+    double                      DtDeltaMsP99 = 0.0;             // "
+    double                      DtDeltaMsStdDev = 0.0;          // "
+    double                      DtDeltaMsIqm = 0.0;             // " Interquartile mean, robust to outliers.
+    double                      DtDeltaMsFrameMin = 0.0;        // " Fastest frame.
+    double                      DtDeltaMsFrameMax = 0.0;        // " Slowest frame.
+    int                         NumFrames = 0;                  // " Number of measured frames. 0 when distribution is unknown (entries from older perflog files).
+    double                      CpuGuiFuncMs = 0.0;             // Median CPU time per frame spent in test GuiFunc(), measured by PerfCapture().
+    double                      CpuNewFrameMs = 0.0;            // " In ImGui::NewFrame().
+    double                      CpuEndFrameMs = 0.0;            // " In ImGui::EndFrame().
+    double                      CpuRenderMs = 0.0;              // " In ImGui::Render().
+    double                      CpuEngineMs = 0.0;              // " In test engine hooks and test coroutine (harness overhead).
+    int                         NumCpuFrames = 0;               // " Number of measured frames. 0 when CPU timings are unknown (entries from older perflog files).
+    double                      HwInstructions = -1.0;          // Median hardware counter per frame, measured by PerfCapture() with ImGuiTestEngineIO::ConfigPerfCounters. -1.0 when not available.
+    double                      HwCycles = -1.0;                // "
+    double                      HwCacheMisses = -1.0;           // "
+    double                      HwBranchMisses = -1.0;          // "
     int                         NumSamples = 1;                 // Number aggregated samples.
     int                         PerfStressAmount = 0;           //
     const char*                 GitBranchName = NULL;           // Build information.
@@ -37,6 +66,8 @@ struct IMGUI_API ImGuiPerfToolEntry
     const char*                 OS = NULL;                      //
     const char*                 Compiler = NULL;                //
     const char*                 Date = NULL;                    // Date of this entry or min date of combined entries.
+    const char*                 Environment = NULL;             // Fingerprint of machine state (CPU model, cores, frequency governor, pinning). Part of build information. Empty in older perflog files.
+    double                      LoadAverage = -1.0;             // System load average at start of batch, -1.0 when not available.
     //const char*               DateMax = NULL;                 // Max date of combined entries, or NULL.
     double                      VsBaseline = 0.0;               // Percent difference vs baseline.
     int                         LabelIndex = 0;                 // Index of TestName in ImGuiPerfTool::_LabelsVisible.
@@ -57,6 +88,52 @@ struct ImGuiPerfToolBatch
     ~ImGuiPerfToolBatch()       { Entries.clear_destruct(); }   // FIXME: Misleading: nothing to destruct in that struct?
 };
 
+// [Internal] Range of sorted ImGuiPerfTool::_SrcData entries sharing a batch ID. Groups are cached between rebuilds.
+struct ImGuiPerfToolGroup
+{
+    ImU64                       BatchID = 0;                    // Same as ImGuiPerfToolBatch::BatchID.
+    ImGuiID                     BuildID = 0;                    // Build information hash, same for all entries of a group.
+    int                         SrcStart = 0;                   // Range of entries in ImGuiPerfTool::_SrcData.
+    int                         SrcEnd = 0;                     //
+    int                         AggregatesStart = 0;            // Range of cached per-test aggregates in ImGuiPerfTool::_GroupAggregates.
+    int                         AggregatesCount = 0;            //
+    int                         NumSamples = 1;                 // A number of unique batches in the group.
+    const char*                 DateMin = NULL;                 // Date range of entries in the group.
+    const char*                 DateMax = NULL;                 //
+};
+
+// Complexity class of a perf test, fitted to its results across stress amounts (N).
+enum ImGuiPerfToolComplexity : int
+{
+    ImGuiPerfToolComplexity_Unknown,                            // Not enough data.
+    ImGuiPerfToolComplexity_O1,
+    ImGuiPerfToolComplexity_OLogN,
+    ImGuiPerfToolComplexity_ON,
+    ImGuiPerfToolComplexity_ONLogN,
+    ImGuiPerfToolComplexity_ON2,
+    ImGuiPerfToolComplexity_COUNT
+};
+
+// Result of ImGuiTestEngine_PerfToolFitScaling(): delta time ~= Intercept + Coefficient * f(N), f(N) given by Complexity.
+struct ImGuiPerfToolScalingFit
+{
+    ImGuiPerfToolComplexity     Complexity = ImGuiPerfToolComplexity_Unknown;
+    double                      Intercept = 0.0;                // In ms.
+    double                      Coefficient = 0.0;              // In ms.
+    double                      RSquared = 0.0;                 // Fraction of variance explained by the fit.
+    double                      Exponent = 0.0;                 // Slope of log(delta time) vs log(N): ~1.0 for linear, ~2.0 for quadratic. Ignores points with non-positive delta time.
+    int                         NumPoints = 0;
+};
+
+// [Internal] Results of one perf test across stress amounts, recorded by one run in scaling-curve mode.
+struct ImGuiPerfToolScalingCurve
+{
+    int                         SrcStart = 0;                   // Range of entries in ImGuiPerfTool::_ScalingData->_SrcData, sorted by stress amount.
+    int                         SrcCount = 0;                   //
+    int                         PrevCurve = -1;                 // Index of previous run of same test in ImGuiPerfTool::_ScalingCurves, or -1.
+    ImGuiPerfToolScalingFit     Fit;
+};
+
 enum ImGuiPerfToolDisplayType : int
 {
     ImGuiPerfToolDisplayType_Simple,                            // Each run will be displayed individually.
@@ -68,7 +145,14 @@ enum ImGuiPerfToolDisplayType : int
 struct IMGUI_API ImGuiPerfTool
 {
     ImVector<ImGuiPerfToolEntry> _SrcData;                       // Raw entries from CSV file (with string pointer into CSV data).
-    ImVector<const char*>       _Labels;
+    int                         _SrcDataSortedCount = 0;        // Number of sorted and indexed _SrcData entries. Entries past it were added since last _Rebuild().
+    ImVector<const char*>       _Labels;                        // Sorted test names of _SrcData entries (their LabelIndex points here), followed by mean labels.
+    int                         _NumSrcLabels = 0;              // Number of _Labels used by _SrcData entries.
+    ImGuiStorage                _LabelIndices;                  // ImHashStr(TestName):index in _Labels
+    ImVector<int>               _LabelVisibleIndices;           // _LabelVisibleIndices[_NumSrcLabels]. Index in _LabelsVisible, or -1 when hidden.
+    ImVector<ImGuiPerfToolGroup> _Groups;                       // Cached grouping of _SrcData for _GroupsDisplayType. Empty when needs to be rebuilt.
+    ImVector<ImGuiPerfToolEntry> _GroupAggregates;              // Cached per-test aggregates of each group, ignoring date filter.
+    ImGuiPerfToolDisplayType    _GroupsDisplayType = ImGuiPerfToolDisplayType_Simple;
     ImVector<const char*>       _LabelsVisible;                 // ImPlot requires a pointer of all labels beforehand. Always contains a dummy "" entry at the end!
     ImVector<ImGuiPerfToolBatch> _Batches;
     ImGuiStorage                _LabelBarCounts;                // Number bars each label will render.
@@ -101,12 +185,24 @@ struct IMGUI_API ImGuiPerfTool
     bool                        _ReportGenerating = false;
     ImGuiStorage                _Visibility;
     ImGuiCsvParser*             _CsvParser = NULL;              // We keep this around and point to its fields
+    ImFileMapping*              _FileMapping = NULL;            // Same for binary perflog
+    ImVector<char>              _FileData;                      // Copy of _FileMapping data, once mapping was closed by _DetachFileMapping()
+    ImGuiPerfTool*              _ScalingData = NULL;            // Entries of IMGUI_PERFLOG_SCALING_FILENAME, loaded when scaling view is displayed.
+    ImVector<ImGuiPerfToolScalingCurve> _ScalingCurves;         // Curves of _ScalingData, sorted by test name then by timestamp.
+    ImGuiID                     _ScalingSelectedTest = 0;       // ImHashStr(TestName) of test plotted in scaling view.
+    bool                        _ScalingDirty = true;           // Reload _ScalingData next time scaling view is displayed.
+    bool                        _ShowScaling = false;           // Display scaling curves instead of perflog entries.
 
     ImGuiPerfTool();
     ~ImGuiPerfTool();
 
     void        Clear();
+    bool        Load(const char* filename = NULL);              // Load CSV or binary perflog, detected from file contents.
     bool        LoadCSV(const char* filename = NULL);
+    bool        LoadBinary(const char* filename);
+    bool        Save(const char* filename);                     // Save all entries, format selected by file extension. Written to a temporary file first, so currently loaded file may be overwritten.
+    bool        SaveCSV(const char* filename);
+    bool        SaveBinary(const char* filename);
     void        AddEntry(ImGuiPerfToolEntry* entry);
 
     void        ShowPerfToolWindow(ImGuiTestEngine* engine, bool* p_open);
@@ -116,16 +212,51 @@ struct IMGUI_API ImGuiPerfTool
     bool        SaveHtmlReport(const char* file_name, const char* image_file = NULL);
     inline bool Empty()         { return _SrcData.empty(); }
 
+    void        _DetachFileMapping();
     void        _Rebuild();
+    void        _RebuildIndex();
+    void        _RebuildGroups();
+    void        _UpdateBuildVisibility();
     bool        _IsVisibleBuild(ImGuiPerfToolBatch* batch);
     bool        _IsVisibleBuild(ImGuiPerfToolEntry* batch);
     bool        _IsVisibleTest(const char* test_name);
     void        _CalculateLegendAlignment();
     void        _ShowEntriesPlot();
     void        _ShowEntriesTable();
+    void        _RebuildScaling();
+    void        _ShowScalingView();
+    void        _ShowScalingTable();
     void        _SetBaseline(int batch_index);
     void        _AddSettingsHandler();
     void        _UnpackSortedKey(ImU64 key, int* batch_index, int* entry_index, int* monotonic_index = NULL);
 };
 
+// Result of ImGuiTestEngine_PerfToolCompareToBaseline()
+struct ImGuiPerfToolComparison
+{
+    int                         BaselineRuns = 0;               // Number of matching entries in baseline perflog.
+    double                      BaselineDtDeltaMs = 0.0;        // Average result of baseline runs.
+    double                      StdError = 0.0;                 // Estimated noise of the difference, in ms.
+    double                      VsBaseline = 0.0;               // Percent difference vs baseline.
+    double                      Confidence = 0.5;               // Probability that entry is slower than baseline. Close to 0.0 when entry is faster.
+};
+
+// Entries waiting to be written to binary perflog files, so that a run writes a single block per file.
+// Entry strings follow same lifetime rules as ImGuiPerfTool entries (see ImGuiPerfToolEntry).
+struct ImGuiPerfLogPendingEntries
+{
+    ImVector<ImGuiPerfToolEntry> Entries;
+    ImVector<int>               FileIndices;                    // Index into Filenames, for each entry.
+    ImVector<char*>             Filenames;                      // Owned.
+
+    ~ImGuiPerfLogPendingEntries() { Clear(); }
+    void Clear()                { for (char* filename : Filenames) IM_FREE(filename); Filenames.clear(); FileIndices.clear(); Entries.clear(); }
+};
+
+IMGUI_API void    ImGuiTestEngine_PerfToolAppend(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename = NULL, ImGuiPerfLogPendingEntries* pending = NULL); // Format selected by file extension. Binary perflog entries are buffered into 'pending' when provided.
+IMGUI_API bool    ImGuiTestEngine_PerfToolFlush(ImGuiPerfLogPendingEntries* pending); // Write buffered entries, one block per file.
 IMGUI_API void    ImGuiTestEngine_PerfToolAppendToCSV(ImGuiPerfTool* perf_log, ImGuiPerfToolEntry* entry, const char* filename = NULL);
+IMGUI_API bool    ImGuiTestEngine_PerfToolAppendToBinary(const ImGuiPerfToolEntry* entries, int count, const char* filename); // Append a batch of entries as a single block
+IMGUI_API bool    ImGuiTestEngine_PerfToolCompareToBaseline(ImGuiPerfTool* baseline, const ImGuiPerfToolEntry* entry, ImGuiPerfToolComparison* out_comparison);
+IMGUI_API bool    ImGuiTestEngine_PerfToolFitScaling(const double* stress_amounts, const double* dt_delta_ms, int count, ImGuiPerfToolScalingFit* out_fit);
+IMGUI_API const char* ImGuiTestEngine_PerfToolGetComplexityName(ImGuiPerfToolComplexity complexity);
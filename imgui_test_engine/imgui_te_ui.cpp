@@ -101,12 +101,34 @@ static bool ParseLineAndDrawFileOpenItemForImageFile(ImGuiTestEngine* e, ImGuiTe
     return true;
 }
 
-static bool ParseLineAndDrawFileOpenItem(ImGuiTestEngine* e, ImGuiTest* test, const char* line_start, const char* line_end)
+static int ParseLineForLinks(const char* line_start, const char* line_end)
 {
-    if (ParseLineAndDrawFileOpenItemForSourceFile(e, test, line_start, line_end))
+    // Conservative pre-filter for ParseLineAndDrawFileOpenItemXXX() functions, result is cached per line.
+    int flags = ImGuiTestLogLineLinkFlags_Parsed;
+    if (ImStrchrRange(line_start, line_end, ':') != NULL)
+        flags |= ImGuiTestLogLineLinkFlags_SourceFile;
+    const char* image_exts[] = { ".png", ".tga", ".bmp", ".gif", ".mp4" };
+    for (const char* ext : image_exts)
+        if (ImStristr(line_start, line_end, ext, NULL))
+        {
+            flags |= ImGuiTestLogLineLinkFlags_ImageFile;
+            break;
+        }
+    return flags;
+}
+
+static bool ParseLineAndDrawFileOpenItem(ImGuiTestEngine* e, ImGuiTest* test, const char* line_start, const char* line_end, int link_flags)
+{
+    if ((link_flags & ImGuiTestLogLineLinkFlags_SourceFile) && ParseLineAndDrawFileOpenItemForSourceFile(e, test, line_start, line_end))
         return true;
+    if ((link_flags & ImGuiTestLogLineLinkFlags_ImageFile) == 0)
+        return false;
     if (ParseLineAndDrawFileOpenItemForImageFile(e, test, line_start, line_end, ".png"))
         return true;
+    if (ParseLineAndDrawFileOpenItemForImageFile(e, test, line_start, line_end, ".tga"))
+        return true;
+    if (ParseLineAndDrawFileOpenItemForImageFile(e, test, line_start, line_end, ".bmp"))
+        return true;
     if (ParseLineAndDrawFileOpenItemForImageFile(e, test, line_start, line_end, ".gif"))
         return true;
     if (ParseLineAndDrawFileOpenItemForImageFile(e, test, line_start, line_end, ".mp4"))
@@ -132,34 +154,23 @@ static void DrawTestLog(ImGuiTestEngine* e, ImGuiTest* test)
 
     ImGuiTestOutput* test_output = &test->Output;
 
+    // Lines are accessed through per-level indices so the cost is proportional to number of visible lines, not to log size.
     ImGuiTestLog* log = &test_output->Log;
     const char* text = log->Buffer.begin();
-    const char* text_end = log->Buffer.end();
     ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(6.0f, 2.0f) * dpi_scale);
     ImGuiListClipper clipper;
     ImGuiTestVerboseLevel max_log_level = test_output->Status == ImGuiTestStatus_Error ? e->IO.ConfigVerboseLevelOnError : e->IO.ConfigVerboseLevel;
-    int line_count = log->ExtractLinesForVerboseLevels(ImGuiTestVerboseLevel_Silent, max_log_level, NULL);
-    int current_index_clipped = -1;
-    int current_index_abs = 0;
+    int line_count = log->GetLineCountUpToLevel(max_log_level);
     clipper.Begin(line_count);
     while (clipper.Step())
     {
         for (int line_no = clipper.DisplayStart; line_no < clipper.DisplayEnd; line_no++)
         {
-            // Advance index_by_log_level to find log entry indicated by line_no.
-            ImGuiTestLogLineInfo* line_info = NULL;
-            while (current_index_clipped < line_no)
-            {
-                line_info = &log->LineInfo[current_index_abs];
-                if (line_info->Level <= max_log_level)
-                    current_index_clipped++;
-                current_index_abs++;
-            }
-
+            ImGuiTestLogLineInfo* line_info = log->GetLineUpToLevel(max_log_level, line_no);
             const char* line_start = text + line_info->LineOffset;
-            const char* line_end = strchr(line_start, '\n');
-            if (line_end == NULL)
-                line_end = text_end;
+            const char* line_end = line_start + line_info->LineSize;
+            if ((line_info->LinkFlags & ImGuiTestLogLineLinkFlags_Parsed) == 0)
+                line_info->LinkFlags = ParseLineForLinks(line_start, line_end);
 
             switch (line_info->Level)
             {
@@ -187,7 +198,7 @@ static void DrawTestLog(ImGuiTestEngine* e, ImGuiTest* test)
             ImGui::PushID(line_no);
             if (ImGui::BeginPopupContextItem("Context", 1))
             {
-                if (!ParseLineAndDrawFileOpenItem(e, test, line_start, line_end))
+                if (!ParseLineAndDrawFileOpenItem(e, test, line_start, line_end, line_info->LinkFlags))
                     ImGui::MenuItem("No options", NULL, false, false);
                 ImGui::EndPopup();
             }
@@ -669,6 +680,12 @@ static void ImGuiTestEngine_ShowLogAndTools(ImGuiTestEngine* engine)
             ImGui::SetItemTooltip("Enable or disable screen capture API completely.");
             ImGui::Checkbox("Capture screen on error", &engine->IO.ConfigCaptureOnError);
             ImGui::SetItemTooltip("Capture a screenshot on test failure.");
+            ImGui::Checkbox("Update reference images", &engine->IO.ConfigCaptureUpdateReferences);
+            ImGui::SetItemTooltip("CaptureCheckReference(): save capture as new reference when reference is missing or doesn't match, instead of failing.");
+            ImGui::Checkbox("Builtin GIF encoder", &engine->IO.GifCaptureUseBuiltinEncoder);
+            ImGui::SetItemTooltip("Encode .gif videos in-process. Video encoder is only needed for other formats.");
+            ImGui::Checkbox("Video damage tracking", &engine->IO.VideoCaptureDamageTracking);
+            ImGui::SetItemTooltip("Only read back regions of video frames which changed according to draw data.\nOnly enable when all recorded contents are rendered by Dear ImGui.");
 
             // Fields modified by in this call will be synced to engine->CaptureContext.
             engine->CaptureTool._ShowEncoderConfigFields(&engine->CaptureContext);
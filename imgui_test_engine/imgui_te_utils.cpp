@@ -20,6 +20,9 @@
 #include <stdio.h>
 #else
 #include <errno.h>
+#include <fcntl.h>      // open()
+#include <sys/mman.h>   // mmap()
+#include <stdlib.h>     // getloadavg()
 #include <unistd.h>
 #endif
 #ifndef _MSC_VER
@@ -31,7 +34,17 @@
 #endif
 
 #if defined(__linux) || defined(__linux__) || defined(__MACH__) || defined(__MSL__) || defined(__MINGW32__)
-#include <pthread.h>    // pthread_setname_np()
+#include <pthread.h>    // pthread_setname_np(), pthread_setaffinity_np()
+#endif
+#if defined(__linux__)
+#include <linux/perf_event.h>   // perf_event_attr
+#include <sys/ioctl.h>          // ioctl()
+#include <sys/syscall.h>        // syscall(), __NR_perf_event_open
+#include <cxxabi.h>             // abi::__cxa_demangle()
+#include <dlfcn.h>              // dladdr()
+#include <execinfo.h>           // backtrace()
+#include <signal.h>             // sigaction()
+#include <time.h>               // timer_create()
 #endif
 #include <chrono>       // high_resolution_clock::now()
 #include <thread>       // this_thread::sleep_for()
@@ -228,9 +241,12 @@ const char* ImFindNextDecoratedPartInPath(const char* str, const char* str_end)
 // File/Directory Helpers
 //-----------------------------------------------------------------------------
 // - ImFileExist()
+// - ImFileCopy()
+// - ImFileCreateHardLink()
 // - ImFileCreateDirectoryChain()
 // - ImFileFindInParents()
 // - ImFileLoadSourceBlurb()
+// - ImFileMapping
 //-----------------------------------------------------------------------------
 
 #if _WIN32
@@ -265,6 +281,35 @@ bool ImFileDelete(const char* filename)
     return false;
 }
 
+bool ImFileCopy(const char* src_filename, const char* dst_filename)
+{
+    size_t size = 0;
+    void* data = ImFileLoadToMemory(src_filename, "rb", &size);
+    if (data == NULL)
+        return false;
+    bool ret = false;
+    if (ImFileHandle f = ImFileOpen(dst_filename, "wb"))
+    {
+        ret = ImFileWrite(data, 1, size, f) == size;
+        ImFileClose(f);
+    }
+    IM_FREE(data);
+    return ret;
+}
+
+bool ImFileCreateHardLink(const char* existing_filename, const char* new_filename)
+{
+    ImFileDelete(new_filename);
+#if _WIN32
+    ImVector<wchar_t> existing_buf, new_buf;
+    ImUtf8ToWideChar(existing_filename, &existing_buf);
+    ImUtf8ToWideChar(new_filename, &new_buf);
+    return ::CreateHardLinkW(&new_buf[0], &existing_buf[0], NULL) == TRUE;
+#else
+    return link(existing_filename, new_filename) == 0;
+#endif
+}
+
 // Create directories for specified path. Slashes will be replaced with platform directory separators.
 // e.g. ImFileCreateDirectoryChain("aaaa/bbbb/cccc.png")
 // will try to create "aaaa/" then "aaaa/bbbb/".
@@ -365,6 +410,80 @@ bool ImFileLoadSourceBlurb(const char* file_name, int line_no_start, int line_no
     return true;
 }
 
+bool ImFileMapping::Open(const char* filename)
+{
+    Close();
+#if _WIN32
+    ImVector<wchar_t> filename_w;
+    ImUtf8ToWideChar(filename, &filename_w);
+    HANDLE file = ::CreateFileW(filename_w.Data, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER file_size;
+    if (!::GetFileSizeEx(file, &file_size))
+    {
+        ::CloseHandle(file);
+        return false;
+    }
+    if (file_size.QuadPart == 0)
+    {
+        ::CloseHandle(file);
+        return true;
+    }
+    HANDLE mapping = ::CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    ::CloseHandle(file); // Mapping object keeps a reference to the file
+    if (mapping == NULL)
+        return false;
+    void* data = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == NULL)
+    {
+        ::CloseHandle(mapping);
+        return false;
+    }
+    Data = data;
+    Size = (size_t)file_size.QuadPart;
+    Handle = mapping;
+    return true;
+#else
+    int fd = open(filename, O_RDONLY);
+    if (fd == -1)
+        return false;
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    if (st.st_size == 0)
+    {
+        close(fd);
+        return true;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // Mapping keeps a reference to the file
+    if (data == MAP_FAILED)
+        return false;
+    Data = data;
+    Size = (size_t)st.st_size;
+    return true;
+#endif
+}
+
+void ImFileMapping::Close()
+{
+    if (Data == NULL)
+        return;
+#if _WIN32
+    ::UnmapViewOfFile(Data);
+    ::CloseHandle((HANDLE)Handle);
+#else
+    munmap((void*)Data, Size);
+#endif
+    Data = NULL;
+    Size = 0;
+    Handle = NULL;
+}
+
 //-----------------------------------------------------------------------------
 // Path Helpers
 //-----------------------------------------------------------------------------
@@ -649,6 +768,7 @@ bool    ImParseFindIniSection(const char* ini_config, const char* header, ImVect
 // Time Helpers
 //-----------------------------------------------------------------------------
 // - ImTimeGetInMicroseconds()
+// - ImTimeGetInNanoseconds()
 // - ImTimestampToISO8601()
 //-----------------------------------------------------------------------------
 
@@ -660,6 +780,13 @@ uint64_t ImTimeGetInMicroseconds()
     return (uint64_t)ms.count();
 }
 
+uint64_t ImTimeGetInNanoseconds()
+{
+    using namespace std;
+    chrono::nanoseconds ns = chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch());
+    return (uint64_t)ns.count();
+}
+
 void ImTimestampToISO8601(uint64_t timestamp, Str* out_date)
 {
     time_t unix_time = (time_t)(timestamp / 1000000); // Convert to seconds.
@@ -678,6 +805,8 @@ void ImTimestampToISO8601(uint64_t timestamp, Str* out_date)
 //-----------------------------------------------------------------------------
 // - ImThreadSleepInMilliseconds()
 // - ImThreadSetCurrentThreadDescription()
+// - ImThreadGetCurrentAffinity()
+// - ImThreadSetCurrentAffinity()
 //-----------------------------------------------------------------------------
 
 void ImThreadSleepInMilliseconds(int ms)
@@ -752,6 +881,38 @@ void ImThreadSetCurrentThreadDescription(const char* description)
 #endif
 }
 
+bool ImThreadGetCurrentAffinity(ImThreadAffinity* out_affinity)
+{
+    *out_affinity = ImThreadAffinity();
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (pthread_getaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+        return false;
+    for (int cpu = 0; cpu < CPU_SETSIZE && cpu < 1024; cpu++)
+        if (CPU_ISSET(cpu, &set))
+            out_affinity->Set(cpu);
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ImThreadSetCurrentAffinity(const ImThreadAffinity& affinity)
+{
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for (int cpu = 0; cpu < CPU_SETSIZE && cpu < 1024; cpu++)
+        if (affinity.IsSet(cpu))
+            CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    IM_UNUSED(affinity);
+    return false;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 // Build info helpers
 //-----------------------------------------------------------------------------
@@ -859,6 +1020,379 @@ bool ImBuildFindGitBranchName(const char* git_repo_path, Str* branch_name)
     return result;
 }
 
+//-----------------------------------------------------------------------------
+// Hardware Performance Counters Helpers
+//-----------------------------------------------------------------------------
+// - ImPerfCounters::Open()
+// - ImPerfCounters::Close()
+// - ImPerfCounters::Read()
+// - ImPerfCounterGetName()
+// - ImPerfEnvironmentQuery()
+// - ImSamplingProfiler::Start()
+// - ImSamplingProfiler::Stop()
+// - ImSamplingProfiler::WriteFoldedStacks()
+//-----------------------------------------------------------------------------
+
+#if defined(__linux__)
+
+bool ImPerfCounters::Open()
+{
+    if (IsOpen())
+        return true;
+
+    static const ImU64 configs[ImPerfCounter_COUNT] = { PERF_COUNT_HW_INSTRUCTIONS, PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES };
+    int read_count = 0;
+    for (int n = 0; n < ImPerfCounter_COUNT; n++)
+    {
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = configs[n];
+        attr.disabled = (GroupFd == -1) ? 1 : 0;            // Group is enabled at once via its leader
+        attr.exclude_kernel = 1;                            // Allowed with perf_event_paranoid <= 2
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP;
+
+        // pid = 0, cpu = -1: calling thread on any CPU
+        const int fd = (int)syscall(__NR_perf_event_open, &attr, 0, -1, GroupFd, 0);
+        if (fd == -1)
+            continue;                                       // e.g. some counters are not supported by virtual machines
+        if (GroupFd == -1)
+            GroupFd = fd;
+        Fds[n] = fd;
+        ReadIndex[n] = read_count++;
+    }
+    if (GroupFd == -1)
+        return false;
+
+    ioctl(GroupFd, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(GroupFd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+}
+
+void ImPerfCounters::Close()
+{
+    for (int n = 0; n < ImPerfCounter_COUNT; n++)
+    {
+        if (Fds[n] != -1 && Fds[n] != GroupFd)
+            close(Fds[n]);
+        Fds[n] = ReadIndex[n] = -1;
+    }
+    if (GroupFd != -1)
+        close(GroupFd);
+    GroupFd = -1;
+}
+
+bool ImPerfCounters::Read(ImU64 out_values[ImPerfCounter_COUNT])
+{
+    memset(out_values, 0, sizeof(ImU64) * ImPerfCounter_COUNT);
+    if (!IsOpen())
+        return false;
+
+    ImU64 data[1 + ImPerfCounter_COUNT];                    // PERF_FORMAT_GROUP: { u64 nr; u64 values[nr]; }
+    if (read(GroupFd, data, sizeof(data)) <= 0)
+        return false;
+    for (int n = 0; n < ImPerfCounter_COUNT; n++)
+        if (ReadIndex[n] != -1 && ReadIndex[n] < (int)data[0])
+            out_values[n] = data[1 + ReadIndex[n]];
+    return true;
+}
+
+#else
+
+bool ImPerfCounters::Open()                                         { return false; }
+void ImPerfCounters::Close()                                        { }
+bool ImPerfCounters::Read(ImU64 out_values[ImPerfCounter_COUNT])    { memset(out_values, 0, sizeof(ImU64) * ImPerfCounter_COUNT); return false; }
+
+#endif
+
+const char* ImPerfCounterGetName(ImPerfCounter counter)
+{
+    static const char* names[ImPerfCounter_COUNT] = { "Instructions", "Cycles", "Cache misses", "Branch misses" };
+    IM_STATIC_ASSERT(IM_ARRAYSIZE(names) == ImPerfCounter_COUNT);
+    if (counter >= 0 && counter < IM_ARRAYSIZE(names))
+        return names[counter];
+    return "N/A";
+}
+
+void ImPerfEnvironmentQuery(ImPerfEnvironment* out_env, int cpu)
+{
+    *out_env = ImPerfEnvironment();
+    out_env->NumCores = (int)std::thread::hardware_concurrency();
+#if defined(__linux__)
+    char line[256];
+    if (FILE* f = fopen("/proc/cpuinfo", "rb"))
+    {
+        while (out_env->CpuModel[0] == 0 && fgets(line, IM_ARRAYSIZE(line), f))
+            if (strncmp(line, "model name", 10) == 0)
+                if (const char* value = strchr(line, ':'))
+                {
+                    for (value++; *value == ' ' || *value == '\t'; value++) {}
+                    ImStrncpy(out_env->CpuModel, value, IM_ARRAYSIZE(out_env->CpuModel));
+                }
+        fclose(f);
+    }
+    ImFormatString(line, IM_ARRAYSIZE(line), "/sys/devices/system/cpu/cpu%d/cpufreq/scaling_governor", cpu);
+    if (FILE* f = fopen(line, "rb"))
+    {
+        if (fgets(out_env->CpuGovernor, IM_ARRAYSIZE(out_env->CpuGovernor), f) == NULL)
+            out_env->CpuGovernor[0] = 0;
+        fclose(f);
+    }
+#elif defined(__APPLE__)
+    size_t size = sizeof(out_env->CpuModel);
+    if (sysctlbyname("machdep.cpu.brand_string", out_env->CpuModel, &size, NULL, 0) != 0)
+        out_env->CpuModel[0] = 0;
+    IM_UNUSED(cpu);
+#else
+    IM_UNUSED(cpu);
+#endif
+#if defined(__linux__) || defined(__APPLE__)
+    double load_average = 0.0;
+    if (getloadavg(&load_average, 1) == 1)
+        out_env->LoadAverage = load_average;
+#endif
+    ImStrTrimBlanks(out_env->CpuModel);
+    ImStrTrimBlanks(out_env->CpuGovernor);
+}
+
+#if defined(__linux__)
+#ifndef sigev_notify_thread_id
+#define sigev_notify_thread_id _sigev_un._tid
+#endif
+
+static ImSamplingProfiler* GSamplingProfiler = NULL;
+static struct sigaction GSamplingProfilerPrevAction;   // Restored by Stop()
+
+// Runs on sampled thread only (timer signal is directed to it), so it can't be reentered.
+// backtrace() is not async-signal-safe. In practice, with glibc, it is safe once warmed up by Start() (unwinder library is loaded
+// and it doesn't allocate afterward), except that it may deadlock if a sample interrupts the unwinder itself, e.g. while a C++
+// exception is being thrown on sampled thread. Don't profile code relying on exceptions.
+static void ImSamplingProfilerSignalHandler(int, siginfo_t*, void*)
+{
+    ImSamplingProfiler* profiler = GSamplingProfiler;
+    if (profiler == NULL)
+        return;
+    const int saved_errno = errno;
+    const int sample_n = profiler->SamplesCount;
+    if (sample_n < profiler->Depths.Size)
+    {
+        profiler->Depths.Data[sample_n] = backtrace(profiler->Frames.Data + sample_n * profiler->MaxDepth, profiler->MaxDepth);
+        profiler->SamplesCount = sample_n + 1;
+    }
+    else
+    {
+        profiler->SamplesDropped = profiler->SamplesDropped + 1;
+    }
+    errno = saved_errno;
+}
+
+static void ImSamplingProfilerResolveSymbol(void* addr, Str* out_name)
+{
+    Dl_info info;
+    if (dladdr(addr, &info) == 0 || info.dli_fname == NULL)
+    {
+        out_name->setf("%p", addr);
+        return;
+    }
+    if (info.dli_sname != NULL)
+    {
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(info.dli_sname, NULL, NULL, &status);
+        out_name->set((status == 0 && demangled != NULL) ? demangled : info.dli_sname);
+        free(demangled);
+    }
+    else
+    {
+        out_name->setf("%s+0x%llx", ImPathFindFilename(info.dli_fname), (unsigned long long)((const char*)addr - (const char*)info.dli_fbase));
+    }
+    for (char* p = out_name->c_str(); *p != 0; p++)
+        if (*p == ';')  // Frame separator in folded format
+            *p = ':';
+}
+
+struct ImSamplingProfilerSymbol
+{
+    void*       Addr;
+    int         NameOffset;     // In strings buffer
+};
+
+struct ImSamplingProfilerStack
+{
+    int         NameOffset;     // In strings buffer
+    int         Count;
+    const char* Name;           // Set once strings buffer stops growing
+};
+
+static int ImSamplingProfilerAddString(ImVector<char>* strings, const char* str)
+{
+    const int offset = strings->Size;
+    const int len = (int)strlen(str) + 1;
+    strings->resize(offset + len);
+    memcpy(strings->Data + offset, str, (size_t)len);
+    return offset;
+}
+#endif
+
+bool ImSamplingProfiler::Start(int frequency_hz)
+{
+#if defined(__linux__)
+    IM_ASSERT(!Running && GSamplingProfiler == NULL && "Only one ImSamplingProfiler may run at a time.");
+    IM_STATIC_ASSERT(sizeof(timer_t) <= sizeof(Timer));
+    if (frequency_hz <= 0)
+        return false;
+    if (Depths.Size != MaxSamples || Frames.Size != MaxSamples * MaxDepth)
+    {
+        Depths.resize(MaxSamples);
+        Frames.resize(MaxSamples * MaxDepth);
+        Clear();
+    }
+
+    // backtrace() loads unwinder library on first call, which is not allowed in a signal handler
+    void* warm_up_frames[2];
+    backtrace(warm_up_frames, IM_ARRAYSIZE(warm_up_frames));
+
+    // Previous handler is restored by Stop()
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_sigaction = ImSamplingProfilerSignalHandler;
+    action.sa_flags = SA_SIGINFO | SA_RESTART;
+    sigemptyset(&action.sa_mask);
+    if (sigaction(SIGPROF, &action, &GSamplingProfilerPrevAction) != 0)
+        return false;
+
+    // Timer ticks with CPU time of calling thread: a thread blocked waiting for test coroutine isn't sampled
+    clockid_t clock_id;
+    timer_t timer;
+    struct sigevent event;
+    memset(&event, 0, sizeof(event));
+    event.sigev_notify = SIGEV_THREAD_ID;
+    event.sigev_signo = SIGPROF;
+    event.sigev_notify_thread_id = (pid_t)syscall(SYS_gettid);
+    if (pthread_getcpuclockid(pthread_self(), &clock_id) != 0 || timer_create(clock_id, &event, &timer) != 0)
+    {
+        sigaction(SIGPROF, &GSamplingProfilerPrevAction, NULL);
+        return false;
+    }
+
+    GSamplingProfiler = this;
+    struct itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = (frequency_hz > 1) ? 1000000000L / frequency_hz : 999999999L;
+    spec.it_value = spec.it_interval;
+    if (timer_settime(timer, 0, &spec, NULL) != 0)
+    {
+        timer_delete(timer);
+        GSamplingProfiler = NULL;
+        sigaction(SIGPROF, &GSamplingProfilerPrevAction, NULL);
+        return false;
+    }
+    memcpy(&Timer, &timer, sizeof(timer));
+    Running = true;
+    return true;
+#else
+    IM_UNUSED(frequency_hz);
+    return false;
+#endif
+}
+
+void ImSamplingProfiler::Stop()
+{
+    if (!Running)
+        return;
+#if defined(__linux__)
+    timer_t timer;
+    memcpy(&timer, &Timer, sizeof(timer));
+    timer_delete(timer);
+    GSamplingProfiler = NULL;
+
+    // A timer signal may still be pending on sampled thread (Stop() may be called from another thread): ignoring the signal
+    // discards it, otherwise restoring default action would terminate the process.
+    struct sigaction ignore_action;
+    memset(&ignore_action, 0, sizeof(ignore_action));
+    ignore_action.sa_handler = SIG_IGN;
+    sigemptyset(&ignore_action.sa_mask);
+    sigaction(SIGPROF, &ignore_action, NULL);
+    sigaction(SIGPROF, &GSamplingProfilerPrevAction, NULL);
+#endif
+    Running = false;
+}
+
+bool ImSamplingProfiler::WriteFoldedStacks(const char* filename) const
+{
+#if defined(__linux__)
+    IM_ASSERT(!Running);
+    if (!ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename)))
+        return false;
+    FILE* f = fopen(filename, "wb");
+    if (f == NULL)
+        return false;
+
+    // Merge identical stacks. Resolve every address once, as dladdr() is slow.
+    // Storages map hashes to index + 1, colliding keys are resolved by probing next key.
+    ImVector<char> strings;
+    ImVector<ImSamplingProfilerSymbol> symbols;
+    ImVector<ImSamplingProfilerStack> stacks;
+    ImGuiStorage symbols_map;
+    ImGuiStorage stacks_map;
+    Str256 symbol_name;
+    Str512 stack;
+    for (int sample_n = 0; sample_n < SamplesCount; sample_n++)
+    {
+        void* const* frames = Frames.Data + sample_n * MaxDepth;
+        stack.clear();
+
+        // Skip signal handler and signal trampoline. Frames above interrupted one are return addresses: look up
+        // instruction before, which belongs to the calling function even when the call was its last instruction.
+        for (int frame_n = Depths.Data[sample_n] - 1; frame_n >= 2; frame_n--)
+        {
+            void* addr = (frame_n > 2) ? (void*)((char*)frames[frame_n] - 1) : frames[frame_n];
+            ImGuiID key = ImHashData(&addr, sizeof(addr));
+            int* p_symbol_idx = symbols_map.GetIntRef(key, 0);
+            while (*p_symbol_idx != 0 && symbols[*p_symbol_idx - 1].Addr != addr)
+                p_symbol_idx = symbols_map.GetIntRef(++key, 0);
+            if (*p_symbol_idx == 0)
+            {
+                ImSamplingProfilerResolveSymbol(addr, &symbol_name);
+                ImSamplingProfilerSymbol symbol = { addr, ImSamplingProfilerAddString(&strings, symbol_name.c_str()) };
+                symbols.push_back(symbol);
+                *p_symbol_idx = symbols.Size;
+            }
+            if (stack.c_str()[0] != 0)
+                stack.append(";");
+            stack.append(strings.Data + symbols[*p_symbol_idx - 1].NameOffset);
+        }
+        if (stack.c_str()[0] == 0)
+            continue;
+
+        ImGuiID key = ImHashStr(stack.c_str());
+        int* p_stack_idx = stacks_map.GetIntRef(key, 0);
+        while (*p_stack_idx != 0 && strcmp(strings.Data + stacks[*p_stack_idx - 1].NameOffset, stack.c_str()) != 0)
+            p_stack_idx = stacks_map.GetIntRef(++key, 0);
+        if (*p_stack_idx == 0)
+        {
+            ImSamplingProfilerStack new_stack = { ImSamplingProfilerAddString(&strings, stack.c_str()), 0, NULL };
+            stacks.push_back(new_stack);
+            *p_stack_idx = stacks.Size;
+        }
+        stacks[*p_stack_idx - 1].Count++;
+    }
+
+    // Sort by stack, so output is deterministic
+    for (ImSamplingProfilerStack& s : stacks)
+        s.Name = strings.Data + s.NameOffset;
+    ImQsort(stacks.Data, (size_t)stacks.Size, sizeof(ImSamplingProfilerStack), [](const void* lhs, const void* rhs) { return strcmp(((const ImSamplingProfilerStack*)lhs)->Name, ((const ImSamplingProfilerStack*)rhs)->Name); });
+    for (const ImSamplingProfilerStack& s : stacks)
+        fprintf(f, "%s %d\n", s.Name, s.Count);
+    fclose(f);
+    return true;
+#else
+    IM_UNUSED(filename);
+    return false;
+#endif
+}
+
 //-----------------------------------------------------------------------------
 // Operating System Helpers
 //-----------------------------------------------------------------------------
@@ -1255,6 +1789,111 @@ void DrawDataVerifyMatchingBufferCount(ImDrawData* draw_data)
 #endif
 }
 
+//-----------------------------------------------------------------------------
+// Sample statistics
+//-----------------------------------------------------------------------------
+
+double ImPercentileOfSorted(const double* sorted_samples, int count, double percentile)
+{
+    IM_ASSERT(percentile >= 0.0 && percentile <= 1.0);
+    if (count <= 0)
+        return 0.0;
+    const double rank = percentile * (count - 1);
+    const int rank_lo = (int)rank;
+    const int rank_hi = ImMin(rank_lo + 1, count - 1);
+    return sorted_samples[rank_lo] + (sorted_samples[rank_hi] - sorted_samples[rank_lo]) * (rank - rank_lo);
+}
+
+void ImSampleStats::Calc(double* samples, int count)
+{
+    *this = ImSampleStats();
+    Count = count;
+    if (count <= 0)
+        return;
+
+    ImQsort(samples, (size_t)count, sizeof(double), [](const void* lhs, const void* rhs)
+    {
+        const double a = *(const double*)lhs;
+        const double b = *(const double*)rhs;
+        return (a < b) ? -1 : (a > b) ? +1 : 0;
+    });
+
+    double sum = 0.0;
+    for (int n = 0; n < count; n++)
+        sum += samples[n];
+    Mean = sum / count;
+    Min = samples[0];
+    Max = samples[count - 1];
+    Median = ImPercentileOfSorted(samples, count, 0.50);
+    P90 = ImPercentileOfSorted(samples, count, 0.90);
+    P99 = ImPercentileOfSorted(samples, count, 0.99);
+
+    double sum_sq_diff = 0.0;
+    for (int n = 0; n < count; n++)
+        sum_sq_diff += (samples[n] - Mean) * (samples[n] - Mean);
+    StdDev = (count > 1) ? sqrt(sum_sq_diff / (count - 1)) : 0.0;
+
+    // Keep at least one sample for small counts
+    const int iq_start = count / 4;
+    const int iq_end = ImMax(count - count / 4, iq_start + 1);
+    double iq_sum = 0.0;
+    for (int n = iq_start; n < iq_end; n++)
+        iq_sum += samples[n];
+    Iqm = iq_sum / (iq_end - iq_start);
+}
+
+// Continued fraction for the incomplete beta function, evaluated with modified Lentz's method.
+static double ImIncompleteBetaContinuedFraction(double a, double b, double x)
+{
+    const double tiny = 1e-300;
+    double c = 1.0;
+    double d = 1.0 - (a + b) * x / (a + 1.0);
+    d = 1.0 / ((fabs(d) < tiny) ? tiny : d);
+    double h = d;
+    for (int m = 1; m <= 300; m++)
+    {
+        // Even step
+        double aa = m * (b - m) * x / ((a + 2 * m - 1.0) * (a + 2 * m));
+        d = 1.0 + aa * d;
+        d = 1.0 / ((fabs(d) < tiny) ? tiny : d);
+        c = 1.0 + aa / c;
+        c = (fabs(c) < tiny) ? tiny : c;
+        h *= d * c;
+
+        // Odd step
+        aa = -(a + m) * (a + b + m) * x / ((a + 2 * m) * (a + 2 * m + 1.0));
+        d = 1.0 + aa * d;
+        d = 1.0 / ((fabs(d) < tiny) ? tiny : d);
+        c = 1.0 + aa / c;
+        c = (fabs(c) < tiny) ? tiny : c;
+        const double delta = d * c;
+        h *= delta;
+        if (fabs(delta - 1.0) < 1e-12)
+            break;
+    }
+    return h;
+}
+
+// Regularized incomplete beta function I_x(a, b)
+static double ImIncompleteBetaRegularized(double a, double b, double x)
+{
+    if (x <= 0.0)
+        return 0.0;
+    if (x >= 1.0)
+        return 1.0;
+    const double front = exp(lgamma(a + b) - lgamma(a) - lgamma(b) + a * log(x) + b * log(1.0 - x));
+    if (x < (a + 1.0) / (a + b + 2.0))
+        return front * ImIncompleteBetaContinuedFraction(a, b, x) / a;
+    return 1.0 - front * ImIncompleteBetaContinuedFraction(b, a, 1.0 - x) / b;
+}
+
+double ImStudentTCdf(double t, double dof)
+{
+    IM_ASSERT(dof > 0.0);
+    const double tail = 0.5 * ImIncompleteBetaRegularized(dof * 0.5, 0.5, dof / (dof + t * t));
+    return (t > 0.0) ? 1.0 - tail : tail;
+}
+
 //-----------------------------------------------------------------------------
 // Simple CSV parser
 //-----------------------------------------------------------------------------
@@ -1308,7 +1947,8 @@ bool ImGuiCsvParser::Load(const char* filename)
         const bool is_eof = (*c == '\0');
         if (is_comma || is_eol || is_eof)
         {
-            _Index[Rows * columns + col] = col_data;
+            if (col < columns)
+                _Index[Rows * columns + col] = col_data;
             col_data = c + 1;
             if (is_comma)
             {
@@ -1316,7 +1956,13 @@ bool ImGuiCsvParser::Load(const char* filename)
             }
             else
             {
-                if (col + 1 == columns)
+                const int row_columns = col + 1;
+                const bool row_missing_columns = (ColumnsMin > 0 && row_columns >= ColumnsMin && row_columns < columns);
+                if (row_missing_columns)
+                    for (int missing_col = row_columns; missing_col < columns; missing_col++)
+                        _Index[Rows * columns + missing_col] = c; // Empty string, as *c is zeroed below
+                const bool row_extra_columns = (ColumnsExtraIgnored && row_columns > columns);
+                if (row_columns == columns || row_missing_columns || row_extra_columns)
                     Rows++;
                 else
                     fprintf(stderr, "%s: Unexpected number of columns on line %d, ignoring.\n", filename, Rows + 1); // FIXME
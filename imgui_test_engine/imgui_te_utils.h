@@ -26,10 +26,25 @@ const char* ImFindNextDecoratedPartInPath(const char* str, const char* str_end =
 
 bool        ImFileExist(const char* filename);
 bool        ImFileDelete(const char* filename);
+bool        ImFileCopy(const char* src_filename, const char* dst_filename);
+bool        ImFileCreateHardLink(const char* existing_filename, const char* new_filename);   // Replace 'new_filename' with a hard link. Fails e.g. across volumes or on file systems without hard links.
 bool        ImFileCreateDirectoryChain(const char* path, const char* path_end = NULL);
 bool        ImFileFindInParents(const char* sub_path, int max_parent_count, Str* output);
 bool        ImFileLoadSourceBlurb(const char* filename, int line_no_start, int line_no_end, ImGuiTextBuffer* out_buf);
 
+// Read-only memory mapping of a whole file. Pointers into Data stay valid until Close().
+struct ImFileMapping
+{
+    const void*     Data = NULL;
+    size_t          Size = 0;
+    void*           Handle = NULL;                          // Win32: file mapping object
+
+    ~ImFileMapping()                                        { Close(); }
+    bool            Open(const char* filename);             // Empty files are mapped successfully with Data == NULL.
+    void            Close();
+    bool            IsOpen() const                          { return Data != NULL; }
+};
+
 //-----------------------------------------------------------------------------
 // Path Helpers
 //-----------------------------------------------------------------------------
@@ -60,14 +75,99 @@ bool        ImParseFindIniSection(const char* ini_config, const char* header, Im
 //-----------------------------------------------------------------------------
 
 uint64_t    ImTimeGetInMicroseconds();
+uint64_t    ImTimeGetInNanoseconds();                                               // Monotonic, for measuring durations
 void        ImTimestampToISO8601(uint64_t timestamp, Str* out_date);
 
 //-----------------------------------------------------------------------------
 // Threading Helpers
 //-----------------------------------------------------------------------------
 
+// Set of CPUs a thread may run on
+struct ImThreadAffinity
+{
+    ImU64           Mask[16] = {};                          // One bit per CPU, up to 1024 CPUs (same as Linux cpu_set_t)
+
+    void            Set(int cpu)                            { if (cpu >= 0 && cpu < 1024) Mask[cpu >> 6] |= (ImU64)1 << (cpu & 63); }
+    bool            IsSet(int cpu) const                    { return cpu >= 0 && cpu < 1024 && (Mask[cpu >> 6] & ((ImU64)1 << (cpu & 63))) != 0; }
+    int             GetLast() const                         { for (int cpu = 1023; cpu >= 0; cpu--) if (IsSet(cpu)) return cpu; return -1; }
+};
+
 void        ImThreadSleepInMilliseconds(int ms);
 void        ImThreadSetCurrentThreadDescription(const char* description);
+bool        ImThreadGetCurrentAffinity(ImThreadAffinity* out_affinity);         // Currently only implemented on Linux
+bool        ImThreadSetCurrentAffinity(const ImThreadAffinity& affinity);      // "
+
+//-----------------------------------------------------------------------------
+// Hardware Performance Counters Helpers
+//-----------------------------------------------------------------------------
+
+enum ImPerfCounter
+{
+    ImPerfCounter_Instructions,
+    ImPerfCounter_Cycles,
+    ImPerfCounter_CacheMisses,
+    ImPerfCounter_BranchMisses,
+    ImPerfCounter_COUNT
+};
+
+// Count events of calling thread (user-space only). Currently only implemented on Linux using perf events.
+// Open() may fail e.g. on other platforms, in containers, or when /proc/sys/kernel/perf_event_paranoid is 3 or more.
+struct ImPerfCounters
+{
+    int             GroupFd = -1;                           // File descriptor of group leader (first counter opened)
+    int             Fds[ImPerfCounter_COUNT];               // File descriptors, -1 when counter is not available
+    int             ReadIndex[ImPerfCounter_COUNT];         // Index of counter in group read, -1 when counter is not available
+
+    ImPerfCounters()                                        { for (int n = 0; n < ImPerfCounter_COUNT; n++) Fds[n] = ReadIndex[n] = -1; }
+    ~ImPerfCounters()                                       { Close(); }
+    bool            Open();
+    void            Close();
+    bool            Read(ImU64 out_values[ImPerfCounter_COUNT]); // Read all counters at once. Unavailable counters are set to 0.
+    bool            IsOpen() const                          { return GroupFd != -1; }
+    bool            IsAvailable(ImPerfCounter counter) const{ return ReadIndex[counter] != -1; }
+};
+
+const char*         ImPerfCounterGetName(ImPerfCounter counter);
+
+// Machine state which affects performance measurements. Fully implemented on Linux, partially elsewhere.
+struct ImPerfEnvironment
+{
+    char            CpuModel[128] = "";                     // e.g. "AMD Ryzen 9 5950X 16-Core Processor". Empty when unknown.
+    char            CpuGovernor[32] = "";                   // CPU frequency scaling governor, e.g. "performance", "powersave". Empty when unknown.
+    int             NumCores = 0;                           // Number of logical CPUs
+    double          LoadAverage = -1.0;                     // System load average over last minute. -1.0 when unknown.
+};
+
+void                ImPerfEnvironmentQuery(ImPerfEnvironment* out_env, int cpu = 0); // Governor is queried for 'cpu'
+
+//-----------------------------------------------------------------------------
+// Sampling Profiler Helpers
+//-----------------------------------------------------------------------------
+
+// Sample call stacks of the thread calling Start(), at a fixed rate of that thread's CPU time. Currently only implemented on Linux.
+// Stacks are recorded by a SIGPROF handler into buffers allocated by Start(), symbols are only resolved by WriteFoldedStacks().
+// Symbols are resolved with dladdr(): link with -rdynamic to get names of non-exported functions. Frames which can't be named
+// are written as "module+0xoffset", which can be resolved offline with addr2line. Only one profiler may run at a time.
+// Stop() restores the SIGPROF handler which was installed before Start().
+// Stacks are walked with backtrace(), which isn't async-signal-safe: see comments in ImSamplingProfilerSignalHandler().
+struct ImSamplingProfiler
+{
+    int             MaxDepth = 64;                          // Max number of frames recorded per sample
+    int             MaxSamples = 16384;                     // Max number of samples between two Clear() calls, further samples are dropped
+    ImVector<void*> Frames;                                 // MaxSamples * MaxDepth return addresses, innermost first
+    ImVector<int>   Depths;                                 // Number of frames of each sample
+    volatile int    SamplesCount = 0;
+    volatile int    SamplesDropped = 0;
+    void*           Timer = NULL;                           // timer_t
+    bool            Running = false;
+
+    ~ImSamplingProfiler()                                   { Stop(); }
+    bool            Start(int frequency_hz);
+    void            Stop();
+    void            Clear()                                 { SamplesCount = SamplesDropped = 0; }
+    bool            IsRunning() const                       { return Running; }
+    bool            WriteFoldedStacks(const char* filename) const; // One "outer;...;inner count" line per unique stack, as used by flamegraph tools
+};
 
 //-----------------------------------------------------------------------------
 // Build Info helpers
@@ -151,6 +251,28 @@ struct ImMovingAverage
     bool    IsFull() const          { return FillAmount == Samples.Size; }
 };
 
+//-----------------------------------------------------------------------------
+// Helper: calculate distribution statistics of a set of samples
+//-----------------------------------------------------------------------------
+
+struct ImSampleStats
+{
+    int     Count = 0;
+    double  Mean = 0.0;
+    double  Min = 0.0;
+    double  Max = 0.0;
+    double  Median = 0.0;
+    double  P90 = 0.0;
+    double  P99 = 0.0;
+    double  StdDev = 0.0;                       // Sample standard deviation
+    double  Iqm = 0.0;                          // Interquartile mean: mean of samples between 25th and 75th percentiles, robust to outliers.
+
+    void    Calc(double* samples, int count);   // Sort 'samples' in place then calculate statistics.
+};
+
+double      ImPercentileOfSorted(const double* sorted_samples, int count, double percentile); // 'percentile' in 0.0f..1.0f range. Linear interpolation between closest ranks.
+double      ImStudentTCdf(double t, double dof);    // Cumulative distribution function of Student's t-distribution: probability of a value <= t.
+
 //-----------------------------------------------------------------------------
 // Helper: Simple/dumb CSV parser
 //-----------------------------------------------------------------------------
@@ -160,6 +282,8 @@ struct ImGuiCsvParser
     // Public fields
     int             Columns = 0;                    // Number of columns in CSV file.
     int             Rows = 0;                       // Number of rows in CSV file.
+    int             ColumnsMin = -1;                // When >0: rows with at least ColumnsMin columns are accepted, missing cells are empty strings (to load files created with less columns).
+    bool            ColumnsExtraIgnored = false;    // When true: rows with more than Columns columns are accepted, extra cells are ignored (to load files created with more columns).
 
     // Internal fields
     char*           _Data = NULL;                   // CSV file data.
@@ -104,13 +104,26 @@ struct TestSuiteApp
     ImGuiTestVerboseLevel       OptVerboseLevelError = ImGuiTestVerboseLevel_COUNT; // "
     bool                        OptNoThrottle = false;
     bool                        OptPauseOnExit = true;
+    bool                        OptLogAsync = false;
     bool                        OptViewports = false;
     bool                        OptMockViewports = false;
     bool                        OptCaptureEnabled = true;
+    bool                        OptCaptureUpdateReferences = false;
+    bool                        OptSoftRaster = false;
     int                         OptStressAmount = 5;
+    bool                        OptPerfCounters = false;
+    bool                        OptPerfAdaptive = false;
+    int                         OptPerfScalingSteps = 0;
+    bool                        OptPerfControlledEnv = false;
+    bool                        OptPerfSampling = false;
     Str128                      OptSourceFileOpener;
     Str128                      OptExportFilename;
     ImGuiTestEngineExportFormat OptExportFormat = ImGuiTestEngineExportFormat_JUnitXml;
+    int                         OptShardIndex = 0;              // 0-based (command-line is 1-based)
+    int                         OptShardCount = 1;
+    Str128                      OptDurationsFilename;           // Empty: don't load/save test durations (shards split tests evenly)
+    Str128                      OptPerfBaselineFilename;
+    Str128                      OptCaptureStorePath;
     ImVector<char*>             TestsToRun;
 };
 
@@ -171,11 +184,23 @@ static void TestSuite_PrintCommandLineHelp()
     printf("  -slow                    : run automation at feeble human speed.\n");
     printf("  -nothrottle              : run GUI app without throttling/vsync by default.\n");
     printf("  -nopause                 : don't pause application on exit.\n");
+    printf("  -log-async               : write log output from a background thread, so a slow console doesn't stall tests (used on CI).\n");
     printf("  -nocapture               : don't capture any images or video.\n");
+    printf("  -update-references       : save captures as new reference images when missing or mismatching, instead of failing.\n");
+    printf("  -softraster              : rasterize on CPU to capture images and videos without gui (otherwise captures are disabled with -nogui).\n");
+    printf("  -capture-store <dir>     : save screenshots through a content-addressed store: images identical to a stored one are not encoded again.\n");
     printf("  -stressamount <int>      : set performance test duration multiplier (default: 5)\n");
+    printf("  -perfcounters            : record hardware performance counters in performance tests (Linux only).\n");
+    printf("  -perfadaptive            : calibrate number of frames measured by performance tests, until results are precise enough.\n");
+    printf("  -perfscaling <steps>     : run performance tests at <steps> (1..16) stress amounts (doubling each time), fit results to complexity classes.\n");
+    printf("  -perfcontrolled          : pin threads to one CPU and warm up CPU before performance tests (Linux only).\n");
+    printf("  -perfsampling            : sample call stacks during performance tests, save folded stacks next to perflog (Linux only).\n");
+    printf("  -perf-baseline <file>    : compare performance tests against a baseline perflog, fail tests which regressed.\n");
     printf("  -fileopener <file>       : provide a bat/cmd/shell script to open source file.\n");
     printf("  -export-file <file>      : save test run results in specified file.\n");
-    printf("  -export-format <format>  : save test run results in specified format. (default: junit)\n");
+    printf("  -export-format <format>  : save test run results in specified format: junit, jsonl. (default: junit)\n");
+    printf("  -shard <i>/<n>           : only run i-th part (1-based) of queued tests split in n parts of similar duration.\n");
+    printf("  -durations <file>        : file to load/save test durations used by -shard. All shards must use the same file.\n");
     printf("  -list                    : list queued tests (one per line) and exit.\n");
     printf("Tests:\n");
     printf("   all/tests/perf          : queue by groups: all, only tests, only performance benchmarks.\n");
@@ -220,7 +245,14 @@ static bool TestSuite_ParseCommandLineOptions(TestSuiteApp* app, int argc, char*
         else if (strcmp(argv[n], "-slow") == 0)         { app->OptRunSpeed = ImGuiTestRunSpeed_Normal; app->OptNoThrottle = false; }
         else if (strcmp(argv[n], "-nothrottle") == 0)   { app->OptNoThrottle = true; }
         else if (strcmp(argv[n], "-nopause") == 0)      { app->OptPauseOnExit = false; }
+        else if (strcmp(argv[n], "-log-async") == 0)    { app->OptLogAsync = true; }
         else if (strcmp(argv[n], "-nocapture") == 0)    { app->OptCaptureEnabled = false; }
+        else if (strcmp(argv[n], "-update-references") == 0) { app->OptCaptureUpdateReferences = true; }
+        else if (strcmp(argv[n], "-softraster") == 0)   { app->OptSoftRaster = true; }
+        else if (strcmp(argv[n], "-perfcounters") == 0) { app->OptPerfCounters = true; }
+        else if (strcmp(argv[n], "-perfadaptive") == 0) { app->OptPerfAdaptive = true; }
+        else if (strcmp(argv[n], "-perfcontrolled") == 0) { app->OptPerfControlledEnv = true; }
+        else if (strcmp(argv[n], "-perfsampling") == 0) { app->OptPerfSampling = true; }
         else if (strcmp(argv[n], "-viewport") == 0)     { app->OptViewports = true; }
         else if (strcmp(argv[n], "-viewport-mock") == 0){ app->OptViewports = app->OptMockViewports = true; }
         else if (strcmp(argv[n], "-stressamount") == 0 && n + 1 < argc)
@@ -228,6 +260,14 @@ static bool TestSuite_ParseCommandLineOptions(TestSuiteApp* app, int argc, char*
             app->OptStressAmount = atoi(argv[n + 1]);
             n++;
         }
+        else if (strcmp(argv[n], "-perfscaling") == 0 && n + 1 < argc)
+        {
+            const int steps = atoi(argv[n + 1]);
+            app->OptPerfScalingSteps = ImClamp(steps, 1, 16);
+            if (app->OptPerfScalingSteps != steps)
+                fprintf(stderr, "Value '%s' passed to '-perfscaling' clamped to %d (expected 1..16).\n", argv[n + 1], app->OptPerfScalingSteps);
+            n++;
+        }
         else if (strcmp(argv[n], "-fileopener") == 0 && n + 1 < argc)
         {
             app->OptSourceFileOpener = argv[n + 1];
@@ -240,16 +280,50 @@ static bool TestSuite_ParseCommandLineOptions(TestSuiteApp* app, int argc, char*
             {
                 app->OptExportFormat = ImGuiTestEngineExportFormat_JUnitXml;
             }
+            else if (strcmp(argv[n + 1], "jsonl") == 0)
+            {
+                app->OptExportFormat = ImGuiTestEngineExportFormat_JsonLines;
+            }
             else
             {
                 fprintf(stderr, "Unknown value '%s' passed to '-export-format'.", argv[n + 1]);
                 fprintf(stderr, "Possible values:\n");
                 fprintf(stderr, "- junit\n");
+                fprintf(stderr, "- jsonl\n");
             }
+            n++;
         }
         else if (strcmp(argv[n], "-export-file") == 0 && n + 1 < argc)
         {
             app->OptExportFilename = argv[n + 1];
+            n++;
+        }
+        else if (strcmp(argv[n], "-shard") == 0 && n + 1 < argc)
+        {
+            int shard_index = 0, shard_count = 0;
+            if (sscanf(argv[n + 1], "%d/%d", &shard_index, &shard_count) != 2 || shard_count < 1 || shard_index < 1 || shard_index > shard_count)
+            {
+                fprintf(stderr, "Invalid value '%s' passed to '-shard', expected <i>/<n> with 1 <= i <= n.\n", argv[n + 1]);
+                return false;
+            }
+            app->OptShardIndex = shard_index - 1;
+            app->OptShardCount = shard_count;
+            n++;
+        }
+        else if (strcmp(argv[n], "-durations") == 0 && n + 1 < argc)
+        {
+            app->OptDurationsFilename = argv[n + 1];
+            n++;
+        }
+        else if (strcmp(argv[n], "-capture-store") == 0 && n + 1 < argc)
+        {
+            app->OptCaptureStorePath = argv[n + 1];
+            n++;
+        }
+        else if (strcmp(argv[n], "-perf-baseline") == 0 && n + 1 < argc)
+        {
+            app->OptPerfBaselineFilename = argv[n + 1];
+            n++;
         }
         else if (strcmp(argv[n], "-list") == 0)
         {
@@ -341,6 +415,28 @@ static void TestSuite_QueueTests(TestSuiteApp* app, ImGuiTestRunFlags run_flags)
     }
     ImGuiTestEngine_QueueTests(app->TestEngine, ImGuiTestGroup_Unknown, filter.c_str(), run_flags);
     app->TestsToRun.clear();
+
+    // Load durations of previous runs, only when explicitly requested: all shards must split the queue using the same
+    // durations, which a per-machine default file wouldn't guarantee. (also preserves durations of tests we don't run when saving them back)
+    bool durations_loaded = false;
+    if (!app->OptDurationsFilename.empty())
+    {
+        durations_loaded = ImGuiTestEngine_LoadTestDurations(app->TestEngine, app->OptDurationsFilename.c_str());
+        if (!durations_loaded && app->OptShardCount > 1)
+            fprintf(stderr, "Test durations not found in '%s', splitting tests evenly.\n", app->OptDurationsFilename.c_str());
+    }
+
+    // Keep our shard of the queue
+    if (app->OptShardCount > 1)
+    {
+        const float estimated_duration = ImGuiTestEngine_ShardTestQueue(app->TestEngine, app->OptShardIndex, app->OptShardCount);
+        ImVector<ImGuiTestRunTask> tests;
+        ImGuiTestEngine_GetTestQueue(app->TestEngine, &tests);
+        if (durations_loaded)
+            printf("Shard %d/%d: %d tests queued (estimated %.1f s)\n", app->OptShardIndex + 1, app->OptShardCount, tests.Size, estimated_duration);
+        else
+            printf("Shard %d/%d: %d tests queued\n", app->OptShardIndex + 1, app->OptShardCount, tests.Size);
+    }
 }
 
 static void FindVideoEncoder(char* out, int out_len)
@@ -459,8 +555,13 @@ int main(int argc, char** argv)
     // Creates Application Wrapper
     if (app->OptGui)
         app->AppWindow = ImGuiApp_ImplDefault_Create();
+    bool app_can_capture = true;
     if (app->AppWindow == NULL)
+    {
         app->AppWindow = ImGuiApp_ImplNull_Create();
+        app->AppWindow->SoftRasterizer = app->OptSoftRaster;
+        app_can_capture = app->OptSoftRaster;
+    }
     app->AppWindow->DpiAware = false;
     app->AppWindow->MockViewports = app->OptViewports && app->OptMockViewports;
 
@@ -475,12 +576,25 @@ int main(int argc, char** argv)
     test_io.ConfigVerboseLevel = app->OptVerboseLevelBasic;
     test_io.ConfigVerboseLevelOnError = app->OptVerboseLevelError;
     test_io.ConfigNoThrottle = app->OptNoThrottle;
+    test_io.ConfigLogAsync = app->OptLogAsync;
     test_io.PerfStressAmount = app->OptStressAmount;
-    test_io.ConfigCaptureEnabled = app->OptCaptureEnabled;
+    test_io.ConfigCaptureEnabled = app->OptCaptureEnabled && app_can_capture;
+    test_io.ConfigCaptureUpdateReferences = app->OptCaptureUpdateReferences;
+    test_io.ConfigPerfCounters = app->OptPerfCounters;
+    test_io.ConfigPerfAdaptiveIterations = app->OptPerfAdaptive;
+    test_io.ConfigPerfScalingSteps = app->OptPerfScalingSteps;
+    test_io.ConfigPerfControlledEnv = app->OptPerfControlledEnv;
+    test_io.ConfigPerfSampling = app->OptPerfSampling;
     FindVideoEncoder(test_io.VideoCaptureEncoderPath, IM_ARRAYSIZE(test_io.VideoCaptureEncoderPath));
     ImStrncpy(test_io.VideoCaptureEncoderParams, IMGUI_CAPTURE_DEFAULT_VIDEO_PARAMS_FOR_FFMPEG, IM_ARRAYSIZE(test_io.VideoCaptureEncoderParams));
     ImStrncpy(test_io.GifCaptureEncoderParams, IMGUI_CAPTURE_DEFAULT_GIF_PARAMS_FOR_FFMPEG, IM_ARRAYSIZE(test_io.GifCaptureEncoderParams));
+    ImStrncpy(test_io.ImageCaptureStorePath, app->OptCaptureStorePath.c_str(), IM_ARRAYSIZE(test_io.ImageCaptureStorePath));
     test_io.CheckDrawDataIntegrity = true;
+    if (!app->OptPerfBaselineFilename.empty() && !ImGuiTestEngine_LoadPerfBaseline(engine, app->OptPerfBaselineFilename.c_str()))
+    {
+        fprintf(stderr, "Invalid value '%s' passed to '-perf-baseline': regressions can't be checked.\n", app->OptPerfBaselineFilename.c_str());
+        return ImGuiTestAppErrorCode_CommandLineError;
+    }
 
     if (app->OptGui)
     {
@@ -515,6 +629,7 @@ int main(int argc, char** argv)
         {
             test_io.ExportResultsFilename = app->OptExportFilename.c_str();
             test_io.ExportResultsFormat = !app->OptExportFilename.empty() ? app->OptExportFormat : ImGuiTestEngineExportFormat_None;
+            test_io.ConfigExportKeepLogs = app->OptGui;
         }
         else
         {
@@ -621,6 +736,10 @@ int main(int argc, char** argv)
         ImGuiTestEngine_PrintResultSummary(engine);
         if (count_tested != count_success)
             error_code = ImGuiTestAppErrorCode_TestFailed;
+
+        // Record test durations for next sharded runs
+        if (count_tested > 0 && !app->OptDurationsFilename.empty())
+            ImGuiTestEngine_SaveTestDurations(engine, app->OptDurationsFilename.c_str());
     }
 
     // Shutdown Application Window
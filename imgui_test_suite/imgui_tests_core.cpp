@@ -9,9 +9,11 @@
 #include "imgui_test_suite.h"
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
+#include "imgui_test_engine/imgui_te_internal.h"    // ImGuiTestEngine::CaptureContext
 #include "imgui_test_engine/imgui_te_utils.h"       // ImHashDecoratedPath()
 #include "imgui_test_engine/imgui_capture_tool.h"
 #include "imgui_test_engine/thirdparty/Str/Str.h"
+#include "shared/imgui_app.h"                       // ImGuiApp_SoftRasterDrawData()
 #if IMGUI_TEST_ENGINE_ENABLE_IMPLOT
 #include "thirdparty/implot/implot.h"
 #endif
@@ -5822,6 +5824,49 @@ void RegisterTests_TestEngine(ImGuiTestEngine* e)
         IM_CHECK_LT(n++, 3);
     };
 
+    // ## Test asynchronous log output when console can't keep up: Info lines are dropped and reported, Warning/Error lines are kept
+    t = IM_REGISTER_TEST(e, "testengine", "testengine_log_async_overflow");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // Queue holding ~2 lines, written to a buffer by a slow writer thread: producer keeps running out of room
+        ImGuiTextBuffer output;
+        ImGuiTestLogOutputQueue* queue = ImGuiTestEngine_LogOutputQueueCreate(64, &output, 1);
+        const int lines_count = 200;
+        int info_count = 0;
+        for (int n = 0; n < lines_count; n++)
+        {
+            const ImGuiTestVerboseLevel level = (n % 10 == 9) ? ImGuiTestVerboseLevel_Error : (n % 10 == 4) ? ImGuiTestVerboseLevel_Warning : ImGuiTestVerboseLevel_Info;
+            const char* level_name = (level == ImGuiTestVerboseLevel_Error) ? "error" : (level == ImGuiTestVerboseLevel_Warning) ? "warning" : "info";
+            info_count += (level == ImGuiTestVerboseLevel_Info) ? 1 : 0;
+            ImGuiTestEngine_LogOutputQueuePush(queue, ImGuiTestLogOutput_TTY, level, Str64f("%s %03d: padding padding padding\n", level_name, n).c_str());
+        }
+        ImGuiTestEngine_LogOutputQueueDestroy(queue);
+
+        // Lines are written in order, dropped lines are reported before next written line
+        int info_written = 0, dropped_reported = 0, kept_count = 0, last_n = -1;
+        for (const char* line = output.begin(); line < output.end(); line = strchr(line, '\n') + 1)
+        {
+            char level_name[16];
+            int n = 0, dropped = 0;
+            if (sscanf(line, "(%d log lines dropped", &dropped) == 1)
+            {
+                dropped_reported += dropped;
+                continue;
+            }
+            IM_CHECK(sscanf(line, "%15s %d:", level_name, &n) == 2);
+            IM_CHECK_GT(n, last_n);
+            last_n = n;
+            if (strcmp(level_name, "info") == 0)
+                info_written++;
+            else
+                kept_count++;
+        }
+        ctx->LogDebug("Info lines: %d written, %d dropped", info_written, dropped_reported);
+        IM_CHECK_EQ(kept_count, lines_count - info_count);
+        IM_CHECK_GT(dropped_reported, 0);
+        IM_CHECK_EQ(info_written + dropped_reported, info_count);
+    };
+
     // ## Test using RunChildTest()
     struct TestEngineChildTestVars { int Count = 0; };
     t = IM_REGISTER_TEST(e, "testengine", "testengine_childtests_1");
@@ -6619,6 +6664,167 @@ void RegisterTests_TestEngine(ImGuiTestEngine* e)
 // Tests: Capture
 //-------------------------------------------------------------------------
 
+#if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
+// Minimal .gif decoder, enough to check output of builtin encoder: local color tables only, no interlacing.
+// Images are drawn over previous ones (disposal method 1): a copy of w*h canvas is appended to 'out_frames' after each image.
+// 'out_lzw_resets' counts clear codes emitted in middle of image data (code table was full).
+static bool DecodeGifFrames(const unsigned char* data, size_t data_size, int* out_w, int* out_h, ImVector<unsigned int>* out_frames, int* out_lzw_resets)
+{
+    size_t pos = 13;
+    if (data_size < pos || memcmp(data, "GIF89a", 6) != 0)
+        return false;
+    const int w = data[6] | (data[7] << 8);
+    const int h = data[8] | (data[9] << 8);
+    if (data[10] & 0x80)
+        pos += (size_t)3 << ((data[10] & 7) + 1); // Skip global color table
+    auto read_sub_blocks = [&](ImVector<unsigned char>* out)
+    {
+        while (pos < data_size)
+        {
+            const size_t len = data[pos++];
+            if (len == 0)
+                return true;
+            if (pos + len > data_size)
+                return false;
+            if (out != NULL)
+                for (size_t n = 0; n < len; n++)
+                    out->push_back(data[pos + n]);
+            pos += len;
+        }
+        return false;
+    };
+
+    ImVector<unsigned int> canvas;
+    canvas.resize(w * h, 0);
+    ImVector<unsigned char> lzw_data, indices;
+    ImVector<unsigned short> prefixes;
+    ImVector<unsigned char> suffixes;
+    prefixes.resize(4096);
+    suffixes.resize(4096);
+    int transparent_index = -1;
+    out_frames->resize(0);
+    *out_lzw_resets = 0;
+    while (pos < data_size)
+    {
+        const unsigned char block = data[pos++];
+        if (block == 0x3B) // Trailer
+        {
+            *out_w = w;
+            *out_h = h;
+            return true;
+        }
+        if (block == 0x21) // Extension
+        {
+            if (pos >= data_size)
+                return false;
+            const unsigned char label = data[pos++];
+            if (label == 0xF9 && pos + 5 <= data_size) // Graphic Control Extension
+                transparent_index = (data[pos + 1] & 1) ? data[pos + 4] : -1;
+            if (!read_sub_blocks(NULL))
+                return false;
+            continue;
+        }
+
+        // Image Descriptor + Local Color Table
+        if (block != 0x2C || pos + 9 > data_size)
+            return false;
+        const int x0 = data[pos + 0] | (data[pos + 1] << 8);
+        const int y0 = data[pos + 2] | (data[pos + 3] << 8);
+        const int iw = data[pos + 4] | (data[pos + 5] << 8);
+        const int ih = data[pos + 6] | (data[pos + 7] << 8);
+        const unsigned char flags = data[pos + 8];
+        pos += 9;
+        if ((flags & 0x80) == 0 || (flags & 0x40) != 0 || x0 + iw > w || y0 + ih > h)
+            return false;
+        unsigned int palette[256];
+        const int colors_count = 2 << (flags & 7);
+        if (pos + (size_t)colors_count * 3 >= data_size)
+            return false;
+        for (int n = 0; n < colors_count; n++, pos += 3)
+            palette[n] = IM_COL32(data[pos + 0], data[pos + 1], data[pos + 2], 255);
+
+        // Image Data
+        const int min_code_size = data[pos++];
+        lzw_data.resize(0);
+        if (min_code_size < 2 || min_code_size > 8 || !read_sub_blocks(&lzw_data))
+            return false;
+        const int clear_code = 1 << min_code_size;
+        int code_size = min_code_size + 1;
+        int next_code = clear_code + 2;
+        int prev_code = -1;
+        unsigned int bits = 0;
+        int bits_count = 0;
+        int data_n = 0;
+        indices.resize(0);
+        while (true)
+        {
+            while (bits_count < code_size && data_n < lzw_data.Size)
+            {
+                bits |= (unsigned int)lzw_data[data_n++] << bits_count;
+                bits_count += 8;
+            }
+            if (bits_count < code_size)
+                return false; // Missing end of information code
+            const int code = (int)(bits & ((1u << code_size) - 1));
+            bits >>= code_size;
+            bits_count -= code_size;
+            if (code == clear_code)
+            {
+                *out_lzw_resets += (prev_code >= 0) ? 1 : 0;
+                code_size = min_code_size + 1;
+                next_code = clear_code + 2;
+                prev_code = -1;
+                continue;
+            }
+            if (code == clear_code + 1)
+                break;
+            if (code > next_code || (prev_code < 0 && code >= clear_code))
+                return false;
+
+            // Output string of code. A code not in table yet is previous string + its first index.
+            const int start = indices.Size;
+            for (int c = (code == next_code) ? prev_code : code; ; c = prefixes[c])
+            {
+                if (c < clear_code)
+                {
+                    indices.push_back((unsigned char)c);
+                    break;
+                }
+                indices.push_back(suffixes[c]);
+            }
+            for (int i = start, j = indices.Size - 1; i < j; i++, j--)
+                ImSwap(indices[i], indices[j]);
+            const unsigned char first = indices[start];
+            if (code == next_code)
+                indices.push_back(first);
+            if (prev_code >= 0 && next_code < 4096)
+            {
+                prefixes[next_code] = (unsigned short)prev_code;
+                suffixes[next_code] = first;
+                if (++next_code == (1 << code_size) && code_size < 12)
+                    code_size++;
+            }
+            prev_code = code;
+        }
+        if (indices.Size != iw * ih)
+            return false;
+
+        for (int y = 0; y < ih; y++)
+            for (int x = 0; x < iw; x++)
+            {
+                const int index = indices[y * iw + x];
+                if (index != transparent_index)
+                    canvas[(y0 + y) * w + x0 + x] = palette[index];
+            }
+        const int frame_start = out_frames->Size;
+        out_frames->resize(frame_start + w * h);
+        memcpy(out_frames->Data + frame_start, canvas.Data, (size_t)canvas.Size * sizeof(unsigned int));
+        transparent_index = -1;
+    }
+    return false;
+}
+#endif
+
 void RegisterTests_Capture(ImGuiTestEngine* e)
 {
 #if IMGUI_TEST_ENGINE_ENABLE_CAPTURE
@@ -7022,6 +7228,394 @@ void RegisterTests_Capture(ImGuiTestEngine* e)
         ctx->CaptureScreenshotWindow("//ImPlot Demo", ImGuiCaptureFlags_StitchAll | ImGuiCaptureFlags_HideMouseCursor);
     };
 #endif // IMGUI_TEST_ENGINE_ENABLE_IMPLOT
+
+    // ## Stitch capture of a window larger than viewport in both directions: one frame per tile, tiles placed correctly
+    t = IM_REGISTER_TEST(e, "capture", "capture_stitch_larger_than_viewport");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiViewport* viewport = ImGui::GetMainViewport();
+        ImGui::SetNextWindowPos(viewport->Pos, ImGuiCond_Appearing);
+        ImGui::SetNextWindowSize(ImVec2((float)(int)(viewport->Size.x * 1.6f), (float)(int)(viewport->Size.y * 1.6f)), ImGuiCond_Appearing);
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoScrollbar);
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        draw_list->AddRectFilled(window->Pos + ImVec2(window->Size.x - 40, 30), window->Pos + ImVec2(window->Size.x - 30, 40), IM_COL32(255, 0, 0, 255));
+        draw_list->AddRectFilled(window->Pos + ImVec2(30, window->Size.y - 40), window->Pos + ImVec2(40, window->Size.y - 30), IM_COL32(0, 0, 255, 255));
+        draw_list->AddRectFilled(window->Pos + window->Size - ImVec2(40, 40), window->Pos + window->Size - ImVec2(30, 30), IM_COL32(0, 255, 0, 255));
+        ctx->GenericVars.WindowSize = window->Size;
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        if (!ctx->EngineIO->ConfigCaptureEnabled)
+            return;
+        ImGuiCaptureImageBuf image;
+        ctx->CaptureReset();
+        ctx->CaptureAddWindow("Test Window");
+        ctx->CaptureArgs->InOutputImageBuf = &image;
+        const float padding = ctx->CaptureArgs->InPadding;
+        const int frame_count_start = ImGui::GetFrameCount();
+        IM_CHECK(ctx->CaptureScreenshot(ImGuiCaptureFlags_StitchAll | ImGuiCaptureFlags_HideMouseCursor));
+        const int frame_count = ImGui::GetFrameCount() - frame_count_start;
+        ctx->CaptureReset();
+
+        const ImVec2 window_size = ctx->GenericVars.WindowSize;
+        const ImVec2 viewport_size = ImGui::GetMainViewport()->Size;
+        IM_CHECK_EQ(image.Width, (int)(window_size.x + padding * 2));
+        IM_CHECK_EQ(image.Height, (int)(window_size.y + padding * 2));
+        const int tiles_count = (int)ImCeil(image.Width / viewport_size.x) * (int)ImCeil(image.Height / viewport_size.y);
+        ctx->LogInfo("Captured %d*%d pixels in %d tiles, %d frames", image.Width, image.Height, tiles_count, frame_count);
+        IM_CHECK_LE(frame_count, tiles_count + 6);
+
+        // Markers near corners of window land in different tiles
+        auto get_pixel = [&](float x, float y) { return image.Data[(int)(padding + y) * image.Width + (int)(padding + x)]; };
+        IM_CHECK_EQ(get_pixel(window_size.x - 35, 35), IM_COL32(255, 0, 0, 255));
+        IM_CHECK_EQ(get_pixel(35, window_size.y - 35), IM_COL32(0, 0, 255, 255));
+        IM_CHECK_EQ(get_pixel(window_size.x - 35, window_size.y - 35), IM_COL32(0, 255, 0, 255));
+    };
+
+    // ## Benchmark encode time and file size of image formats and PNG settings, on a large capture of demo window
+    t = IM_REGISTER_TEST(e, "capture", "capture_image_formats_benchmark");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        if (!ctx->EngineIO->ConfigCaptureEnabled)
+            return;
+        ImGuiCaptureImageBuf image;
+        ctx->SetRef("Dear ImGui Demo");
+        ctx->ItemOpen("Widgets");
+        ctx->ItemOpen("Tables & Columns");
+        ctx->CaptureReset();
+        ctx->CaptureAddWindow("");
+        ctx->CaptureArgs->InOutputImageBuf = &image;
+        IM_CHECK_SILENT(ctx->CaptureScreenshot(ImGuiCaptureFlags_StitchAll | ImGuiCaptureFlags_HideMouseCursor));
+        ctx->CaptureReset();
+        ctx->ItemClose("Widgets");
+        ctx->ItemClose("Tables & Columns");
+        IM_CHECK_SILENT(image.Data != NULL);
+
+        struct ImageFormatConfig { const char* Name; const char* Extension; int PngCompressionLevel; ImGuiCapturePngFilter PngFilter; };
+        const ImageFormatConfig configs[] =
+        {
+            { "png_default",    ".png", 8, ImGuiCapturePngFilter_Adaptive },
+            { "png_level5",     ".png", 5, ImGuiCapturePngFilter_Adaptive },
+            { "png_level5_up",  ".png", 5, ImGuiCapturePngFilter_Up },
+            { "png_level5_sub", ".png", 5, ImGuiCapturePngFilter_Sub },
+            { "png_level12",    ".png", 12, ImGuiCapturePngFilter_Adaptive },
+            { "tga_rle",        ".tga", 0, ImGuiCapturePngFilter_Adaptive },
+            { "bmp",            ".bmp", 0, ImGuiCapturePngFilter_Adaptive },
+        };
+        const int raw_size = image.Width * image.Height * 4;
+        ctx->LogInfo("Image: %d*%d pixels, %d KB raw", image.Width, image.Height, raw_size / 1024);
+        ctx->LogInfo("%-16s %10s %10s %8s", "Format", "Time (ms)", "Size (KB)", "Ratio");
+        for (const ImageFormatConfig& config : configs)
+        {
+            Str256f filename("output/captures/%s_%s%s", ctx->Test->Name, config.Name, config.Extension);
+            const uint64_t time_start = ImTimeGetInMicroseconds();
+            IM_CHECK(image.SaveFile(filename.c_str(), config.PngCompressionLevel, config.PngFilter));
+            const double time_ms = (double)(ImTimeGetInMicroseconds() - time_start) / 1000.0;
+
+            ImFileHandle f = ImFileOpen(filename.c_str(), "rb");
+            IM_CHECK_SILENT(f != NULL);
+            const ImU64 file_size = ImFileGetSize(f);
+            ImFileClose(f);
+            ctx->LogInfo("%-16s %10.2f %10d %7.1f%%", config.Name, time_ms, (int)(file_size / 1024), 100.0 * (double)file_size / raw_size);
+        }
+    };
+
+    // ## Test reference image checks: .tga round-trip, tolerance, and capture compared against a reference created on first run
+    t = IM_REGISTER_TEST(e, "capture", "capture_reference_check");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::SetNextWindowSize(ImVec2(200, 100));
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Button("Button");
+        ImGui::Text("Hello");
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // Synthetic image (full opacity as captures are)
+        ImGuiCaptureImageBuf image;
+        image.CreateEmpty(37, 11);
+        for (int n = 0; n < image.Width * image.Height; n++)
+            image.Data[n] = IM_COL32((n * 7) & 0xFF, (n / 3) & 0xFF, (n % 4 == 0) ? 255 : 0, 255);
+        const char* image_file = "output/captures/capture_reference_check_image.tga";
+        IM_CHECK(image.SaveFile(image_file));
+
+        ImGuiCaptureImageBuf loaded;
+        IM_CHECK(loaded.LoadFile(image_file));
+        IM_CHECK_EQ(loaded.Width, image.Width);
+        IM_CHECK_EQ(loaded.Height, image.Height);
+        IM_CHECK_EQ(image.Compare(&loaded, 0), 0);
+        IM_CHECK(memcmp(image.Data, loaded.Data, (size_t)(image.Width * image.Height * 4)) == 0);
+
+        // Tolerance is per channel
+        int max_diff = 0;
+        ImGuiCaptureImageBuf diff;
+        loaded.Data[5] += 3;                          // Red channel
+        loaded.Data[image.Width * 4 + 30] ^= 0x00FF0000;  // Blue channel
+        IM_CHECK_EQ(image.Compare(&loaded, 2, &max_diff, &diff), 2);
+        IM_CHECK_EQ(max_diff, 255);
+        IM_CHECK_EQ(diff.Data[5], IM_COL32(255, 0, 0, 255));
+        IM_CHECK_EQ(image.Compare(&loaded, 3), 1);
+        IM_CHECK_EQ(image.Compare(&loaded, 255), 0);
+        loaded.CreateEmpty(image.Width - 1, image.Height);
+        IM_CHECK_EQ(image.Compare(&loaded, 255), -1);
+
+        // Capture: first check creates reference (only when updating references), second check matches it
+        if (!ctx->EngineIO->ConfigCaptureEnabled)
+            return;
+        const char* reference_file = "output/captures/capture_reference_check_window.tga";
+        ImFileDelete(reference_file);
+        const bool backup_update_references = ctx->EngineIO->ConfigCaptureUpdateReferences;
+        ctx->EngineIO->ConfigCaptureUpdateReferences = true;
+        const bool created = ctx->CaptureCheckReferenceWindow("Test Window", reference_file, 0, ImGuiCaptureFlags_HideMouseCursor);
+        ctx->EngineIO->ConfigCaptureUpdateReferences = backup_update_references;
+        IM_CHECK(created);
+        IM_CHECK(ImFileExist(reference_file));
+        IM_CHECK(ctx->CaptureCheckReferenceWindow("Test Window", reference_file, 0, ImGuiCaptureFlags_HideMouseCursor));
+    };
+
+    // ## Test content-addressed capture store: identical images are encoded once and output files refer to stored file
+    t = IM_REGISTER_TEST(e, "capture", "capture_content_store");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        char store_path[] = "output/captures/capture_content_store";
+        ImGuiCaptureContext capture_ctx;
+        capture_ctx.ContentStorePath = store_path;
+        capture_ctx.EncodeThreadsCount = 0;
+
+        // Store persists across runs: make contents unique to this run
+        const unsigned int run_seed = (unsigned int)ImTimeGetInMicroseconds() | IM_COL32_A_MASK;
+        ImGuiCaptureImageBuf image;
+        for (int n = 0; n < 3; n++)
+        {
+            image.CreateEmpty(64, 32); // Pixels are moved out when saving
+            image.Data[0] = run_seed;
+            image.Data[1] = (n == 2) ? IM_COL32(255, 0, 0, 255) : IM_COL32_WHITE;
+            Str64f filename("output/captures/%s_%d.tga", ctx->Test->Name, n);
+            IM_CHECK(capture_ctx._SaveImage(&image, filename.c_str(), 8, ImGuiCapturePngFilter_Adaptive));
+        }
+        const ImGuiCaptureContentStoreStats stats = capture_ctx.GetContentStoreStats();
+        IM_CHECK_EQ(stats.ImagesStored, 2);
+        IM_CHECK_EQ(stats.ImagesReused, 1);
+        IM_CHECK(stats.BytesReused > 0);
+
+        ImGuiCaptureImageBuf loaded[3];
+        for (int n = 0; n < 3; n++)
+            IM_CHECK(loaded[n].LoadFile(Str64f("output/captures/%s_%d.tga", ctx->Test->Name, n).c_str()));
+        IM_CHECK_EQ(loaded[0].Compare(&loaded[1], 0), 0);
+        IM_CHECK_EQ(loaded[0].Compare(&loaded[2], 0), 1);
+        IM_CHECK_EQ(loaded[2].Data[0], run_seed);
+    };
+
+    // ## Test builtin GIF encoder: record an animation without video encoder executable
+    t = IM_REGISTER_TEST(e, "capture", "capture_gif_builtin_encoder");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::SetNextWindowSize(ImVec2(200, 100));
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Text("Frame %d", ImGui::GetFrameCount());
+        ImGui::ProgressBar((ImGui::GetFrameCount() % 60) / 60.0f);
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        // Encode synthetic frames, decode them back and compare pixels:
+        // - Frame 0: 200 colors in blocks (exact palette).
+        // - Frame 1: 200 colors in noise. Runs are short: LZW code table fills up and is reset several times.
+        // - Frame 2: small change over frame 1 (delta rectangle with transparent pixels).
+        // - Frame 3: 16K colors gradient (median cut palette, not exact). Then a repeated frame.
+        const int w = 128, h = 128;
+        ImVector<unsigned int> frames;
+        frames.resize(w * h * 4);
+        unsigned int* frame_pixels[4] = { &frames[0], &frames[w * h], &frames[w * h * 2], &frames[w * h * 3] };
+        auto ColorFromIndex = [](unsigned int n) { return IM_COL32(n, 255 - n, (n * 7) & 0xFF, 255); };
+        unsigned int seed = 0x12345678;
+        for (int y = 0; y < h; y++)
+            for (int x = 0; x < w; x++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                frame_pixels[0][y * w + x] = ColorFromIndex(((x / 8) + (y / 8) * 16) % 200);
+                frame_pixels[1][y * w + x] = ColorFromIndex((seed >> 16) % 200);
+                frame_pixels[2][y * w + x] = (x >= 40 && x < 60 && y >= 70 && y < 80) ? ColorFromIndex(5) : frame_pixels[1][y * w + x];
+                frame_pixels[3][y * w + x] = IM_COL32(x * 2, y * 2, x + y, 255);
+            }
+
+        const char* filename = "output/captures/capture_gif_builtin_encoder_synthetic.gif";
+        ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename));
+        ImGuiCaptureGifEncoder* encoder = ImGuiCaptureGifEncoder_Create(filename, w, h, 50, 2);
+        IM_CHECK(encoder != NULL);
+        for (int n = 0; n < 4; n++)
+            ImGuiCaptureGifEncoder_AddFrame(encoder, frame_pixels[n], n > 0 ? frame_pixels[n - 1] : NULL);
+        ImGuiCaptureGifEncoder_AddFrame(encoder, NULL, frame_pixels[3]);
+        ImGuiCaptureGifEncoder_Destroy(encoder);
+
+        size_t file_size = 0;
+        unsigned char* file_data = (unsigned char*)ImFileLoadToMemory(filename, "rb", &file_size);
+        IM_CHECK(file_data != NULL);
+        int decoded_w = 0, decoded_h = 0, lzw_resets = 0;
+        ImVector<unsigned int> decoded;
+        const bool decoded_ok = DecodeGifFrames(file_data, file_size, &decoded_w, &decoded_h, &decoded, &lzw_resets);
+        IM_FREE(file_data);
+        IM_CHECK(decoded_ok);
+        IM_CHECK_EQ(decoded_w, w);
+        IM_CHECK_EQ(decoded_h, h);
+        IM_CHECK_EQ(decoded.Size, w * h * 4); // Repeated frame is not stored again
+        IM_CHECK_GT(lzw_resets, 0);
+        for (int n = 0; n < 3; n++)
+            IM_CHECK_NO_RET(memcmp(&decoded[w * h * n], frame_pixels[n], (size_t)(w * h) * sizeof(unsigned int)) == 0);
+        int max_diff = 0;
+        for (int i = 0; i < w * h; i++)
+            for (int c = 0; c < 32; c += 8)
+                max_diff = ImMax(max_diff, ImAbs((int)((decoded[w * h * 3 + i] >> c) & 0xFF) - (int)((frame_pixels[3][i] >> c) & 0xFF)));
+        ctx->LogDebug("Gradient frame: max channel error %d", max_diff);
+        IM_CHECK_LE(max_diff, 16);
+
+        // Record a video and check it decodes
+        if (!ctx->EngineIO->ConfigCaptureEnabled || !ctx->EngineIO->GifCaptureUseBuiltinEncoder)
+            return;
+        ctx->SetRef("Test Window");
+        ctx->CaptureSetExtension(".gif");
+        ctx->CaptureAddWindow("");
+        IM_CHECK(ctx->CaptureBeginVideo());
+        ctx->SleepNoSkip(0.5f, 1.0f / 60.0f);
+        IM_CHECK(ctx->CaptureEndVideo());
+        IM_CHECK_GT(ctx->CaptureArgs->OutVideoFramesCount, 0);
+
+        // File is finalized in background
+        ctx->Engine->CaptureContext.FlushPendingImages();
+        file_data = (unsigned char*)ImFileLoadToMemory(ctx->CaptureArgs->InOutputFile, "rb", &file_size);
+        IM_CHECK(file_data != NULL);
+        const bool video_decoded_ok = DecodeGifFrames(file_data, file_size, &decoded_w, &decoded_h, &decoded, &lzw_resets);
+        IM_FREE(file_data);
+        IM_CHECK(video_decoded_ok);
+        IM_CHECK_EQ(decoded_w, (int)ctx->CaptureArgs->OutImageSize.x);
+        IM_CHECK_EQ(decoded_h, (int)ctx->CaptureArgs->OutImageSize.y);
+        IM_CHECK_GT(decoded.Size, 0);
+        IM_CHECK_LE(decoded.Size / (decoded_w * decoded_h), ctx->CaptureArgs->OutVideoFramesCount);
+    };
+
+    // ## Test software rasterizer (used to capture with NULL backend) on known primitives: filled rect, anti-aliased edge, textured glyph
+    t = IM_REGISTER_TEST(e, "capture", "capture_softraster_primitives");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        ImFont* font = io.Fonts->Fonts[0];
+        const ImVec2 glyph_pos(8.0f, 48.0f);
+        ImDrawList draw_list(ImGui::GetDrawListSharedData());
+        draw_list._ResetForNewFrame();
+        draw_list.Flags |= ImDrawListFlags_AntiAliasedFill;
+        draw_list.PushTextureID(io.Fonts->TexID);
+        draw_list.PushClipRect(ImVec2(0.0f, 0.0f), ImVec2(128.0f, 128.0f));
+        draw_list.AddRectFilled(ImVec2(8.0f, 8.0f), ImVec2(24.0f, 24.0f), IM_COL32(255, 0, 0, 255));
+        draw_list.AddTriangleFilled(ImVec2(32.0f, 8.0f), ImVec2(56.0f, 8.0f), ImVec2(32.0f, 32.0f), IM_COL32(0, 255, 0, 255));
+        draw_list.AddText(font, font->FontSize, glyph_pos, IM_COL32_WHITE, "W");
+
+        ImDrawData draw_data;
+        draw_data.Valid = true;
+        draw_data.DisplayPos = ImVec2(0.0f, 0.0f);
+        draw_data.DisplaySize = ImVec2(128.0f, 128.0f);
+        draw_data.FramebufferScale = ImVec2(1.0f, 1.0f);
+        draw_data.AddDrawList(&draw_list);
+
+        // 128 rows are split in multiple bands when worker threads are available
+        const int w = 128, h = 128;
+        ImVector<unsigned int> pixels;
+        pixels.resize(w * h);
+        ImGuiApp_SoftRasterDrawData(&draw_data, ImVec4(0.0f, 0.0f, 0.0f, 1.0f), 0, 0, w, h, pixels.Data);
+        auto Pixel = [&](int x, int y) { return pixels[y * w + x]; };
+
+        // Filled rect: exact, no anti-aliasing fringe
+        IM_CHECK_EQ(Pixel(8, 8), IM_COL32(255, 0, 0, 255));
+        IM_CHECK_EQ(Pixel(23, 23), IM_COL32(255, 0, 0, 255));
+        IM_CHECK_EQ(Pixel(7, 16), IM_COL32_BLACK);
+        IM_CHECK_EQ(Pixel(24, 16), IM_COL32_BLACK);
+        IM_CHECK_EQ(Pixel(16, 24), IM_COL32_BLACK);
+
+        // Anti-aliased triangle: opaque inside, clear outside, ~50% coverage for pixel centered on hypotenuse (x + y = 64)
+        IM_CHECK_EQ(Pixel(36, 12), IM_COL32(0, 255, 0, 255));
+        IM_CHECK_EQ(Pixel(52, 20), IM_COL32_BLACK);
+        const int edge_green = (int)((Pixel(40, 23) >> IM_COL32_G_SHIFT) & 0xFF);
+        IM_CHECK(edge_green >= 128 - 40 && edge_green <= 128 + 40);
+        IM_CHECK_EQ(Pixel(40, 23) & ~IM_COL32(0, 255, 0, 0), IM_COL32_BLACK);
+
+        // Glyph: total coverage matches coverage of its font atlas texels (exact mapping depends on font oversampling)
+        unsigned char* tex_pixels = NULL;
+        int tex_w = 0, tex_h = 0;
+        io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+        const ImFontGlyph* glyph = font->FindGlyph('W');
+        IM_CHECK(glyph != NULL);
+        double expected_coverage = 0.0;
+        for (int y = (int)(glyph->V0 * tex_h); y < (int)(glyph->V1 * tex_h + 0.5f); y++)
+            for (int x = (int)(glyph->U0 * tex_w); x < (int)(glyph->U1 * tex_w + 0.5f); x++)
+                expected_coverage += tex_pixels[(y * tex_w + x) * 4 + 3] / 255.0;
+        expected_coverage *= ((glyph->X1 - glyph->X0) * (glyph->Y1 - glyph->Y0)) / ((glyph->U1 - glyph->U0) * tex_w * (glyph->V1 - glyph->V0) * tex_h);
+        double coverage = 0.0;
+        for (int y = ImMax((int)(glyph_pos.y + glyph->Y0) - 1, 0); y < ImMin((int)(glyph_pos.y + glyph->Y1) + 2, h); y++)
+            for (int x = ImMax((int)(glyph_pos.x + glyph->X0) - 1, 0); x < ImMin((int)(glyph_pos.x + glyph->X1) + 2, w); x++)
+            {
+                IM_CHECK_EQ(Pixel(x, y) & IM_COL32_A_MASK, IM_COL32_A_MASK);
+                coverage += ((Pixel(x, y) >> IM_COL32_G_SHIFT) & 0xFF) / 255.0;
+            }
+        ctx->LogDebug("Glyph coverage: %.2f, expected %.2f", coverage, expected_coverage);
+        IM_CHECK(expected_coverage > 5.0);
+        IM_CHECK(ImAbs(coverage - expected_coverage) <= expected_coverage * 0.1);
+
+        // Rasterizing a sub-rect gives same pixels as full target
+        const int sub_x = 16, sub_y = 4, sub_w = 96, sub_h = 96;
+        ImVector<unsigned int> sub_pixels;
+        sub_pixels.resize(sub_w * sub_h);
+        ImGuiApp_SoftRasterDrawData(&draw_data, ImVec4(0.0f, 0.0f, 0.0f, 1.0f), sub_x, sub_y, sub_w, sub_h, sub_pixels.Data);
+        for (int y = 0; y < sub_h; y++)
+            IM_CHECK(memcmp(&sub_pixels[y * sub_w], &pixels[(sub_y + y) * w + sub_x], sub_w * sizeof(unsigned int)) == 0);
+    };
+
+    // ## Test video damage tracking: mostly idle window only reads back regions which changed
+    t = IM_REGISTER_TEST(e, "capture", "capture_video_damage_tracking");
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        ImGui::SetNextWindowSize(ImVec2(300, 200));
+        ImGui::Begin("Test Window", NULL, ImGuiWindowFlags_NoSavedSettings);
+        ImGui::Text("Frame %d", (ImGui::GetFrameCount() / 4) % 10);
+        for (int n = 0; n < 8; n++)
+            ImGui::Text("Static line %d", n);
+        ImGui::End();
+    };
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        if (!ctx->EngineIO->ConfigCaptureEnabled || !ctx->EngineIO->GifCaptureUseBuiltinEncoder)
+            return;
+        // Damage tracking is disabled by default: enable it (copied to capture context on next frame).
+        // Also read back whole frames and compare them with frames assembled from damaged regions (not counted in OutVideoPixelsCaptured).
+        const bool backup_damage_tracking = ctx->EngineIO->VideoCaptureDamageTracking;
+        ctx->EngineIO->VideoCaptureDamageTracking = true;
+        ctx->Yield();
+        ImGuiCaptureContext* capture_context = &ctx->Engine->CaptureContext;
+        IM_CHECK(capture_context->VideoDamageTracking);
+        capture_context->VideoDamageTrackingCheck = true;
+        ctx->SetRef("Test Window");
+        ctx->CaptureSetExtension(".gif");
+        ctx->CaptureAddWindow("");
+        const bool capture_ok = ctx->CaptureBeginVideo();
+        if (capture_ok)
+            ctx->SleepNoSkip(0.5f, 1.0f / 60.0f);
+        const bool capture_end_ok = capture_ok && ctx->CaptureEndVideo();
+        capture_context->VideoDamageTrackingCheck = false;
+        ctx->EngineIO->VideoCaptureDamageTracking = backup_damage_tracking;
+        IM_CHECK(capture_ok && capture_end_ok);
+
+        // First frame is read back entirely, following frames only read back tiles around changing text.
+        const ImGuiCaptureArgs* args = ctx->CaptureArgs;
+        const ImU64 frame_pixels = (ImU64)args->OutImageSize.x * (ImU64)args->OutImageSize.y;
+        IM_CHECK_GT(args->OutVideoFramesCount, 2);
+        IM_CHECK_GE(args->OutVideoPixelsCaptured, frame_pixels);
+        IM_CHECK_LT(args->OutVideoPixelsCaptured, frame_pixels * args->OutVideoFramesCount / 2);
+
+        // Frames recorded with damage tracking (changed or not) are byte-identical to a full readback of same frame.
+        IM_CHECK_GT(args->OutVideoDamageFramesChecked, 0);
+        IM_CHECK_EQ(args->OutVideoDamageFramesMismatched, 0);
+    };
 #else
     IM_UNUSED(e);
 #endif // IMGUI_TEST_ENGINE_ENABLE_CAPTURE
@@ -8,7 +8,10 @@
 #include "imgui_internal.h"
 #include "imgui_test_engine/imgui_te_engine.h"      // IM_REGISTER_TEST()
 #include "imgui_test_engine/imgui_te_context.h"
+#include "imgui_test_engine/imgui_te_utils.h"       // ImTimeGetInMicroseconds()
+#include "imgui_test_engine/imgui_capture_tool.h"   // ImGuiCaptureImageBuf
 #include "imgui_test_engine/thirdparty/Str/Str.h"
+#include "shared/imgui_app.h"                       // ImGuiApp_FlipPixelsVertically(), ImGuiApp_SoftRasterDrawData()
 
 // Warnings
 #ifdef _MSC_VER
@@ -1160,5 +1163,145 @@ void RegisterTests_Perf(ImGuiTestEngine* e)
             }
         }
     }
+
+    // ## Measure throughput of capture pixel kernels at 1080p and 4K, compared to previous scalar/allocating versions.
+    t = IM_REGISTER_TEST(e, "perf", "perf_capture_pixel_kernels");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        auto RemoveAlphaReference = [](unsigned int* p, int n) { while (n-- > 0) { *p |= IM_COL32_A_MASK; p++; } };
+        auto FlipVerticallyReference = [](unsigned int* pixels, int w, int h)
+        {
+            size_t stride = (size_t)w * 4;
+            unsigned char* line_tmp = new unsigned char[stride];
+            unsigned char* line_a = (unsigned char*)pixels;
+            unsigned char* line_b = (unsigned char*)pixels + (stride * ((size_t)h - 1));
+            for (; line_a < line_b; line_a += stride, line_b -= stride)
+            {
+                memcpy(line_tmp, line_a, stride);
+                memcpy(line_a, line_b, stride);
+                memcpy(line_b, line_tmp, stride);
+            }
+            delete[] line_tmp;
+        };
+
+        struct Resolution { const char* Name; int Width, Height; };
+        const Resolution resolutions[] = { { "1080p", 1920, 1080 }, { "4K", 3840, 2160 } };
+        const int iterations = 20;
+        for (const Resolution& res : resolutions)
+        {
+            ImGuiCaptureImageBuf image, image_ref;
+            image.CreateEmpty(res.Width, res.Height);
+            image_ref.CreateEmpty(res.Width, res.Height);
+            const int pixels_count = res.Width * res.Height;
+            for (int n = 0; n < pixels_count; n++)
+                image.Data[n] = image_ref.Data[n] = ((unsigned int)n * 2654435761u) & ~IM_COL32_A_MASK;
+            const double gb = (double)pixels_count * 4 * iterations / (1024.0 * 1024.0 * 1024.0);
+
+            uint64_t t0 = ImTimeGetInMicroseconds();
+            for (int n = 0; n < iterations; n++)
+                RemoveAlphaReference(image_ref.Data, pixels_count);
+            uint64_t t1 = ImTimeGetInMicroseconds();
+            for (int n = 0; n < iterations; n++)
+                image.RemoveAlpha();
+            uint64_t t2 = ImTimeGetInMicroseconds();
+            IM_CHECK(memcmp(image.Data, image_ref.Data, (size_t)pixels_count * 4) == 0);
+            ctx->LogInfo("%-5s RemoveAlpha():    %6.2f GB/s (reference: %6.2f GB/s)", res.Name, gb / ImMax((double)(t2 - t1), 1.0) * 1e6, gb / ImMax((double)(t1 - t0), 1.0) * 1e6);
+
+            // Check a single flip: an even number of flips would restore original pixels even if flipping did nothing.
+            FlipVerticallyReference(image_ref.Data, res.Width, res.Height);
+            ImGuiApp_FlipPixelsVertically(image.Data, res.Width, res.Height);
+            IM_CHECK(memcmp(image.Data, image_ref.Data, (size_t)pixels_count * 4) == 0);
+            IM_CHECK_EQ(image.Data[0], (((unsigned int)(pixels_count - res.Width) * 2654435761u) | IM_COL32_A_MASK));
+
+            t0 = ImTimeGetInMicroseconds();
+            for (int n = 0; n < iterations; n++)
+                FlipVerticallyReference(image_ref.Data, res.Width, res.Height);
+            t1 = ImTimeGetInMicroseconds();
+            for (int n = 0; n < iterations; n++)
+                ImGuiApp_FlipPixelsVertically(image.Data, res.Width, res.Height);
+            t2 = ImTimeGetInMicroseconds();
+            ctx->LogInfo("%-5s FlipVertically(): %6.2f GB/s (reference: %6.2f GB/s)", res.Name, gb / ImMax((double)(t2 - t1), 1.0) * 1e6, gb / ImMax((double)(t1 - t0), 1.0) * 1e6);
+        }
+    };
+
+    // ## Measure software rasterizer (used to capture with NULL backend) on contents of a text-heavy window
+    struct SoftRasterPerfVars { ImVector<unsigned int> Pixels; };
+    t = IM_REGISTER_TEST(e, "perf", "perf_capture_softraster");
+    t->SetVarsDataType<SoftRasterPerfVars>();
+    t->GuiFunc = [](ImGuiTestContext* ctx)
+    {
+        auto& vars = ctx->GetVars<SoftRasterPerfVars>();
+        ImGui::SetNextWindowSize(ImVec2(800, 600));
+        ImGui::Begin("Test Func", NULL, ImGuiWindowFlags_NoSavedSettings);
+        for (int n = 0; n < 40; n++)
+        {
+            ImGui::PushID(n);
+            ImGui::Text("Line %d: The quick brown fox jumps over the lazy dog", n);
+            ImGui::SameLine();
+            ImGui::Button("Button");
+            ImGui::PopID();
+        }
+        ImGuiWindow* window = ImGui::GetCurrentWindow();
+        ImGui::End();
+
+        ImDrawData draw_data;
+        draw_data.Valid = true;
+        draw_data.CmdLists.push_back(window->DrawList);
+        draw_data.CmdListsCount = 1;
+        draw_data.DisplayPos = window->Pos;
+        draw_data.DisplaySize = window->Size;
+        draw_data.FramebufferScale = ImVec2(1.0f, 1.0f);
+        const int w = (int)window->Size.x, h = (int)window->Size.y;
+        vars.Pixels.resize(w * h);
+        for (int n = 0; n < ctx->PerfStressAmount; n++)
+            ImGuiApp_SoftRasterDrawData(&draw_data, ImVec4(0.0f, 0.0f, 0.0f, 1.0f), 0, 0, w, h, vars.Pixels.Data);
+    };
+    t->TestFunc = PerfCaptureFunc;
+
+    // ## Measure builtin .gif encoder at 1080p: UI-like frames (few colors, small changes) and full frame gradients (median cut palette)
+    t = IM_REGISTER_TEST(e, "perf", "perf_capture_gif_encoder");
+    t->TestFunc = [](ImGuiTestContext* ctx)
+    {
+        const int w = 1920, h = 1080;
+        const int frames_count = 30;
+        ImVector<unsigned int> frames[2];
+        for (ImVector<unsigned int>& frame : frames)
+            frame.resize(w * h);
+        const char* filename = "output/perf_capture_gif_encoder.gif";
+        ImFileCreateDirectoryChain(filename, ImPathFindFilename(filename));
+
+        const char* content_names[] = { "UI", "Gradient" };
+        const int threads_counts[] = { 0, 4 };
+        for (int content = 0; content < IM_ARRAYSIZE(content_names); content++)
+            for (int threads_count : threads_counts)
+            {
+                ImGuiCaptureGifEncoder* encoder = ImGuiCaptureGifEncoder_Create(filename, w, h, 30, threads_count);
+                IM_CHECK(encoder != NULL);
+
+                // Only time spent in encoder calls is measured. Background threads keep compressing while next frame is generated, as they would while capturing.
+                uint64_t encode_time = 0;
+                for (int frame_n = 0; frame_n < frames_count; frame_n++)
+                {
+                    unsigned int* pixels = frames[frame_n & 1].Data;
+                    for (int y = 0; y < h; y++)
+                        for (int x = 0; x < w; x++)
+                        {
+                            if (content == 0)
+                                pixels[y * w + x] = (x >= 100 && x < 300 + frame_n * 8 && y >= 500 && y < 520) ? IM_COL32(66, 150, 250, 255) : ((x / 64 + y / 48) & 1) ? IM_COL32(48, 48, 48, 255) : IM_COL32(32, 32, 32, 255);
+                            else
+                                pixels[y * w + x] = IM_COL32((x + frame_n) & 0xFF, (y + frame_n * 2) & 0xFF, ((x + y) >> 2) & 0xFF, 255);
+                        }
+                    const uint64_t t0 = ImTimeGetInMicroseconds();
+                    ImGuiCaptureGifEncoder_AddFrame(encoder, pixels, frame_n > 0 ? frames[(frame_n - 1) & 1].Data : NULL);
+                    encode_time += ImTimeGetInMicroseconds() - t0;
+                }
+                const uint64_t t0 = ImTimeGetInMicroseconds();
+                ImGuiCaptureGifEncoder_Destroy(encoder);
+                encode_time += ImTimeGetInMicroseconds() - t0;
+                const double seconds = ImMax((double)encode_time, 1.0) / 1e6;
+                ctx->LogInfo("%-8s %d threads: %6.1f frames/s, %7.1f MB/s", content_names[content], threads_count, frames_count / seconds, (double)w * h * 4 * frames_count / (1024.0 * 1024.0) / seconds);
+            }
+        ImFileDelete(filename);
+    };
 }
 
@@ -40,6 +40,9 @@
 #include "imgui.h"
 #include "imgui_internal.h"
 #include <chrono>   // time_since_epoch
+#include <condition_variable>   // Software rasterizer threads
+#include <mutex>
+#include <thread>
 #ifdef __linux__
 #include <unistd.h> // sleep
 #endif
@@ -49,6 +52,7 @@
 Index of this file:
 
 // [SECTION] Defines
+// [SECTION] Software rasterizer (used by NULL implementation)
 // [SECTION] ImGuiApp Implementation: NULL
 // [SECTION] ImGuiApp Implementation: Win32 + DX11
 // [SECTION] ImGuiApp Implementation: SDL + OpenGL2
@@ -115,6 +119,403 @@ bool ImGuiApp_ScreenCaptureFunc(ImGuiID viewport_id, int x, int y, int w, int h,
     return app->CaptureFramebuffer(app, viewport, x, y, w, h, pixels, NULL);
 }
 
+// Swap rows through a small stack buffer, one chunk at a time: memcpy() is vectorized and chunk stays in L1 cache.
+void ImGuiApp_FlipPixelsVertically(unsigned int* pixels, int w, int h)
+{
+    unsigned char chunk_tmp[4096];
+    const size_t stride = (size_t)w * 4;
+    unsigned char* line_a = (unsigned char*)pixels;
+    unsigned char* line_b = (unsigned char*)pixels + (stride * ((size_t)h - 1));
+    while (line_a < line_b)
+    {
+        for (size_t offset = 0; offset < stride; offset += sizeof(chunk_tmp))
+        {
+            const size_t chunk_size = ImMin(stride - offset, sizeof(chunk_tmp));
+            memcpy(chunk_tmp, line_a + offset, chunk_size);
+            memcpy(line_a + offset, line_b + offset, chunk_size);
+            memcpy(line_b + offset, chunk_tmp, chunk_size);
+        }
+        line_a += stride;
+        line_b -= stride;
+    }
+}
+
+//-----------------------------------------------------------------------------
+// [SECTION] Software rasterizer (used by NULL implementation)
+//-----------------------------------------------------------------------------
+// Rasterize ImDrawData on CPU so captures work without a GPU.
+// - Only enabled with ImGuiApp::SoftRasterizer, as most headless runs don't use captures.
+// - Rasterization happens on demand when capturing, directly into capture buffer: no cost when not capturing.
+// - Capture rect is split into bands of rows rasterized by multiple threads. Each band processes all triangles
+//   in order, so blending order is same as a GPU. Worker threads are started on first use and persist until exit.
+// - Follows GL backends: pixel centers sampling, top-left fill rule, bilinear filtering clamped to edges,
+//   (SrcAlpha, OneMinusSrcAlpha) blending of colors and (One, OneMinusSrcAlpha) blending of alpha.
+// - Only font atlas texture is known: other textures are rendered as white. User callbacks are skipped.
+//-----------------------------------------------------------------------------
+
+#define IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS  4       // Vertex positions are snapped to 1/16th of a pixel
+
+struct ImGuiApp_SoftRasterTexture
+{
+    const ImU32*    Pixels = NULL;                  // RGBA32
+    int             Width = 0;
+    int             Height = 0;
+};
+
+struct ImGuiApp_SoftRasterTarget
+{
+    ImU32*          Pixels = NULL;
+    int             Width = 0;                      // Also stride
+    int             Height = 0;
+    int             OriginX = 0, OriginY = 0;       // Position of Pixels[0] in framebuffer pixels
+    int             BandY0 = 0, BandY1 = 0;         // Rows rasterized by current job
+};
+
+static inline ImU32 ImGuiApp_SoftRaster_Lerp(ImU32 a, ImU32 b, ImU32 t)
+{
+    const ImU32 rb = (((a & 0x00FF00FF) * (256 - t) + (b & 0x00FF00FF) * t) >> 8) & 0x00FF00FF;
+    const ImU32 ga = (((a >> 8) & 0x00FF00FF) * (256 - t) + ((b >> 8) & 0x00FF00FF) * t) & 0xFF00FF00;
+    return rb | ga;
+}
+
+static inline ImU32 ImGuiApp_SoftRaster_SampleBilinear(const ImGuiApp_SoftRasterTexture* tex, float u, float v)
+{
+    // Texel coordinates with 8 bits of sub-texel precision, rounded so pixel centers mapped 1:1 hit texel centers exactly.
+    const int tx = (int)ImFloor((u * tex->Width - 0.5f) * 256.0f + 0.5f);
+    const int ty = (int)ImFloor((v * tex->Height - 0.5f) * 256.0f + 0.5f);
+    const int x0 = ImClamp(tx >> 8, 0, tex->Width - 1);
+    const int y0 = ImClamp(ty >> 8, 0, tex->Height - 1);
+    const int x1 = ImClamp((tx >> 8) + 1, 0, tex->Width - 1);
+    const int y1 = ImClamp((ty >> 8) + 1, 0, tex->Height - 1);
+    const ImU32* row0 = tex->Pixels + y0 * tex->Width;
+    const ImU32* row1 = tex->Pixels + y1 * tex->Width;
+    const ImU32 top = ImGuiApp_SoftRaster_Lerp(row0[x0], row0[x1], (ImU32)(tx & 0xFF));
+    const ImU32 bottom = ImGuiApp_SoftRaster_Lerp(row1[x0], row1[x1], (ImU32)(tx & 0xFF));
+    return ImGuiApp_SoftRaster_Lerp(top, bottom, (ImU32)(ty & 0xFF));
+}
+
+// a*b/255 with rounding, for a and b in 0..255
+static inline ImU32 ImGuiApp_SoftRaster_Mul8(ImU32 a, ImU32 b)
+{
+    const ImU32 t = a * b + 128;
+    return (t + (t >> 8)) >> 8;
+}
+
+static inline ImU32 ImGuiApp_SoftRaster_Modulate(ImU32 col, ImU32 texel)
+{
+    // Font atlas is white with varying alpha: only alpha needs to be multiplied
+    if ((texel | IM_COL32_A_MASK) == IM_COL32_WHITE)
+        return (col & ~IM_COL32_A_MASK) | (ImGuiApp_SoftRaster_Mul8((col >> IM_COL32_A_SHIFT) & 0xFF, (texel >> IM_COL32_A_SHIFT) & 0xFF) << IM_COL32_A_SHIFT);
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= ImGuiApp_SoftRaster_Mul8((col >> shift) & 0xFF, (texel >> shift) & 0xFF) << shift;
+    return out;
+}
+
+static inline void ImGuiApp_SoftRaster_Blend(ImU32* dst, ImU32 src)
+{
+    const ImU32 sa = (src >> IM_COL32_A_SHIFT) & 0xFF;
+    if (sa == 0)
+        return;
+    if (sa == 255)
+    {
+        *dst = src;
+        return;
+    }
+    const ImU32 d = *dst;
+    const ImU32 out_a = sa + ImGuiApp_SoftRaster_Mul8((d >> IM_COL32_A_SHIFT) & 0xFF, 255 - sa);
+    *dst = (ImGuiApp_SoftRaster_Lerp(d, src, sa + (sa >> 7)) & ~IM_COL32_A_MASK) | (out_a << IM_COL32_A_SHIFT);
+}
+
+// Linear interpolation of a vertex attribute over a triangle, in pixel steps
+struct ImGuiApp_SoftRasterPlane
+{
+    float           Value;                          // Value at center of current pixel
+    float           StepX, StepY;
+
+    void Setup(float a0, float a1, float a2, float l1, float l2, float l1_step_x, float l2_step_x, float l1_step_y, float l2_step_y)
+    {
+        Value = a0 + (a1 - a0) * l1 + (a2 - a0) * l2;
+        StepX = (a1 - a0) * l1_step_x + (a2 - a0) * l2_step_x;
+        StepY = (a1 - a0) * l1_step_y + (a2 - a0) * l2_step_y;
+    }
+};
+
+// Rasterize one triangle clipped to [clip_x0,clip_x1) x [clip_y0,clip_y1), in target pixel coordinates.
+static void ImGuiApp_SoftRaster_Triangle(const ImGuiApp_SoftRasterTarget* target, const ImGuiApp_SoftRasterTexture* tex, const ImDrawVert* v0, const ImDrawVert* v1, const ImDrawVert* v2, const ImVec2& scale, int clip_x0, int clip_y0, int clip_x1, int clip_y1)
+{
+    // Snap positions to sub-pixel grid. Integer edge functions give exact and consistent coverage of shared edges.
+    const float subpixel_scale = (float)(1 << IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS);
+    ImS64 px[3], py[3];
+    const ImDrawVert* verts[3] = { v0, v1, v2 };
+    for (int n = 0; n < 3; n++)
+    {
+        px[n] = (ImS64)ImFloor((verts[n]->pos.x * scale.x - (float)target->OriginX) * subpixel_scale + 0.5f);
+        py[n] = (ImS64)ImFloor((verts[n]->pos.y * scale.y - (float)target->OriginY) * subpixel_scale + 0.5f);
+    }
+    ImS64 area = (px[1] - px[0]) * (py[2] - py[0]) - (py[1] - py[0]) * (px[2] - px[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        ImSwap(px[1], px[2]);
+        ImSwap(py[1], py[2]);
+        ImSwap(verts[1], verts[2]);
+        area = -area;
+    }
+
+    // Bounding box of pixel centers
+    const int subpixel_half = 1 << (IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS - 1);
+    const ImS64 min_x = ImMin(px[0], ImMin(px[1], px[2])), max_x = ImMax(px[0], ImMax(px[1], px[2]));
+    const ImS64 min_y = ImMin(py[0], ImMin(py[1], py[2])), max_y = ImMax(py[0], ImMax(py[1], py[2]));
+    const int x0 = (int)ImMax((ImS64)clip_x0, (min_x - subpixel_half) >> IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS);
+    const int y0 = (int)ImMax((ImS64)ImMax(clip_y0, target->BandY0), (min_y - subpixel_half) >> IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS);
+    const int x1 = (int)ImMin((ImS64)clip_x1 - 1, (max_x - subpixel_half) >> IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS);
+    const int y1 = (int)ImMin((ImS64)ImMin(clip_y1, target->BandY1) - 1, (max_y - subpixel_half) >> IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS);
+    if (x0 > x1 || y0 > y1)
+        return;
+
+    // Edge functions, evaluated at center of first pixel, with top-left fill rule bias.
+    // Edge n is opposite to vertex n, so its value is the (unnormalized) barycentric weight of vertex n.
+    ImS64 edge_row[3], edge_step_x[3], edge_step_y[3];
+    const ImS64 sample_x = ((ImS64)x0 << IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS) + subpixel_half;
+    const ImS64 sample_y = ((ImS64)y0 << IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS) + subpixel_half;
+    for (int n = 0; n < 3; n++)
+    {
+        const int a = (n + 1) % 3, b = (n + 2) % 3;
+        const ImS64 dx = px[b] - px[a];
+        const ImS64 dy = py[b] - py[a];
+        const bool is_top_left = (dy == 0 && dx > 0) || (dy < 0);
+        edge_row[n] = dx * (sample_y - py[a]) - dy * (sample_x - px[a]) - (is_top_left ? 0 : 1);
+        edge_step_x[n] = -dy << IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS;
+        edge_step_y[n] = dx << IMGUI_APP_SOFTRASTER_SUBPIXEL_BITS;
+    }
+
+    // Attributes are constant for most of UI triangles (solid fills use a single white pixel of atlas).
+    const bool is_col_constant = (verts[0]->col == verts[1]->col && verts[0]->col == verts[2]->col);
+    const bool is_uv_constant = (tex->Pixels == NULL) || (verts[0]->uv.x == verts[1]->uv.x && verts[0]->uv.x == verts[2]->uv.x && verts[0]->uv.y == verts[1]->uv.y && verts[0]->uv.y == verts[2]->uv.y);
+    const ImU32 texel_constant = (tex->Pixels == NULL) ? IM_COL32_WHITE : is_uv_constant ? ImGuiApp_SoftRaster_SampleBilinear(tex, verts[0]->uv.x, verts[0]->uv.y) : 0;
+    if (is_col_constant && is_uv_constant)
+    {
+        const ImU32 src = ImGuiApp_SoftRaster_Modulate(verts[0]->col, texel_constant);
+        if (((src >> IM_COL32_A_SHIFT) & 0xFF) == 0)
+            return;
+        for (int y = y0; y <= y1; y++)
+        {
+            ImS64 w0 = edge_row[0], w1 = edge_row[1], w2 = edge_row[2];
+            ImU32* dst = target->Pixels + (size_t)y * target->Width + x0;
+            for (int x = x0; x <= x1; x++, dst++, w0 += edge_step_x[0], w1 += edge_step_x[1], w2 += edge_step_x[2])
+                if ((w0 | w1 | w2) >= 0)
+                    ImGuiApp_SoftRaster_Blend(dst, src);
+            edge_row[0] += edge_step_y[0];
+            edge_row[1] += edge_step_y[1];
+            edge_row[2] += edge_step_y[2];
+        }
+        return;
+    }
+
+    // Setup interpolation of varying attributes
+    const float inv_area = 1.0f / (float)area;
+    const float l1 = (float)edge_row[1] * inv_area, l2 = (float)edge_row[2] * inv_area;
+    const float l1_step_x = (float)edge_step_x[1] * inv_area, l2_step_x = (float)edge_step_x[2] * inv_area;
+    const float l1_step_y = (float)edge_step_y[1] * inv_area, l2_step_y = (float)edge_step_y[2] * inv_area;
+    ImGuiApp_SoftRasterPlane planes[6];                 // U, V, R, G, B, A
+    if (!is_uv_constant)
+    {
+        planes[0].Setup(verts[0]->uv.x, verts[1]->uv.x, verts[2]->uv.x, l1, l2, l1_step_x, l2_step_x, l1_step_y, l2_step_y);
+        planes[1].Setup(verts[0]->uv.y, verts[1]->uv.y, verts[2]->uv.y, l1, l2, l1_step_x, l2_step_x, l1_step_y, l2_step_y);
+    }
+    if (!is_col_constant)
+        for (int n = 0; n < 4; n++)
+        {
+            const int shift = n * 8;
+            planes[2 + n].Setup((float)((verts[0]->col >> shift) & 0xFF), (float)((verts[1]->col >> shift) & 0xFF), (float)((verts[2]->col >> shift) & 0xFF), l1, l2, l1_step_x, l2_step_x, l1_step_y, l2_step_y);
+        }
+
+    for (int y = y0; y <= y1; y++)
+    {
+        ImS64 w0 = edge_row[0], w1 = edge_row[1], w2 = edge_row[2];
+        ImGuiApp_SoftRasterPlane row_planes[6];
+        memcpy(row_planes, planes, sizeof(planes));
+        ImU32* dst = target->Pixels + (size_t)y * target->Width + x0;
+        for (int x = x0; x <= x1; x++, dst++, w0 += edge_step_x[0], w1 += edge_step_x[1], w2 += edge_step_x[2])
+        {
+            if ((w0 | w1 | w2) >= 0)
+            {
+                ImU32 src_col = verts[0]->col;
+                if (!is_col_constant)
+                {
+                    src_col = 0;
+                    for (int n = 0; n < 4; n++)
+                        src_col |= (ImU32)ImClamp((int)(row_planes[2 + n].Value + 0.5f), 0, 255) << (n * 8);
+                }
+                const ImU32 texel = is_uv_constant ? texel_constant : ImGuiApp_SoftRaster_SampleBilinear(tex, row_planes[0].Value, row_planes[1].Value);
+                ImGuiApp_SoftRaster_Blend(dst, ImGuiApp_SoftRaster_Modulate(src_col, texel));
+            }
+            for (ImGuiApp_SoftRasterPlane& plane : row_planes)
+                plane.Value += plane.StepX;
+        }
+        for (ImGuiApp_SoftRasterPlane& plane : planes)
+            plane.Value += plane.StepY;
+        edge_row[0] += edge_step_y[0];
+        edge_row[1] += edge_step_y[1];
+        edge_row[2] += edge_step_y[2];
+    }
+}
+
+static void ImGuiApp_SoftRaster_RenderBand(const ImDrawData* draw_data, const ImGuiApp_SoftRasterTexture* font_tex, ImTextureID font_tex_id, ImGuiApp_SoftRasterTarget target)
+{
+    const ImVec2 scale = draw_data->FramebufferScale;
+    const ImVec2 display_pos = draw_data->DisplayPos;
+    const ImGuiApp_SoftRasterTexture white_tex;
+    for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+        for (const ImDrawCmd& cmd : draw_list->CmdBuffer)
+        {
+            if (cmd.UserCallback != NULL)
+                continue;
+
+            // Clip rect in target pixel coordinates, truncated like glScissor() parameters
+            const int clip_x0 = ImMax(0, (int)((cmd.ClipRect.x - display_pos.x) * scale.x) - target.OriginX);
+            const int clip_y0 = ImMax(0, (int)((cmd.ClipRect.y - display_pos.y) * scale.y) - target.OriginY);
+            const int clip_x1 = ImMin(target.Width, (int)((cmd.ClipRect.z - display_pos.x) * scale.x) - target.OriginX);
+            const int clip_y1 = ImMin(target.Height, (int)((cmd.ClipRect.w - display_pos.y) * scale.y) - target.OriginY);
+            if (clip_x0 >= clip_x1 || ImMax(clip_y0, target.BandY0) >= ImMin(clip_y1, target.BandY1))
+                continue;
+
+            const ImGuiApp_SoftRasterTexture* tex = (cmd.GetTexID() == font_tex_id) ? font_tex : &white_tex;
+            const ImDrawVert* vtx = draw_list->VtxBuffer.Data + cmd.VtxOffset;
+            const ImDrawIdx* idx = draw_list->IdxBuffer.Data + cmd.IdxOffset;
+            for (unsigned int n = 0; n + 2 < cmd.ElemCount; n += 3)
+            {
+                // Translate vertices to framebuffer space
+                ImDrawVert v[3] = { vtx[idx[n]], vtx[idx[n + 1]], vtx[idx[n + 2]] };
+                for (ImDrawVert& vert : v)
+                {
+                    vert.pos.x -= display_pos.x;
+                    vert.pos.y -= display_pos.y;
+                }
+                ImGuiApp_SoftRaster_Triangle(&target, tex, &v[0], &v[1], &v[2], scale, clip_x0, clip_y0, clip_x1, clip_y1);
+            }
+        }
+    }
+}
+
+// Persistent pool of threads rasterizing bands of current job. Caller thread rasterizes bands too.
+struct ImGuiApp_SoftRasterWorkers
+{
+    std::mutex              Mutex;
+    std::condition_variable CondJob;                // Signaled when a job is posted, or on exit
+    std::condition_variable CondDone;               // Signaled when all bands of current job are done
+    std::thread             Threads[15];
+    int                     ThreadsCount = -1;      // -1 until started
+    bool                    Exit = false;
+
+    // Current job (BandsCount == 0 when idle)
+    const ImDrawData*       DrawData = NULL;
+    const ImGuiApp_SoftRasterTexture* FontTex = NULL;
+    ImTextureID             FontTexID = 0;
+    ImGuiApp_SoftRasterTarget Target;
+    int                     BandsCount = 0;
+    int                     BandsNext = 0;
+    int                     BandsPending = 0;
+
+    ~ImGuiApp_SoftRasterWorkers()
+    {
+        {
+            std::unique_lock<std::mutex> lock(Mutex);
+            Exit = true;
+        }
+        CondJob.notify_all();
+        for (int thread_n = 0; thread_n < ThreadsCount; thread_n++)
+            Threads[thread_n].join();
+    }
+};
+
+static ImGuiApp_SoftRasterWorkers GImGuiAppSoftRasterWorkers;
+
+// Rasterize remaining bands of current job. Called with lock held.
+static void ImGuiApp_SoftRaster_RunBands(ImGuiApp_SoftRasterWorkers* workers, std::unique_lock<std::mutex>& lock)
+{
+    while (workers->BandsNext < workers->BandsCount)
+    {
+        const int band_n = workers->BandsNext++;
+        const ImDrawData* draw_data = workers->DrawData;
+        const ImGuiApp_SoftRasterTexture* font_tex = workers->FontTex;
+        const ImTextureID font_tex_id = workers->FontTexID;
+        ImGuiApp_SoftRasterTarget target = workers->Target;
+        target.BandY0 = target.Height * band_n / workers->BandsCount;
+        target.BandY1 = target.Height * (band_n + 1) / workers->BandsCount;
+        lock.unlock();
+        ImGuiApp_SoftRaster_RenderBand(draw_data, font_tex, font_tex_id, target);
+        lock.lock();
+        if (--workers->BandsPending == 0)
+            workers->CondDone.notify_all();
+    }
+}
+
+static void ImGuiApp_SoftRaster_WorkerMain(ImGuiApp_SoftRasterWorkers* workers)
+{
+    std::unique_lock<std::mutex> lock(workers->Mutex);
+    while (true)
+    {
+        workers->CondJob.wait(lock, [workers]() { return workers->Exit || workers->BandsNext < workers->BandsCount; });
+        if (workers->Exit)
+            return;
+        ImGuiApp_SoftRaster_RunBands(workers, lock);
+    }
+}
+
+// Rasterize draw data into a w*h RGBA buffer, where (x,y) is the top-left corner of the buffer in framebuffer pixels.
+void ImGuiApp_SoftRasterDrawData(ImDrawData* draw_data, const ImVec4& clear_color, int x, int y, int w, int h, unsigned int* pixels)
+{
+    const ImU32 clear_col = ImGui::ColorConvertFloat4ToU32(clear_color);
+    for (int n = 0; n < w * h; n++)
+        pixels[n] = clear_col;
+    if (draw_data == NULL || !draw_data->Valid)
+        return;
+
+    ImGuiIO& io = ImGui::GetIO();
+    ImGuiApp_SoftRasterTexture font_tex;
+    unsigned char* font_pixels = NULL;
+    io.Fonts->GetTexDataAsRGBA32(&font_pixels, &font_tex.Width, &font_tex.Height);
+    font_tex.Pixels = (const ImU32*)font_pixels;
+
+    ImGuiApp_SoftRasterTarget target;
+    target.Pixels = pixels;
+    target.Width = w;
+    target.Height = h;
+    target.OriginX = x;
+    target.OriginY = y;
+
+    ImGuiApp_SoftRasterWorkers* workers = &GImGuiAppSoftRasterWorkers;
+    std::unique_lock<std::mutex> lock(workers->Mutex);
+    workers->CondDone.wait(lock, [workers]() { return workers->BandsCount == 0; }); // Another thread may be rasterizing
+    if (workers->ThreadsCount < 0)
+    {
+        workers->ThreadsCount = ImClamp((int)std::thread::hardware_concurrency() - 1, 0, IM_ARRAYSIZE(workers->Threads));
+        for (int thread_n = 0; thread_n < workers->ThreadsCount; thread_n++)
+            workers->Threads[thread_n] = std::thread(ImGuiApp_SoftRaster_WorkerMain, workers);
+    }
+
+    // Split rows in bands, at least 32 rows each
+    workers->DrawData = draw_data;
+    workers->FontTex = &font_tex;
+    workers->FontTexID = io.Fonts->TexID;
+    workers->Target = target;
+    workers->BandsCount = workers->BandsPending = ImClamp(h / 32, 1, workers->ThreadsCount + 1);
+    workers->BandsNext = 0;
+    if (workers->BandsCount > 1)
+        workers->CondJob.notify_all();
+    ImGuiApp_SoftRaster_RunBands(workers, lock);
+    workers->CondDone.wait(lock, [workers]() { return workers->BandsPending == 0; });
+    workers->DrawData = NULL;
+    workers->FontTex = NULL;
+    workers->BandsCount = workers->BandsNext = 0;
+    workers->CondDone.notify_all();
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiApp Implementation: NULL
 //-----------------------------------------------------------------------------
@@ -184,15 +585,23 @@ static bool ImGuiApp_ImplNull_NewFrame(ImGuiApp* app_opaque)
     return true;
 }
 
+// Draw data of last rendered frame is still valid when capturing (ImGuiTestEngine_PostSwap() is called after rendering)
 static bool ImGuiApp_ImplNull_CaptureFramebuffer(ImGuiApp* app, ImGuiViewport* viewport, int x, int y, int w, int h, unsigned int* pixels, void* user_data)
 {
-    IM_UNUSED(viewport);
-    IM_UNUSED(app);
     IM_UNUSED(user_data);
-    IM_UNUSED(x);
-    IM_UNUSED(y);
-    memset(pixels, 0, (size_t)(w * h) * sizeof(unsigned int));
-    return false;
+    if (!app->SoftRasterizer)
+    {
+        memset(pixels, 0, (size_t)(w * h) * sizeof(unsigned int));
+        return false;
+    }
+#ifdef IMGUI_HAS_VIEWPORT
+    ImDrawData* draw_data = (viewport != NULL) ? viewport->DrawData : ImGui::GetDrawData();
+#else
+    IM_UNUSED(viewport);
+    ImDrawData* draw_data = ImGui::GetDrawData();
+#endif
+    ImGuiApp_SoftRasterDrawData(draw_data, app->ClearColor, x, y, w, h, pixels);
+    return true;
 }
 
 static void ImGuiApp_ImplNull_RenderDrawData(ImDrawData* draw_data)
@@ -474,11 +883,19 @@ static bool ImGuiApp_ImplWin32DX11_CaptureFramebuffer(ImGuiApp* app_opaque, ImGu
     }
 
     // D3D11 does not provide means to capture a partial screenshot. We copy rect x,y,w,h on CPU side.
-    for (int index_y = y; index_y < y + h; ++index_y)
+    // Rows are contiguous when capturing full width of a tightly packed texture: copy them all at once.
+    if (x == 0 && (UINT)w == rtWidth && mapped.RowPitch == (UINT)w * 4)
     {
-        unsigned int* src = (unsigned int*)((unsigned char*)mapped.pData + index_y * mapped.RowPitch) + x;
-        unsigned int* dst = &pixels_rgba[(index_y - y) * w];
-        memcpy(dst, src, w * 4);
+        memcpy(pixels_rgba, (unsigned char*)mapped.pData + (size_t)y * mapped.RowPitch, (size_t)w * h * 4);
+    }
+    else
+    {
+        for (int index_y = y; index_y < y + h; ++index_y)
+        {
+            unsigned int* src = (unsigned int*)((unsigned char*)mapped.pData + index_y * mapped.RowPitch) + x;
+            unsigned int* dst = &pixels_rgba[(index_y - y) * w];
+            memcpy(dst, src, w * 4);
+        }
     }
 
     app->pd3dDeviceContext->Unmap(texture, 0);
@@ -1181,20 +1598,7 @@ static bool ImGuiApp_ImplGL_CaptureFramebuffer(ImGuiApp* app, ImGuiViewport* vie
     glReadPixels(x, y2, w, h, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
 
     // Flip vertically
-    size_t comp = 4;
-    size_t stride = (size_t)w * comp;
-    unsigned char* line_tmp = new unsigned char[stride];
-    unsigned char* line_a = (unsigned char*)pixels;
-    unsigned char* line_b = (unsigned char*)pixels + (stride * ((size_t)h - 1));
-    while (line_a < line_b)
-    {
-        memcpy(line_tmp, line_a, stride);
-        memcpy(line_a, line_b, stride);
-        memcpy(line_b, line_tmp, stride);
-        line_a += stride;
-        line_b -= stride;
-    }
-    delete[] line_tmp;
+    ImGuiApp_FlipPixelsVertically(pixels, w, h);
     return true;
 }
 #endif
@@ -28,6 +28,7 @@ struct ImGuiApp
     bool    Quit = false;                               // [In]  NewFrame()
     ImVec4  ClearColor = { 0.f, 0.f, 0.f, 1.f };        // [In]  Render()
     bool    MockViewports = false;                      // [In]  InitBackends()
+    bool    SoftRasterizer = false;                     // [In]  CaptureFramebuffer(): NULL implementation rasterizes draw data on CPU, otherwise captures fail
     float   DpiScale = 1.0f;                            // [Out] InitCreateWindow() / NewFrame()
     bool    Vsync = true;                               // [Out] Render()
 
@@ -44,6 +45,12 @@ struct ImGuiApp
 // Helper stub to store directly in ImGuiTestEngineIO::ScreenCaptureFunc when using test engine (prototype is same as ImGuiScreenCaptureFunc)
 bool ImGuiApp_ScreenCaptureFunc(ImGuiID viewport_id, int x, int y, int w, int h, unsigned int* pixels, void* user_data);
 
+// Helper to flip rows of a RGBA image in-place (e.g. after glReadPixels()), without allocating
+void ImGuiApp_FlipPixelsVertically(unsigned int* pixels, int w, int h);
+
+// Helper to rasterize draw data on CPU into a w*h RGBA image, where (x,y) is the top-left corner of the image in framebuffer pixels (used by NULL implementation to capture)
+void ImGuiApp_SoftRasterDrawData(ImDrawData* draw_data, const ImVec4& clear_color, int x, int y, int w, int h, unsigned int* pixels);
+
 //-----------------------------------------------------------------------------
 // Create function for each Backends
 // - In most case you can use the shortcut ImGuiApp_ImplCreate() which will be defined to the first available backend.